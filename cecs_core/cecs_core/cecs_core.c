@@ -1,3 +1,5 @@
+#include <string.h>
+
 #include "cecs_core.h"
 
 cecs_prefab_id cecs_world_set_prefab(cecs_world* w, cecs_entity_id prefab) {
@@ -29,6 +31,98 @@ cecs_entity_id cecs_world_add_entity_from_prefab(cecs_world* w, cecs_prefab_id p
         cecs_world_add_entity_copy(w, prefab)
     );
 }
+static cecs_entity_id_range cecs_world_add_entities_from_prefab_with(
+    cecs_world *w,
+    cecs_prefab_id prefab,
+    size_t count,
+    bool share_components
+) {
+    if (cecs_world_get_entity_flags(w, prefab).is_prefab != CECS_WORLD_HAS_TAG(cecs_is_prefab, w, prefab)) {
+        assert(false && "unreachable: entity flags mismatch is_prefab tag");
+        exit(EXIT_FAILURE);
+        return (cecs_entity_id_range){ 0 };
+    }
+    assert(
+        CECS_WORLD_HAS_TAG(cecs_is_prefab, w, prefab)
+        && "given entity is not a prefab"
+    );
+
+    const cecs_entity_id_range range = cecs_world_add_entity_range(w, count);
+    if (count == 0) {
+        return range;
+    }
+
+    for (
+        cecs_world_components_entity_iterator it = cecs_world_components_entity_iterator_create(&w->components, cecs_entity_id_index(prefab));
+        !cecs_world_components_entity_iterator_done(&it);
+        cecs_world_components_entity_iterator_next(&it)
+    ) {
+        cecs_associated_component_storage storage = cecs_world_components_entity_iterator_current(&it);
+        if (storage.component_id == CECS_TAG_ID(cecs_is_prefab) || storage.component_id == CECS_COMPONENT_ID(cecs_entity_flags)) {
+            continue;
+        }
+
+        if (share_components && CECS_UNION_IS(cecs_sparse_component_storage, cecs_component_storage_union, storage.storage->storage.storage)) {
+            cecs_world_components_set_component_copy_array(
+                &w->components,
+                (cecs_entity_id)range.start,
+                cecs_world_shared_component_id(storage.component_id),
+                &(cecs_entity_id){cecs_entity_id_index(prefab)},
+                count,
+                sizeof(cecs_entity_id),
+                (cecs_component_storage_descriptor) {
+                    .capacity = count,
+                    .indirect_component_id = CECS_OPTION_CREATE_SOME(cecs_indirect_component_id, storage.component_id),
+                    .is_size_known = true,
+                    .config = CECS_COMPONENT_CONFIG_DEFAULT
+                }
+            );
+            continue;
+        }
+
+        const size_t size = storage.storage->component_size;
+        void *prefab_component = NULL;
+        if (!cecs_component_storage_info(&storage.storage->storage).is_unit_type_storage) {
+            // NOTE: the storage may move its components while growing over the range, copy the prefab component out first
+            prefab_component = memcpy(
+                cecs_world_use_component_discard(w, size),
+                CECS_OPTION_GET(cecs_optional_component, cecs_component_storage_get(
+                    &storage.storage->storage,
+                    cecs_entity_id_index(prefab),
+                    size
+                )),
+                size
+            );
+        }
+        cecs_world_components_set_component_copy_array(
+            &w->components,
+            (cecs_entity_id)range.start,
+            storage.component_id,
+            prefab_component,
+            count,
+            size,
+            (cecs_component_storage_descriptor) {
+                .capacity = count,
+                .is_size_known = true,
+                .indirect_component_id = { 0 }
+            }
+        );
+    }
+    return range;
+}
+
+cecs_entity_id_range cecs_world_add_entities_from_prefab(cecs_world *w, cecs_prefab_id prefab, size_t count) {
+    return cecs_world_add_entities_from_prefab_with(w, prefab, count, false);
+}
+
+cecs_entity_id_range cecs_world_add_entities_from_prefab_shared(cecs_world *w, cecs_prefab_id prefab, size_t count) {
+    return cecs_world_add_entities_from_prefab_with(w, prefab, count, true);
+}
+
+cecs_entity_id cecs_world_add_entity_from_prefab_shared(cecs_world *w, cecs_prefab_id prefab) {
+    const cecs_entity_id_range range = cecs_world_add_entities_from_prefab_with(w, prefab, 1, true);
+    return cecs_world_entities_get_id(&w->entities, (cecs_entity_id)range.start);
+}
 cecs_entity_id cecs_world_set_components_from_prefab(cecs_world* w, cecs_entity_id destination, cecs_prefab_id prefab) {
     if (cecs_world_get_entity_flags(w, prefab).is_prefab != CECS_WORLD_HAS_TAG(cecs_is_prefab, w, prefab)) {
         assert(false && "unreachable: entity flags mismatch is_prefab tag");
@@ -70,10 +164,11 @@ double cecs_game_time_update_time_since_start(cecs_game_time* t) {
 }
 
 CECS_COMPONENT_DEFINE(cecs_is_child_of);
+CECS_COMPONENT_DEFINE(cecs_hierarchy_node);
 CECS_TAG_DEFINE(cecs_is_scene_member_of);
 
 cecs_scene_id cecs_world_add_entity_to_scene(cecs_world* w, cecs_entity_id id, cecs_scene_id scene) {
-    return CECS_WORLD_ADD_TAG_RELATION(
+    return CECS_WORLD_ADD_TAG_RELATION_TO_TAG(
         cecs_is_scene_member_of,
         w,
         id,
@@ -127,4 +222,277 @@ cecs_scene_world_system* cecs_scene_world_system_set_active_scene(cecs_scene_wor
     assert(scene_group->component_count == 1 && "fatal error: scene group must have exactly one component");
     scene_group->components[0] = CECS_RELATION_ID(cecs_is_scene_member_of, scene);
     return s;
-}
\ No newline at end of file
+}
+
+cecs_scene_world_system *cecs_scene_world_system_add_resources(
+    cecs_scene_world_system *s,
+    cecs_arena *a,
+    const cecs_resource_access_group groups[const],
+    const size_t group_count
+) {
+    cecs_dynamic_world_system_add_resources(&s->world_system, a, groups, group_count);
+    return s;
+}
+
+static cecs_hierarchy_node *cecs_world_get_hierarchy_node(cecs_world *w, cecs_entity_id id) {
+    return CECS_WORLD_GET_COMPONENT(cecs_hierarchy_node, w, id);
+}
+
+static const cecs_hierarchy_node *cecs_world_read_hierarchy_node(cecs_world *w, cecs_entity_id id) {
+    return CECS_WORLD_READ_COMPONENT(cecs_hierarchy_node, w, id);
+}
+
+static cecs_hierarchy_node *cecs_world_get_or_add_hierarchy_node(cecs_world *w, cecs_entity_id id) {
+    cecs_hierarchy_node *node;
+    if (!CECS_WORLD_TRY_GET_COMPONENT(cecs_hierarchy_node, w, id, &node)) {
+        CECS_WORLD_SET_REMOVE_HOOK(cecs_hierarchy_node, w, cecs_world_detach_from_hierarchy);
+        cecs_world_add_tag(w, id, cecs_hierarchy_depth_id(0));
+        node = CECS_WORLD_SET_COMPONENT(cecs_hierarchy_node, w, id, (&(cecs_hierarchy_node){
+            .first_child = CECS_HIERARCHY_NODE_NONE,
+            .next_sibling = CECS_HIERARCHY_NODE_NONE,
+            .previous_sibling = CECS_HIERARCHY_NODE_NONE,
+            .depth = 0
+        }));
+    }
+    return node;
+}
+
+static bool cecs_world_try_get_parent(cecs_world *w, cecs_entity_id id, cecs_entity_id *out_parent) {
+    const cecs_is_child_of *child_of;
+    if (CECS_WORLD_TRY_READ_COMPONENT(cecs_is_child_of, w, id, &child_of)) {
+        *out_parent = child_of->parent;
+        return true;
+    } else {
+        *out_parent = CECS_HIERARCHY_NODE_NONE;
+        return false;
+    }
+}
+
+[[maybe_unused]] static bool cecs_world_is_hierarchy_ancestor(cecs_world *w, cecs_entity_id ancestor, cecs_entity_id id) {
+    cecs_entity_id parent;
+    while (cecs_world_try_get_parent(w, id, &parent)) {
+        if (parent == ancestor) {
+            return true;
+        }
+        id = parent;
+    }
+    return false;
+}
+
+static void cecs_world_link_hierarchy_child(cecs_world *w, cecs_entity_id child, cecs_entity_id parent) {
+    cecs_hierarchy_node *parent_node = cecs_world_get_hierarchy_node(w, parent);
+    const cecs_entity_id next = parent_node->first_child;
+    parent_node->first_child = child;
+
+    cecs_hierarchy_node *child_node = cecs_world_get_hierarchy_node(w, child);
+    child_node->previous_sibling = CECS_HIERARCHY_NODE_NONE;
+    child_node->next_sibling = next;
+    if (next != CECS_HIERARCHY_NODE_NONE) {
+        cecs_world_get_hierarchy_node(w, next)->previous_sibling = child;
+    }
+}
+
+static void cecs_world_unlink_hierarchy_child(cecs_world *w, cecs_entity_id child, cecs_entity_id parent) {
+    cecs_hierarchy_node *child_node = cecs_world_get_hierarchy_node(w, child);
+    const cecs_entity_id previous = child_node->previous_sibling;
+    const cecs_entity_id next = child_node->next_sibling;
+    child_node->previous_sibling = CECS_HIERARCHY_NODE_NONE;
+    child_node->next_sibling = CECS_HIERARCHY_NODE_NONE;
+
+    if (previous == CECS_HIERARCHY_NODE_NONE) {
+        cecs_world_get_hierarchy_node(w, parent)->first_child = next;
+    } else {
+        cecs_world_get_hierarchy_node(w, previous)->next_sibling = next;
+    }
+    if (next != CECS_HIERARCHY_NODE_NONE) {
+        cecs_world_get_hierarchy_node(w, next)->previous_sibling = previous;
+    }
+}
+
+// NOTE: roots without children leave the hierarchy
+static void cecs_world_prune_hierarchy_node(cecs_world *w, cecs_entity_id id) {
+    const cecs_hierarchy_node *node;
+    cecs_entity_id parent;
+    if (
+        CECS_WORLD_TRY_READ_COMPONENT(cecs_hierarchy_node, w, id, &node)
+        && node->first_child == CECS_HIERARCHY_NODE_NONE
+        && !cecs_world_try_get_parent(w, id, &parent)
+    ) {
+        cecs_world_remove_tag(w, id, cecs_hierarchy_depth_id(node->depth));
+        CECS_WORLD_REMOVE_COMPONENT(cecs_hierarchy_node, w, id, &(cecs_hierarchy_node){0});
+    }
+}
+
+static void cecs_world_set_hierarchy_subtree_depth(cecs_world *w, const cecs_entity_id root, const size_t root_depth) {
+    // NOTE: moving a subtree shifts every depth in it equally, an unchanged root means an unchanged subtree
+    if (cecs_world_read_hierarchy_node(w, root)->depth == root_depth) {
+        return;
+    }
+
+    cecs_entity_id current = root;
+    size_t depth = root_depth;
+    while (true) {
+        cecs_world_remove_tag(w, current, cecs_hierarchy_depth_id(cecs_world_read_hierarchy_node(w, current)->depth));
+        cecs_world_add_tag(w, current, cecs_hierarchy_depth_id(depth));
+        cecs_hierarchy_node *node = cecs_world_get_hierarchy_node(w, current);
+        node->depth = depth;
+
+        if (node->first_child != CECS_HIERARCHY_NODE_NONE) {
+            current = node->first_child;
+            ++depth;
+            continue;
+        }
+
+        while (current != root && cecs_world_read_hierarchy_node(w, current)->next_sibling == CECS_HIERARCHY_NODE_NONE) {
+            cecs_world_try_get_parent(w, current, &current);
+            --depth;
+        }
+        if (current == root) {
+            return;
+        }
+        current = cecs_world_read_hierarchy_node(w, current)->next_sibling;
+    }
+}
+
+cecs_entity_id cecs_world_set_parent(cecs_world *w, cecs_entity_id child, cecs_entity_id parent) {
+    assert(child != parent && "error: entity may not be its own parent");
+    assert(
+        !cecs_world_is_hierarchy_ancestor(w, child, parent)
+        && "error: parent is a descendant of the child, hierarchies may not have cycles"
+    );
+
+    cecs_entity_id previous_parent;
+    const bool had_parent = cecs_world_try_get_parent(w, child, &previous_parent);
+    if (had_parent && previous_parent == parent) {
+        return parent;
+    }
+
+    const size_t parent_depth = cecs_world_get_or_add_hierarchy_node(w, parent)->depth;
+    cecs_world_get_or_add_hierarchy_node(w, child);
+    if (had_parent) {
+        cecs_world_unlink_hierarchy_child(w, child, previous_parent);
+    }
+    CECS_WORLD_SET_COMPONENT(cecs_is_child_of, w, child, (&(cecs_is_child_of){ .parent = parent }));
+    cecs_world_link_hierarchy_child(w, child, parent);
+    cecs_world_set_hierarchy_subtree_depth(w, child, parent_depth + 1);
+
+    if (had_parent) {
+        cecs_world_prune_hierarchy_node(w, previous_parent);
+    }
+    return parent;
+}
+
+cecs_entity_id cecs_world_remove_parent(cecs_world *w, cecs_entity_id child) {
+    cecs_entity_id parent;
+    if (!cecs_world_try_get_parent(w, child, &parent)) {
+        return child;
+    }
+
+    cecs_world_unlink_hierarchy_child(w, child, parent);
+    CECS_WORLD_REMOVE_COMPONENT(cecs_is_child_of, w, child, &(cecs_is_child_of){0});
+    cecs_world_set_hierarchy_subtree_depth(w, child, 0);
+
+    cecs_world_prune_hierarchy_node(w, child);
+    cecs_world_prune_hierarchy_node(w, parent);
+    return child;
+}
+
+void cecs_world_detach_from_hierarchy(cecs_world *w, cecs_entity_id id) {
+    const cecs_hierarchy_node *node;
+    if (!CECS_WORLD_TRY_READ_COMPONENT(cecs_hierarchy_node, w, id, &node)) {
+        return;
+    }
+
+    // NOTE: children become roots of their own subtrees, a root loses its node together with its last child
+    while (CECS_WORLD_TRY_READ_COMPONENT(cecs_hierarchy_node, w, id, &node) && node->first_child != CECS_HIERARCHY_NODE_NONE) {
+        cecs_world_remove_parent(w, node->first_child);
+    }
+    cecs_world_remove_parent(w, id);
+    cecs_world_prune_hierarchy_node(w, id);
+}
+
+size_t cecs_world_hierarchy_depth_count(cecs_world *w) {
+    // NOTE: every node below the roots has its parent one depth above, so depths are contiguous
+    size_t depth = 0;
+    while (cecs_world_components_has_storage(&w->components, cecs_hierarchy_depth_id(depth))) {
+        cecs_hibitset_iterator it = cecs_hibitset_iterator_create_borrowed_at_first(
+            &cecs_world_components_get_component_storage_expect(&w->components, cecs_hierarchy_depth_id(depth))->storage.entity_bitset
+        );
+        if (!cecs_hibitset_iterator_current_is_set(&it)) {
+            cecs_hibitset_iterator_next_set(&it);
+        }
+        if (cecs_hibitset_iterator_done(&it)) {
+            break;
+        }
+        ++depth;
+    }
+    return depth;
+}
+
+cecs_hierarchy_world_system cecs_hierarchy_world_system_create(cecs_arena *a) {
+    return (cecs_hierarchy_world_system) {
+        .world_system = cecs_dynamic_world_system_create_from(
+            a,
+            (cecs_component_iteration_group[]){
+                CECS_COMPONENT_GROUP_DEFAULT_EXCLUDED,
+                CECS_COMPONENT_GROUP_FROM_IDS(
+                    cecs_component_access_ignore, cecs_component_group_search_all, cecs_hierarchy_depth_id(0)
+                )
+            },
+            2
+        ),
+        .depth = 0,
+        .depth_group_index = 1
+    };
+}
+
+cecs_hierarchy_world_system cecs_hierarchy_world_system_create_from(
+    cecs_arena *a,
+    const cecs_component_iteration_group groups[const],
+    const size_t group_count
+) {
+    cecs_hierarchy_world_system s = cecs_hierarchy_world_system_create(a);
+    cecs_dynamic_world_system_add_range(&s.world_system, a, groups, group_count);
+    return s;
+}
+
+cecs_hierarchy_world_system *cecs_hierarchy_world_system_set_depth(cecs_hierarchy_world_system *s, const size_t depth) {
+    s->depth = depth;
+    cecs_component_iteration_group *depth_group = cecs_dynamic_array_get_mut(
+        &s->world_system.component_groups,
+        s->depth_group_index,
+        sizeof(cecs_component_iteration_group)
+    );
+    assert(depth_group->component_count == 1 && "fatal error: depth group must have exactly one component");
+    depth_group->components[0] = cecs_hierarchy_depth_id(depth);
+    return s;
+}
+
+cecs_hierarchy_world_system *cecs_hierarchy_world_system_add_resources(
+    cecs_hierarchy_world_system *s,
+    cecs_arena *a,
+    const cecs_resource_access_group groups[const],
+    const size_t group_count
+) {
+    cecs_dynamic_world_system_add_resources(&s->world_system, a, groups, group_count);
+    return s;
+}
+
+cecs_entity_count cecs_hierarchy_world_system_iter(
+    cecs_hierarchy_world_system *s,
+    cecs_world *w,
+    cecs_arena *iteration_arena,
+    cecs_component_handles handles,
+    cecs_system_predicate_data data,
+    cecs_system_predicate *const predicate
+) {
+    cecs_entity_count count = 0;
+    const size_t depth_count = cecs_world_hierarchy_depth_count(w);
+    for (size_t depth = 0; depth < depth_count; ++depth) {
+        cecs_hierarchy_world_system_set_depth(s, depth);
+        count += cecs_world_system_iter(
+            cecs_world_system_from_dynamic(&s->world_system), w, iteration_arena, handles, data, predicate
+        );
+    }
+    return count;
+}
@@ -6,6 +6,8 @@
 #include "core/component/entity/cecs_entity.h"
 #include "core/cecs_system.h"
 #include "core/cecs_world.h"
+#include "core/cecs_snapshot.h"
+#include "core/cecs_snapshot_delta.h"
 #include "containers/cecs_arena.h"
 
 typedef cecs_entity_id cecs_prefab_id;
@@ -13,6 +15,10 @@ cecs_prefab_id cecs_world_set_prefab(cecs_world *w, cecs_entity_id prefab);
 cecs_entity_id cecs_world_unset_prefab(cecs_world *w, cecs_prefab_id prefab);
 
 cecs_entity_id cecs_world_add_entity_from_prefab(cecs_world *w, cecs_prefab_id prefab);
+cecs_entity_id_range cecs_world_add_entities_from_prefab(cecs_world *w, cecs_prefab_id prefab, size_t count);
+// NOTE: shared instances reference the prefab's sparse-stored components instead of copying them, see cecs_world_shared_component_id
+cecs_entity_id cecs_world_add_entity_from_prefab_shared(cecs_world *w, cecs_prefab_id prefab);
+cecs_entity_id_range cecs_world_add_entities_from_prefab_shared(cecs_world *w, cecs_prefab_id prefab, size_t count);
 cecs_entity_id cecs_world_set_components_from_prefab(cecs_world *w, cecs_entity_id destination, cecs_prefab_id prefab);
 
 void *cecs_world_set_components_from_prefab_and_grab(cecs_world *w, cecs_entity_id destination, cecs_prefab_id prefab, cecs_component_id grab_component_id);
@@ -38,8 +44,37 @@ typedef struct cecs_is_child_of {
 } cecs_is_child_of;
 CECS_COMPONENT_DECLARE(cecs_is_child_of);
 
+#define CECS_HIERARCHY_NODE_NONE CECS_ENTITY_ID_MAX
+
+// NOTE: every entity in a hierarchy, roots included, links its children through their sibling ids
+typedef struct cecs_hierarchy_node {
+    cecs_entity_id first_child;
+    cecs_entity_id next_sibling;
+    cecs_entity_id previous_sibling;
+    size_t depth;
+} cecs_hierarchy_node;
+CECS_COMPONENT_DECLARE(cecs_hierarchy_node);
+
+// NOTE: depth tags count down from the top of the plain id space, clear of type ids and never shaped like relation ids
+#define CECS_HIERARCHY_DEPTH_ID_FIRST ((cecs_tag_id)(CECS_RELATION_ID_TARGET_MASK - 1))
+#define CECS_HIERARCHY_DEPTH_MAX ((size_t)(CECS_HIERARCHY_DEPTH_ID_FIRST >> 1))
+static inline cecs_tag_id cecs_hierarchy_depth_id(const size_t depth) {
+    assert(depth < CECS_HIERARCHY_DEPTH_MAX && "error: hierarchy depth is too large");
+    return CECS_HIERARCHY_DEPTH_ID_FIRST - (cecs_tag_id)depth;
+}
+
+// NOTE: keeps cecs_is_child_of and the depth index of the whole moved subtree in sync, removed entities are detached by the world
+cecs_entity_id cecs_world_set_parent(cecs_world *w, cecs_entity_id child, cecs_entity_id parent);
+cecs_entity_id cecs_world_remove_parent(cecs_world *w, cecs_entity_id child);
+// NOTE: also the hierarchy node remove hook, so it matches cecs_remove_hook
+void cecs_world_detach_from_hierarchy(cecs_world *w, cecs_entity_id id);
+
+size_t cecs_world_hierarchy_depth_count(cecs_world *w);
+
 
 typedef cecs_tag_id cecs_scene_id;
+// NOTE: matches entities that are members of any scene
+#define CECS_SCENE_ID_ANY ((cecs_scene_id)CECS_RELATION_TARGET_WILDCARD)
 typedef bool cecs_is_scene_member_of;
 CECS_TAG_DECLARE(cecs_is_scene_member_of);
 
@@ -62,4 +97,60 @@ cecs_scene_world_system cecs_scene_world_system_create_from(
 
 cecs_scene_world_system* cecs_scene_world_system_set_active_scene(cecs_scene_world_system* s, const cecs_scene_id scene);
 
+cecs_scene_world_system *cecs_scene_world_system_add_resources(
+    cecs_scene_world_system *s,
+    cecs_arena *a,
+    const cecs_resource_access_group groups[const],
+    const size_t group_count
+);
+#define CECS_SCENE_WORLD_SYSTEM_ADD_RESOURCES(scene_world_system_ref, arena_ref, ...) \
+    cecs_scene_world_system_add_resources( \
+        scene_world_system_ref, \
+        arena_ref, \
+        (cecs_resource_access_group[]){ __VA_ARGS__ }, \
+        (sizeof((cecs_resource_access_group[]){ __VA_ARGS__ }) / sizeof(cecs_resource_access_group)) \
+    )
+
+typedef struct cecs_hierarchy_world_system {
+    cecs_dynamic_world_system world_system;
+    size_t depth;
+    size_t depth_group_index;
+} cecs_hierarchy_world_system;
+
+cecs_hierarchy_world_system cecs_hierarchy_world_system_create(cecs_arena *a);
+cecs_hierarchy_world_system cecs_hierarchy_world_system_create_from(
+    cecs_arena *a,
+    const cecs_component_iteration_group groups[const],
+    const size_t group_count
+);
+
+cecs_hierarchy_world_system *cecs_hierarchy_world_system_set_depth(cecs_hierarchy_world_system *s, const size_t depth);
+
+cecs_hierarchy_world_system *cecs_hierarchy_world_system_add_resources(
+    cecs_hierarchy_world_system *s,
+    cecs_arena *a,
+    const cecs_resource_access_group groups[const],
+    const size_t group_count
+);
+#define CECS_HIERARCHY_WORLD_SYSTEM_ADD_RESOURCES(hierarchy_world_system_ref, arena_ref, ...) \
+    cecs_hierarchy_world_system_add_resources( \
+        hierarchy_world_system_ref, \
+        arena_ref, \
+        (cecs_resource_access_group[]){ __VA_ARGS__ }, \
+        (sizeof((cecs_resource_access_group[]){ __VA_ARGS__ }) / sizeof(cecs_resource_access_group)) \
+    )
+
+// NOTE: iterates one depth at a time from the roots, parents are always processed before their children;
+// declared resources are borrowed for each depth
+cecs_entity_count cecs_hierarchy_world_system_iter(
+    cecs_hierarchy_world_system *s,
+    cecs_world *w,
+    cecs_arena *iteration_arena,
+    cecs_component_handles handles,
+    cecs_system_predicate_data data,
+    cecs_system_predicate *const predicate
+);
+#define CECS_HIERARCHY_WORLD_SYSTEM_ITER(hierarchy_world_system_ref, world_ref, iteration_arena_ref, handles, predicate_data, predicate) \
+    cecs_hierarchy_world_system_iter(hierarchy_world_system_ref, world_ref, iteration_arena_ref, handles, predicate_data, ((cecs_system_predicate *)predicate))
+
 #endif
\ No newline at end of file
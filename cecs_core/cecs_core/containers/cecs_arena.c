@@ -166,8 +166,11 @@ static cecs_arena_reallocation_strategy cecs_arena_realloc_find_fit(
             old_data_block = current;
 
             bool data_is_last_in_block = (uint8_t*)data_block + current_size == current->b.data + current->b.size;
+            // NOTE: small reallocations may have placed the data with a weaker alignment than the new size needs
+            bool data_is_aligned = cecs_block_alignment_padding_from_size((uint8_t*)data_block, new_size) == 0;
             if (
                 data_is_last_in_block
+                && data_is_aligned
                 && (new_size <= current_size || cecs_block_can_alloc(&current->b, new_size - current_size))
             ) {
                 strategy = cecs_arena_reallocate_in_place;
@@ -281,7 +284,7 @@ void* cecs_arena_realloc(cecs_arena* a, void* data_block, size_t current_size, s
         }
 
         if (new_data_block != data_block)
-            memcpy(new_data_block, data_block, transfer_size);
+            memmove(new_data_block, data_block, transfer_size);
         return new_data_block;
     }
     case cecs_arena_reallocate_fit: {
@@ -404,6 +407,14 @@ cecs_arena_dbg_info cecs_arena_get_dbg_info_pick_smallest(const cecs_arena* a) {
     return info;
 }
 
+void cecs_arena_reset(cecs_arena* a) {
+    cecs_linked_block* current = a->first_block;
+    while (current != NULL) {
+        current->b.size = 0;
+        current = current->next;
+    }
+}
+
 void cecs_arena_free(cecs_arena* a) {
     cecs_linked_block* current = a->first_block;
     while (current != NULL) {
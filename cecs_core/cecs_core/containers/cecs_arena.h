@@ -57,6 +57,8 @@ typedef enum cecs_arena_reallocation_strategy {
 
 void *cecs_arena_realloc(cecs_arena *a, void *data_block, size_t current_size, size_t new_size);
 
+void cecs_arena_reset(cecs_arena *a);
+
 void cecs_arena_free(cecs_arena *a);
 
 // TODO: pool allocator
@@ -83,4 +85,22 @@ cecs_arena_dbg_info cecs_arena_get_dbg_info_compare_size(const cecs_arena *a);
 
 cecs_arena_dbg_info cecs_arena_get_dbg_info_pick_smallest(const cecs_arena *a);
 
+typedef struct cecs_memory_usage {
+    size_t used;
+    size_t reserved;
+    size_t sentinel_padding;
+} cecs_memory_usage;
+
+static inline cecs_memory_usage cecs_memory_usage_add(const cecs_memory_usage lhs, const cecs_memory_usage rhs) {
+    return (cecs_memory_usage){
+        .used = lhs.used + rhs.used,
+        .reserved = lhs.reserved + rhs.reserved,
+        .sentinel_padding = lhs.sentinel_padding + rhs.sentinel_padding
+    };
+}
+
+static inline size_t cecs_memory_usage_fragmentation(const cecs_memory_usage usage) {
+    return usage.reserved - usage.used;
+}
+
 #endif
\ No newline at end of file
@@ -143,7 +143,7 @@ size_t cecs_bitset_set_range(
             &b->bit_words,
             displaced_first_word_index + 1,
             &((cecs_bit_word) { CECS_BIT_WORD_MAX }),
-            set_word_count - 1
+            set_word_count - 2
         );
         *last_word |= last_mask;
         break;
@@ -245,7 +245,7 @@ size_t cecs_bitset_unset_range(
             &b->bit_words,
             displaced_first_word_index + 1,
             &((cecs_bit_word) { 0 }),
-            unset_word_count - 1
+            unset_word_count - 2
         );
         *last_word &= ~last_mask;
         break;
@@ -274,6 +274,28 @@ bool cecs_bitset_bit_in_range(const cecs_bitset* b, size_t bit_index) {
     return cecs_exclusive_range_contains(b->word_range, cecs_layer_word_index(bit_index, 0));
 }
 
+static inline size_t cecs_bit_word_count_set(cecs_bit_word word) {
+    size_t count = 0;
+    while (word != 0) {
+        word &= word - 1;
+        ++count;
+    }
+    return count;
+}
+
+size_t cecs_bitset_count_set(const cecs_bitset* b) {
+    size_t count = 0;
+    const size_t word_count = CECS_DYNAMIC_ARRAY_COUNT(cecs_bit_word, &b->bit_words);
+    for (size_t i = 0; i < word_count; i++) {
+        count += cecs_bit_word_count_set(*CECS_DYNAMIC_ARRAY_GET(cecs_bit_word, &b->bit_words, i));
+    }
+    return count;
+}
+
+cecs_memory_usage cecs_bitset_memory_usage(const cecs_bitset* b) {
+    return cecs_dynamic_array_memory_usage(&b->bit_words);
+}
+
 cecs_bitset_iterator cecs_bitset_iterator_create(const cecs_bitset* b) {
     return (cecs_bitset_iterator) {
         .bitset = b,
@@ -346,54 +368,10 @@ void cecs_hibitset_unset(cecs_hibitset* b, cecs_arena* a, size_t bit_index) {
     }
 }
 
-#define CECS_UNSET_BIT_RANGE_STRUCT \
-    struct unset_bits_range { \
-        size_t layer; \
-        size_t bit_index; \
-        size_t count; \
-    }
-
-static size_t cecs_hibitset_unset_range_push_layer(
-    cecs_dynamic_array *unset_ranges,
-    const cecs_bit_word *unset_words,
-    size_t unset_word_count,
-    cecs_arena *range_arena,
-    size_t layer,
-    size_t bit_index,
-    size_t bit_count
-) {
-    typedef CECS_UNSET_BIT_RANGE_STRUCT unset_bits_range;
-    assert(
-        unset_ranges->count % sizeof(unset_bits_range) == 0
-        && "fatal error: unset_ranges is not a dynamic array of unset_bits_range"
-    );
-
-    for (size_t i = 0; i < unset_word_count; ++i) {
-        cecs_bit_word unset_word = unset_words[i];
-        size_t layer_word_bit_page =
-            cecs_layer_word_bit_index(bit_index + (bit_count * i / unset_word_count), layer)
-            >> CECS_BIT_PAGE_SIZE_LOG2;
-        cecs_bit_word unset_word_page = unset_word & cecs_page_mask(layer_word_bit_page);
-
-        size_t next_layer = layer + 1;
-        size_t next_bit_count = bit_count >> CECS_BIT_PAGE_SIZE_LOG2;
-        if (unset_word_page == 0
-            && next_layer < CECS_BIT_LAYER_COUNT
-            && next_bit_count > 0) {
-            CECS_DYNAMIC_ARRAY_ADD(
-                unset_bits_range,
-                unset_ranges,
-                range_arena,
-                &((unset_bits_range){
-                    .layer = next_layer,
-                    .bit_index = layer_word_bit_page,
-                    .count = next_bit_count,
-                })
-            );
-        }
-    }
-
-    return CECS_DYNAMIC_ARRAY_COUNT(unset_bits_range, unset_ranges);
+static bool cecs_hibitset_layer_page_is_unset(const cecs_hibitset *b, size_t layer, size_t page_index) {
+    const size_t first_page_bit = page_index << CECS_BIT_PAGE_SIZE_LOG2;
+    const size_t word_page = (first_page_bit & (CECS_BIT_WORD_BIT_COUNT - 1)) >> CECS_BIT_PAGE_SIZE_LOG2;
+    return (cecs_bitset_get_word(&b->bitsets[layer], first_page_bit) & cecs_page_mask(word_page)) == 0;
 }
 
 void cecs_hibitset_unset_range(cecs_hibitset *b, cecs_arena *a, size_t bit_index, size_t count) {
@@ -401,44 +379,33 @@ void cecs_hibitset_unset_range(cecs_hibitset *b, cecs_arena *a, size_t bit_index
         return;
     }
 
-    typedef CECS_UNSET_BIT_RANGE_STRUCT unset_bits_range;
-    cecs_arena range_arena = cecs_arena_create_with_capacity(
-        count * sizeof(unset_bits_range) / 2
-    );
-
-    cecs_dynamic_array unset_ranges = cecs_dynamic_array_create();
-    CECS_DYNAMIC_ARRAY_ADD(
-        unset_bits_range,
-        &unset_ranges,
-        &range_arena,
-        &((unset_bits_range){ 0, bit_index, count })
-    );
-
-    size_t unset_ranges_count = 1;
-    while (unset_ranges_count > 0) {
-        unset_bits_range current_range = *(unset_bits_range *)cecs_dynamic_array_last(&unset_ranges, sizeof(unset_bits_range));
-        CECS_DYNAMIC_ARRAY_REMOVE(unset_bits_range, &unset_ranges, &range_arena, --unset_ranges_count);
-
-        size_t first_layer_bit = cecs_layer_bit_index(current_range.bit_index, current_range.layer);
-        size_t last_layer_bit = cecs_layer_bit_index(current_range.bit_index + current_range.count - 1, current_range.layer);
-        size_t bit_count = (1 + last_layer_bit) - first_layer_bit;
+    size_t first_layer_bit = bit_index;
+    size_t last_layer_bit = bit_index + count - 1;
+    const cecs_bit_word *unset_words;
+    cecs_bitset_unset_range(&b->bitsets[0], a, first_layer_bit, (1 + last_layer_bit) - first_layer_bit, &unset_words);
+    for (size_t layer = 1; layer < CECS_BIT_LAYER_COUNT; layer++) {
+        // NOTE: pages inside the unset range are now empty, only the pages at its edges may still hold bits
+        size_t first_page = first_layer_bit >> CECS_BIT_PAGE_SIZE_LOG2;
+        size_t last_page = last_layer_bit >> CECS_BIT_PAGE_SIZE_LOG2;
+        if (!cecs_hibitset_layer_page_is_unset(b, layer - 1, first_page)) {
+            ++first_page;
+        }
+        if (last_page >= first_page && !cecs_hibitset_layer_page_is_unset(b, layer - 1, last_page)) {
+            if (last_page == 0) {
+                return;
+            }
+            --last_page;
+        }
+        if (first_page > last_page) {
+            return;
+        }
 
-        const cecs_bit_word *unset_words;
-        size_t unset_word_count
-            = cecs_bitset_unset_range(&b->bitsets[current_range.layer], a, first_layer_bit, bit_count, &unset_words);
-        unset_ranges_count = cecs_hibitset_unset_range_push_layer(
-            &unset_ranges,
-            unset_words,
-            unset_word_count,
-            &range_arena,
-            current_range.layer,
-            first_layer_bit,
-            bit_count
-        );
+        first_layer_bit = first_page;
+        last_layer_bit = last_page;
+        cecs_bitset_unset_range(&b->bitsets[layer], a, first_layer_bit, (1 + last_layer_bit) - first_layer_bit, &unset_words);
     }
-    cecs_arena_free(&range_arena);
+    (void)unset_words;
 }
-#undef CECS_UNSET_BIT_RANGE_STRUCT
 
 bool cecs_hibitset_is_set(const cecs_hibitset* b, size_t bit_index) {
     return cecs_bitset_is_set(&b->bitsets[0], bit_index);
@@ -485,28 +452,33 @@ bool cecs_hibitset_is_set_skip_unset_reverse(const cecs_hibitset* b, size_t bit_
         size_t layer_bit = cecs_layer_bit_index(bit_index, layer);
         cecs_bit_word word = cecs_bitset_get_word(&b->bitsets[layer], layer_bit);
         size_t layer_word_bit_shift = layer_bit & (CECS_BIT_WORD_BIT_COUNT - 1);
-        cecs_bit_word word_shifted_to_bit = word >> layer_word_bit_shift;
+        // NOTE: walking backwards only the bits below the current one matter, shift them up so the current bit is the highest
+        cecs_bit_word word_shifted_to_bit = word << ((CECS_BIT_WORD_BIT_COUNT - 1) - layer_word_bit_shift);
 
-        if ((word_shifted_to_bit & (cecs_bit_word)1) == (cecs_bit_word)0) {
-            unsigned long unset_low = 1;
-            unsigned long unset_high = 0;
-            unsigned long word_low = (unsigned long)word_shifted_to_bit;
+        if ((word_shifted_to_bit >> (CECS_BIT_WORD_BIT_COUNT - 1)) == (cecs_bit_word)0) {
+            unsigned long set_low = 0;
+            unsigned long set_high = 0;
+            unsigned long word_low = (unsigned long)(word_shifted_to_bit & ((((cecs_bit_word)1) << (CECS_BIT_WORD_BIT_COUNT >> 1)) - 1));
             unsigned long word_high = (unsigned long)(word_shifted_to_bit >> (CECS_BIT_WORD_BIT_COUNT >> 1));
 
             size_t unset_continuous_count = 0;
-            if (!_BitScanReverse(&unset_low, word_low)) {
-                if (!_BitScanReverse(&unset_high, word_high)) {
-                    unset_continuous_count = CECS_BIT_WORD_BIT_COUNT - layer_word_bit_shift;
-                }
-                else {
-                    unset_continuous_count = unset_high + (CECS_BIT_WORD_BIT_COUNT >> 1);
-                }
+            if (_BitScanReverse(&set_high, word_high)) {
+                unset_continuous_count = (CECS_BIT_WORD_BIT_COUNT >> 1) - 1 - set_high;
+            }
+            else if (_BitScanReverse(&set_low, word_low)) {
+                unset_continuous_count = CECS_BIT_WORD_BIT_COUNT - 1 - set_low;
             }
             else {
-                unset_continuous_count = unset_low;
+                unset_continuous_count = layer_word_bit_shift + 1;
+            }
+
+            if (unset_continuous_count > layer_bit) {
+                *out_unset_bit_skip_count = (cecs_ssize_t)bit_index + 1;
+            }
+            else {
+                *out_unset_bit_skip_count =
+                    bit_index - (cecs_bit0_from_layer_bit_index(layer_bit - unset_continuous_count + 1, layer) - 1);
             }
-            *out_unset_bit_skip_count =
-                bit_index - cecs_bit0_from_layer_bit_index(layer_bit - unset_continuous_count, layer);
             assert(*out_unset_bit_skip_count > 0);
             return false;
         }
@@ -529,6 +501,18 @@ bool cecs_hibitset_bit_in_range(const cecs_hibitset* b, size_t bit_index) {
     return cecs_bitset_bit_in_range(&b->bitsets[0], bit_index);
 }
 
+size_t cecs_hibitset_count_set(const cecs_hibitset* b) {
+    return cecs_bitset_count_set(&b->bitsets[0]);
+}
+
+cecs_memory_usage cecs_hibitset_memory_usage(const cecs_hibitset* b) {
+    cecs_memory_usage usage = { 0 };
+    for (size_t layer = 0; layer < CECS_BIT_LAYER_COUNT; layer++) {
+        usage = cecs_memory_usage_add(usage, cecs_bitset_memory_usage(&b->bitsets[layer]));
+    }
+    return usage;
+}
+
 cecs_hibitset_iterator cecs_hibitset_iterator_create_borrowed_at(const cecs_hibitset* b, size_t bit_index) {
     return (cecs_hibitset_iterator) {
         .hibitset = CECS_COW_CREATE_BORROWED(cecs_hibitset, b),
@@ -585,8 +569,7 @@ size_t cecs_hibitset_iterator_previous_set(cecs_hibitset_iterator* it) {
     do {
         it->current_bit_index -= unset_bit_skip_count;
     } while (!cecs_hibitset_iterator_done(it)
-        && !cecs_hibitset_is_set_skip_unset_reverse(CECS_COW_GET_REFERENCE(cecs_hibitset, it->hibitset), it->current_bit_index, &unset_bit_skip_count)
-        && (cecs_ssize_t)it->current_bit_index >= unset_bit_skip_count);
+        && !cecs_hibitset_is_set_skip_unset_reverse(CECS_COW_GET_REFERENCE(cecs_hibitset, it->hibitset), it->current_bit_index, &unset_bit_skip_count));
     return it->current_bit_index;
 }
 
@@ -96,6 +96,10 @@ bool cecs_bitset_is_set(const cecs_bitset *b, size_t bit_index);
 
 bool cecs_bitset_bit_in_range(const cecs_bitset *b, size_t bit_index);
 
+size_t cecs_bitset_count_set(const cecs_bitset *b);
+
+cecs_memory_usage cecs_bitset_memory_usage(const cecs_bitset *b);
+
 
 typedef struct cecs_bitset_iterator {
     const cecs_bitset *const bitset;
@@ -162,6 +166,10 @@ cecs_exclusive_range cecs_hibitset_bit_range(const cecs_hibitset *b);
 
 bool cecs_hibitset_bit_in_range(const cecs_hibitset *b, size_t bit_index);
 
+size_t cecs_hibitset_count_set(const cecs_hibitset *b);
+
+cecs_memory_usage cecs_hibitset_memory_usage(const cecs_hibitset *b);
+
 
 typedef struct cecs_hibitset_iterator {
     CECS_COW_STRUCT(cecs_hibitset, cecs_hibitset) hibitset;
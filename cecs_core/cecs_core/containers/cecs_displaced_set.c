@@ -26,6 +26,16 @@ bool cecs_sentinel_set_is_empty(const cecs_sentinel_set* s) {
     return cecs_exclusive_range_is_empty(s->index_range);
 }
 
+cecs_memory_usage cecs_sentinel_set_memory_usage(const cecs_sentinel_set *s, const size_t present_count, const size_t size) {
+    const size_t present_size = present_count * size;
+    assert(present_size <= s->values.count && "error: present count exceeds sentinel set range");
+    return (cecs_memory_usage){
+        .used = present_size,
+        .reserved = s->values.capacity,
+        .sentinel_padding = s->values.count - present_size
+    };
+}
+
 extern inline bool cecs_sentinel_set_contains_range(const cecs_sentinel_set *s, const cecs_inclusive_range range);
 void *cecs_sentinel_set_expand_to_include(
     cecs_sentinel_set* s,
@@ -96,10 +106,10 @@ static inline cecs_inclusive_range cecs_sentinel_set_include_first_last_set(cecs
 }
 
 static inline cecs_inclusive_range cecs_sentinel_set_exclude_first_last_set(cecs_inclusive_range first_last_set, const cecs_inclusive_range exclude) {
-    if (cecs_inclusive_range_contains(first_last_set, exclude.start)) {
+    // NOTE: only ranges covering an edge shrink the bounds, excluding from the middle leaves absent elements inside them
+    if (exclude.start <= first_last_set.start && cecs_inclusive_range_contains(first_last_set, exclude.end)) {
         first_last_set.start = exclude.end + 1;
-    }
-    if (cecs_inclusive_range_contains(first_last_set, exclude.end)) {
+    } else if (exclude.end >= first_last_set.end && cecs_inclusive_range_contains(first_last_set, exclude.start)) {
         first_last_set.end = exclude.start - 1;
     }
     return first_last_set;
@@ -167,6 +177,11 @@ bool cecs_sentinel_set_remove(
         memcpy(out_removed_element, removed, size);
         memset(removed, absent_pattern, size);
         s->first_last_set = cecs_sentinel_set_exclude_first_last_set(s->first_last_set, cecs_inclusive_range_singleton(index));
+        if (cecs_inclusive_range_is_empty(s->first_last_set)) {
+            cecs_dynamic_array_truncate(&s->values, a, 0, size);
+            cecs_sentinel_set_clear(s);
+            return true;
+        }
 
         const size_t present_count = cecs_inclusive_range_length(s->first_last_set);
         if (present_count < (size_t)cecs_exclusive_range_length(s->index_range) / 2) {
@@ -182,8 +197,217 @@ bool cecs_sentinel_set_remove(
         return true;
     }
 }
+size_t cecs_sentinel_set_remove_range(
+    cecs_sentinel_set *s,
+    cecs_arena *a,
+    const cecs_inclusive_range range,
+    const size_t size,
+    const uint_fast8_t absent_pattern
+) {
+    const cecs_inclusive_range removed = {
+        .start = cecs_ssize_t_max(range.start, s->first_last_set.start),
+        .end = cecs_ssize_t_min(range.end, s->first_last_set.end)
+    };
+    if (removed.start > removed.end) {
+        return 0;
+    }
+
+    const size_t removed_count = cecs_inclusive_range_length(removed);
+    if (removed.start == s->first_last_set.start && removed.end == s->first_last_set.end) {
+        cecs_dynamic_array_truncate(&s->values, a, 0, size);
+        cecs_sentinel_set_clear(s);
+        return removed_count;
+    }
+
+    memset(cecs_sentinel_set_get_range_inbounds_mut(s, removed, size), absent_pattern, removed_count * size);
+    s->first_last_set = cecs_sentinel_set_exclude_first_last_set(s->first_last_set, removed);
+    if (cecs_inclusive_range_length(s->first_last_set) < cecs_exclusive_range_length(s->index_range) / 2) {
+        cecs_sentinel_set_shrink_to(s, a, s->first_last_set, size);
+    }
+    return removed_count;
+}
 void cecs_sentinel_set_clear(cecs_sentinel_set* s) {
     cecs_dynamic_array_clear(&s->values);
     s->index_range = (cecs_exclusive_range){ 0, 0 };
     s->first_last_set = (cecs_inclusive_range){ PTRDIFF_MAX, 0 };
 }
+
+void cecs_sentinel_set_shrink_to(cecs_sentinel_set *s, cecs_arena *a, const cecs_inclusive_range range, const size_t size) {
+    if (cecs_sentinel_set_is_empty(s)) {
+        return;
+    }
+
+    const cecs_ssize_t start = cecs_ssize_t_max(range.start, s->index_range.start);
+    const cecs_ssize_t end = cecs_ssize_t_min(range.end, s->index_range.end - 1);
+    if (start > end) {
+        cecs_dynamic_array_truncate(&s->values, a, 0, size);
+        cecs_sentinel_set_clear(s);
+        return;
+    }
+
+    const size_t kept_count = (size_t)(end - start + 1);
+    const size_t first_kept_index = cecs_sentinel_set_value_index(s, (size_t)start);
+    if (first_kept_index > 0) {
+        memmove(
+            s->values.values,
+            s->values.values + first_kept_index * size,
+            kept_count * size
+        );
+    }
+    cecs_dynamic_array_truncate(&s->values, a, kept_count, size);
+    s->index_range = cecs_exclusive_range_index_count(start, (cecs_ssize_t)kept_count);
+
+    s->first_last_set.start = cecs_ssize_t_max(s->first_last_set.start, start);
+    s->first_last_set.end = cecs_ssize_t_min(s->first_last_set.end, end);
+    if (s->first_last_set.start > s->first_last_set.end) {
+        s->first_last_set = (cecs_inclusive_range){ PTRDIFF_MAX, 0 };
+    }
+}
+
+static inline bool cecs_sentinel_set_value_is_absent(const uint8_t *value, const size_t size, const uint_fast8_t absent_pattern) {
+    for (size_t i = 0; i < size; ++i) {
+        if (value[i] != (uint8_t)absent_pattern) {
+            return false;
+        }
+    }
+    return true;
+}
+
+size_t cecs_sentinel_set_compact(cecs_sentinel_set *s, cecs_arena *a, const size_t size, const uint_fast8_t absent_pattern) {
+    if (cecs_sentinel_set_is_empty(s)) {
+        return 0;
+    }
+
+    const size_t previous_count = (size_t)cecs_exclusive_range_length(s->index_range);
+    cecs_inclusive_range present = {
+        .start = cecs_ssize_t_max(s->first_last_set.start, s->index_range.start),
+        .end = cecs_ssize_t_min(s->first_last_set.end, s->index_range.end - 1)
+    };
+    // NOTE: first_last_set only tracks removals at its edges, so absent values may still pad both ends of it
+    while (present.start <= present.end
+        && cecs_sentinel_set_value_is_absent(
+            cecs_dynamic_array_get(&s->values, cecs_sentinel_set_value_index(s, (size_t)present.start), size), size, absent_pattern
+        )) {
+        ++present.start;
+    }
+    while (present.start <= present.end
+        && cecs_sentinel_set_value_is_absent(
+            cecs_dynamic_array_get(&s->values, cecs_sentinel_set_value_index(s, (size_t)present.end), size), size, absent_pattern
+        )) {
+        --present.end;
+    }
+
+    cecs_sentinel_set_shrink_to(s, a, present, size);
+    return previous_count - (size_t)cecs_exclusive_range_length(s->index_range);
+}
+
+
+cecs_paged_sentinel_set cecs_paged_sentinel_set_create(const size_t size) {
+    assert(size > 0 && size <= CECS_PAGED_SENTINEL_SET_PAGE_SIZE && "error: element size must fit in a page");
+    size_t page_element_count_log2 = 0;
+    while (((size_t)2 << page_element_count_log2) * size <= CECS_PAGED_SENTINEL_SET_PAGE_SIZE) {
+        ++page_element_count_log2;
+    }
+    return (cecs_paged_sentinel_set) {
+        .pages = cecs_dynamic_array_create(),
+        .absent_page = NULL,
+        .page_range = { 0, 0 },
+        .page_size = ((size_t)1 << page_element_count_log2) * size,
+        .page_element_count_log2 = page_element_count_log2,
+        .present_page_count = 0
+    };
+}
+
+bool cecs_paged_sentinel_set_is_empty(const cecs_paged_sentinel_set *s) {
+    return s->present_page_count == 0;
+}
+
+cecs_memory_usage cecs_paged_sentinel_set_memory_usage(const cecs_paged_sentinel_set *s, const size_t present_count, const size_t size) {
+    const size_t present_size = present_count * size;
+    const size_t pages_size = s->present_page_count * s->page_size;
+    assert(present_size <= pages_size && "error: present count exceeds paged sentinel set pages");
+    return (cecs_memory_usage){
+        .used = present_size,
+        .reserved = pages_size + s->pages.capacity + (s->absent_page == NULL ? 0 : s->page_size),
+        .sentinel_padding = pages_size - present_size
+    };
+}
+
+void *cecs_paged_sentinel_set_expand_to_include(
+    cecs_paged_sentinel_set *s,
+    cecs_arena *a,
+    const cecs_inclusive_range range,
+    const size_t size,
+    const uint_fast8_t absent_pattern
+) {
+    assert(range.start >= 0 && range.start <= range.end && "error: range must be non-empty and non-negative");
+    assert(s->page_size == ((size_t)1 << s->page_element_count_log2) * size && "error: element size mismatch");
+    if (s->absent_page == NULL) {
+        s->absent_page = memset(cecs_arena_alloc(a, s->page_size), (int)absent_pattern, s->page_size);
+    }
+
+    const cecs_ssize_t first_page_index = (cecs_ssize_t)cecs_paged_sentinel_set_page_index(s, (size_t)range.start);
+    const cecs_ssize_t last_page_index = (cecs_ssize_t)cecs_paged_sentinel_set_page_index(s, (size_t)range.end);
+    if (cecs_exclusive_range_is_empty(s->page_range)) {
+        s->page_range = (cecs_exclusive_range){ .start = first_page_index, .end = first_page_index };
+    }
+
+    if (first_page_index < s->page_range.start) {
+        const size_t missing_count = (size_t)(s->page_range.start - first_page_index);
+        uint8_t **missing_pages = cecs_dynamic_array_extend_within(&s->pages, a, 0, missing_count, sizeof(uint8_t *));
+        for (size_t i = 0; i < missing_count; ++i) {
+            missing_pages[i] = s->absent_page;
+        }
+        s->page_range.start = first_page_index;
+    }
+    if (last_page_index >= s->page_range.end) {
+        const size_t missing_count = (size_t)(last_page_index + 1 - s->page_range.end);
+        uint8_t **missing_pages = cecs_dynamic_array_extend(&s->pages, a, missing_count, sizeof(uint8_t *));
+        for (size_t i = 0; i < missing_count; ++i) {
+            missing_pages[i] = s->absent_page;
+        }
+        s->page_range.end = last_page_index + 1;
+    }
+
+    for (cecs_ssize_t page_index = first_page_index; page_index <= last_page_index; ++page_index) {
+        uint8_t **page = CECS_DYNAMIC_ARRAY_GET_MUT(uint8_t *, &s->pages, (size_t)(page_index - s->page_range.start));
+        if (*page == s->absent_page) {
+            *page = memcpy(cecs_arena_alloc(a, s->page_size), s->absent_page, s->page_size);
+            ++s->present_page_count;
+        }
+    }
+    return cecs_paged_sentinel_set_get_inbounds_mut(s, (size_t)range.start, size);
+}
+
+bool cecs_paged_sentinel_set_remove(
+    cecs_paged_sentinel_set *s,
+    cecs_arena *a,
+    const size_t index,
+    void *out_removed_element,
+    const size_t size,
+    const uint_fast8_t absent_pattern
+) {
+    (void)a;
+    assert(out_removed_element != NULL && "out_removed_element must not be NULL");
+
+    if (!cecs_paged_sentinel_set_contains_index(s, index)) {
+        memset(out_removed_element, absent_pattern, size);
+        return false;
+    } else {
+        // NOTE: pages stay allocated once touched, removal only restores the absent pattern
+        void *removed = cecs_paged_sentinel_set_get_inbounds_mut(s, index, size);
+        memcpy(out_removed_element, removed, size);
+        memset(removed, absent_pattern, size);
+        return true;
+    }
+}
+
+void cecs_paged_sentinel_set_clear(cecs_paged_sentinel_set *s) {
+    const size_t page_count = CECS_DYNAMIC_ARRAY_COUNT(uint8_t *, &s->pages);
+    for (size_t i = 0; i < page_count; ++i) {
+        uint8_t *page = *CECS_DYNAMIC_ARRAY_GET(uint8_t *, &s->pages, i);
+        if (page != s->absent_page) {
+            memcpy(page, s->absent_page, s->page_size);
+        }
+    }
+}
@@ -4,6 +4,7 @@
 #include <stdbool.h>
 #include <stdint.h>
 #include <assert.h>
+#include <string.h>
 #include "cecs_union.h"
 #include "cecs_dynamic_array.h"
 #include "cecs_range.h"
@@ -22,11 +23,13 @@ inline bool cecs_sentinel_set_contains_index(const cecs_sentinel_set *s, const s
 }
 
 inline bool cecs_sentinel_set_contains_range(const cecs_sentinel_set *s, const cecs_inclusive_range range) {
-    return cecs_range_is_subrange(range.range, s->first_last_set.range);
+    return cecs_range_is_subrange(cecs_exclusive_range_from_inclusive(range.range).range, s->index_range.range);
 }
 
 bool cecs_sentinel_set_is_empty(const cecs_sentinel_set *s);
 
+cecs_memory_usage cecs_sentinel_set_memory_usage(const cecs_sentinel_set *s, const size_t present_count, const size_t size);
+
 void *cecs_sentinel_set_expand_to_include(
     cecs_sentinel_set *s,
     cecs_arena *a,
@@ -64,6 +67,97 @@ const void *cecs_sentinel_set_get_range_inbounds(const cecs_sentinel_set *s, con
 
 
 bool cecs_sentinel_set_remove(cecs_sentinel_set *s, cecs_arena *a, const size_t index, void *out_removed_element, const size_t size, const uint_fast8_t absent_pattern);
+size_t cecs_sentinel_set_remove_range(
+    cecs_sentinel_set *s,
+    cecs_arena *a,
+    const cecs_inclusive_range range,
+    const size_t size,
+    const uint_fast8_t absent_pattern
+);
 void cecs_sentinel_set_clear(cecs_sentinel_set *s);
 
+void cecs_sentinel_set_shrink_to(cecs_sentinel_set *s, cecs_arena *a, const cecs_inclusive_range range, const size_t size);
+size_t cecs_sentinel_set_compact(cecs_sentinel_set *s, cecs_arena *a, const size_t size, const uint_fast8_t absent_pattern);
+
+
+#define CECS_PAGED_SENTINEL_SET_PAGE_SIZE 4096
+
+// NOTE: pages are only allocated once an index inside them is expanded to, every other page in page_range shares absent_page
+typedef struct cecs_paged_sentinel_set {
+    cecs_dynamic_array pages;
+    uint8_t *absent_page;
+    cecs_exclusive_range page_range;
+    size_t page_size;
+    size_t page_element_count_log2;
+    size_t present_page_count;
+} cecs_paged_sentinel_set;
+
+cecs_paged_sentinel_set cecs_paged_sentinel_set_create(const size_t size);
+
+static inline size_t cecs_paged_sentinel_set_page_index(const cecs_paged_sentinel_set *s, const size_t index) {
+    return index >> s->page_element_count_log2;
+}
+static inline uint8_t *cecs_paged_sentinel_set_page(const cecs_paged_sentinel_set *s, const size_t page_index) {
+    return *CECS_DYNAMIC_ARRAY_GET(uint8_t *, &s->pages, page_index - (size_t)s->page_range.start);
+}
+
+static inline bool cecs_paged_sentinel_set_contains_index(const cecs_paged_sentinel_set *s, const size_t index) {
+    const size_t page_index = cecs_paged_sentinel_set_page_index(s, index);
+    return cecs_exclusive_range_contains(s->page_range, (cecs_ssize_t)page_index)
+        && cecs_paged_sentinel_set_page(s, page_index) != s->absent_page;
+}
+
+static inline cecs_exclusive_range cecs_paged_sentinel_set_index_range(const cecs_paged_sentinel_set *s) {
+    return (cecs_exclusive_range){
+        .start = s->page_range.start << s->page_element_count_log2,
+        .end = s->page_range.end << s->page_element_count_log2
+    };
+}
+
+bool cecs_paged_sentinel_set_is_empty(const cecs_paged_sentinel_set *s);
+
+cecs_memory_usage cecs_paged_sentinel_set_memory_usage(const cecs_paged_sentinel_set *s, const size_t present_count, const size_t size);
+
+void *cecs_paged_sentinel_set_expand_to_include(
+    cecs_paged_sentinel_set *s,
+    cecs_arena *a,
+    const cecs_inclusive_range range,
+    const size_t size,
+    const uint_fast8_t absent_pattern
+);
+
+static inline void *cecs_paged_sentinel_set_get_inbounds_mut(cecs_paged_sentinel_set *s, const size_t index, const size_t size) {
+    assert(cecs_paged_sentinel_set_contains_index(s, index) && "error: index out of bounds");
+    return cecs_paged_sentinel_set_page(s, cecs_paged_sentinel_set_page_index(s, index))
+        + (index & (((size_t)1 << s->page_element_count_log2) - 1)) * size;
+}
+#define CECS_PAGED_SENTINEL_SET_GET_INBOUNDS_MUT(type, set_ref, index) \
+    ((type *)cecs_paged_sentinel_set_get_inbounds_mut(set_ref, index, sizeof(type)))
+static inline const void *cecs_paged_sentinel_set_get_inbounds(const cecs_paged_sentinel_set *s, const size_t index, const size_t size) {
+    assert(
+        cecs_exclusive_range_contains(s->page_range, (cecs_ssize_t)cecs_paged_sentinel_set_page_index(s, index))
+        && "error: index out of bounds"
+    );
+    return cecs_paged_sentinel_set_page(s, cecs_paged_sentinel_set_page_index(s, index))
+        + (index & (((size_t)1 << s->page_element_count_log2) - 1)) * size;
+}
+#define CECS_PAGED_SENTINEL_SET_GET_INBOUNDS(type, set_ref, index) \
+    ((type *)cecs_paged_sentinel_set_get_inbounds(set_ref, index, sizeof(type)))
+
+static inline void *cecs_paged_sentinel_set_set_inbounds(cecs_paged_sentinel_set *s, const size_t index, const void *element, const size_t size) {
+    return memcpy(cecs_paged_sentinel_set_get_inbounds_mut(s, index, size), element, size);
+}
+#define CECS_PAGED_SENTINEL_SET_SET_INBOUNDS(type, set_ref, index, element_ref) \
+    ((type *)cecs_paged_sentinel_set_set_inbounds(set_ref, index, element_ref, sizeof(type)))
+
+bool cecs_paged_sentinel_set_remove(
+    cecs_paged_sentinel_set *s,
+    cecs_arena *a,
+    const size_t index,
+    void *out_removed_element,
+    const size_t size,
+    const uint_fast8_t absent_pattern
+);
+void cecs_paged_sentinel_set_clear(cecs_paged_sentinel_set *s);
+
 #endif
\ No newline at end of file
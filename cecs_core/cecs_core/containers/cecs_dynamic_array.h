@@ -21,6 +21,10 @@ static inline size_t cecs_dynamic_array_capacity_of_size(const cecs_dynamic_arra
     return l->capacity / size;
 }
 
+static inline cecs_memory_usage cecs_dynamic_array_memory_usage(const cecs_dynamic_array *l) {
+    return (cecs_memory_usage){ .used = l->count, .reserved = l->capacity, .sentinel_padding = 0 };
+}
+
 #define CECS_DYNAMIC_ARRAY_COUNT(type, cecs_dynamic_array_ref) cecs_dynamic_array_count_of_size(cecs_dynamic_array_ref, sizeof(type))
 #define CECS_DYNAMIC_ARRAY_CAPACITY(type, cecs_dynamic_array_ref) cecs_dynamic_array_capacity_of_size(cecs_dynamic_array_ref, sizeof(type))
 
@@ -1,8 +1,29 @@
 #include <memory.h>
 #include <stdlib.h>
+#include <intrin.h>
 
 #include "cecs_flatmap.h"
 
+#if defined(__AVX2__)
+    #include <immintrin.h>
+    #define CECS_FLATMAP_GROUP_AVX2
+    #define CECS_FLATMAP_GROUP_WIDTH 32
+    #define CECS_FLATMAP_GROUP_MASK_STRIDE_LOG2 0
+    typedef uint32_t cecs_flatmap_group_mask;
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define CECS_FLATMAP_GROUP_SSE2
+    #define CECS_FLATMAP_GROUP_WIDTH 16
+    #define CECS_FLATMAP_GROUP_MASK_STRIDE_LOG2 0
+    typedef uint32_t cecs_flatmap_group_mask;
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+    #include <arm_neon.h>
+    #define CECS_FLATMAP_GROUP_NEON
+    #define CECS_FLATMAP_GROUP_WIDTH 16
+    #define CECS_FLATMAP_GROUP_MASK_STRIDE_LOG2 2
+    typedef uint64_t cecs_flatmap_group_mask;
+#endif
+
 const cecs_flatmap_low_hash cecs_flatmap_low_hash_mask = CECS_FLATMPAP_LOW_HASH_MASK;
 const uint8_t cecs_flatmap_ctrl_non_occupied_last_max = CECS_FLATMAP_CTRL_NON_OCCUPIED_LAST_MAX;
 
@@ -12,10 +33,15 @@ static inline cecs_flatmap_low_hash cecs_flatmap_hash_low(const cecs_flatmap_has
 static inline cecs_flatmap_hash cecs_flatmap_hash_high(const cecs_flatmap_hash hash) {
     return hash >> CECS_FLATMAP_LOW_HASH_BITS;
 }
+[[maybe_unused]]
 static inline cecs_flatmap_low_hash cecs_flatmap_hash_split(const cecs_flatmap_hash hash, cecs_flatmap_hash *out_high_hash) {
     *out_high_hash = cecs_flatmap_hash_high(hash);
     return cecs_flatmap_hash_low(hash);
 }
+// NOTE: probing never wraps, the last eighth of the map is left as overflow for probes homed near the end
+static inline size_t cecs_flatmap_home_index(const cecs_flatmap *m, const cecs_flatmap_high_hash high_hash) {
+    return high_hash % (m->count - (m->count >> 3));
+}
 [[maybe_unused]]
 static inline cecs_flatmap_low_hash cecs_flatmap_hash_split_mut(cecs_flatmap_hash *in_out_hash) {
     cecs_flatmap_low_hash low_hash = cecs_flatmap_hash_low(*in_out_hash);
@@ -60,22 +86,130 @@ static inline cecs_flatmap_hash_header *cecs_flatmap_hash_value_at(const cecs_fl
     );
 }
 
-static bool cecs_flatmap_find_or_next_empty(
+// NOTE: incremental maps keep their tables on the heap, the arena cannot give back a drained migration table
+static inline void *cecs_flatmap_table_realloc(
+    const cecs_flatmap *m,
+    cecs_arena *a,
+    void *table,
+    const size_t current_size,
+    const size_t new_size
+) {
+    if (m->migration_step_count > 0) {
+        return realloc(table, new_size);
+    } else {
+        return cecs_arena_realloc(a, table, current_size, new_size);
+    }
+}
+
+static inline cecs_flatmap cecs_flatmap_migration_view(const cecs_flatmap *m) {
+    return (cecs_flatmap){
+        .ctrl_and_hash_values = m->migration.ctrl_and_hash_values,
+        .count = m->migration.count,
+        .occupied = m->migration.occupied,
+        .migration = { 0 },
+        .migration_step_count = 0
+    };
+}
+
+#ifdef CECS_FLATMAP_GROUP_WIDTH
+static inline uint8_t cecs_flatmap_ctrl_occupied_byte(const cecs_flatmap_low_hash low_hash) {
+    cecs_flatmap_ctrl ctrl = { 0 };
+    ctrl.any.occupied = true;
+    ctrl.occupied.low_hash = low_hash;
+
+    uint8_t byte;
+    memcpy(&byte, &ctrl, sizeof(uint8_t));
+    return byte;
+}
+
+// NOTE: empty ctrls are always all zero, deleted ctrls have their deleted bit set
+static inline void cecs_flatmap_group_match(
+    const cecs_flatmap_ctrl *group,
+    const uint8_t occupied_byte,
+    cecs_flatmap_group_mask *out_match_mask,
+    cecs_flatmap_group_mask *out_empty_mask
+) {
+#if defined(CECS_FLATMAP_GROUP_AVX2)
+    const __m256i ctrls = _mm256_loadu_si256((const __m256i *)group);
+    *out_match_mask = (cecs_flatmap_group_mask)_mm256_movemask_epi8(_mm256_cmpeq_epi8(ctrls, _mm256_set1_epi8((char)occupied_byte)));
+    *out_empty_mask = (cecs_flatmap_group_mask)_mm256_movemask_epi8(_mm256_cmpeq_epi8(ctrls, _mm256_setzero_si256()));
+#elif defined(CECS_FLATMAP_GROUP_SSE2)
+    const __m128i ctrls = _mm_loadu_si128((const __m128i *)group);
+    *out_match_mask = (cecs_flatmap_group_mask)_mm_movemask_epi8(_mm_cmpeq_epi8(ctrls, _mm_set1_epi8((char)occupied_byte)));
+    *out_empty_mask = (cecs_flatmap_group_mask)_mm_movemask_epi8(_mm_cmpeq_epi8(ctrls, _mm_setzero_si128()));
+#elif defined(CECS_FLATMAP_GROUP_NEON)
+    static const cecs_flatmap_group_mask lowest_nibble_bits = 0x1111111111111111;
+    const uint8x16_t ctrls = vld1q_u8((const uint8_t *)group);
+    const uint8x16_t match = vceqq_u8(ctrls, vdupq_n_u8(occupied_byte));
+    const uint8x16_t empty = vceqq_u8(ctrls, vdupq_n_u8(0));
+    *out_match_mask =
+        vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(match), 4)), 0) & lowest_nibble_bits;
+    *out_empty_mask =
+        vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(empty), 4)), 0) & lowest_nibble_bits;
+#endif
+}
+
+static inline size_t cecs_flatmap_group_mask_lowest(const cecs_flatmap_group_mask mask) {
+    assert(mask != 0 && "error: flatmap group mask must not be empty");
+    unsigned long lowest;
+#if CECS_FLATMAP_GROUP_MASK_STRIDE_LOG2 > 0
+    _BitScanForward64(&lowest, mask);
+#else
+    _BitScanForward(&lowest, mask);
+#endif
+    return (size_t)lowest >> CECS_FLATMAP_GROUP_MASK_STRIDE_LOG2;
+}
+#endif
+
+static bool cecs_flatmap_find_or_next_empty_from(
     const cecs_flatmap *m,
     const cecs_flatmap_hash hash,
+    const size_t home_index,
     size_t *out_index,
     const size_t value_size,
     size_t *out_previous_index
 ) {
+    assert(m->count > 0 && "error: flatmap must not be empty to probe from a home index");
     *out_previous_index = m->count;
-    if (m->count == 0) {
-        *out_index = 0;
-        return false;
-    }
 
-    cecs_flatmap_high_hash high_hash;
-    const cecs_flatmap_low_hash low_hash = cecs_flatmap_hash_split(hash, &high_hash);
-    size_t index = high_hash % m->count;
+    const cecs_flatmap_low_hash low_hash = cecs_flatmap_hash_low(hash);
+    size_t index = home_index;
+
+#ifdef CECS_FLATMAP_GROUP_WIDTH
+    const uint8_t occupied_byte = cecs_flatmap_ctrl_occupied_byte(low_hash);
+    const size_t group_end = cecs_flatmap_offset_of_values(m->count);
+    while (index + CECS_FLATMAP_GROUP_WIDTH <= group_end) {
+        cecs_flatmap_group_mask match_mask;
+        cecs_flatmap_group_mask empty_mask;
+        cecs_flatmap_group_match(m->ctrl_and_hash_values + index, occupied_byte, &match_mask, &empty_mask);
+        if (empty_mask != 0) {
+            match_mask &= (empty_mask & (~empty_mask + 1)) - 1;
+        }
+
+        while (match_mask != 0) {
+            const size_t match_index = index + cecs_flatmap_group_mask_lowest(match_mask);
+            if (cecs_flatmap_hash_value_at(m, match_index, value_size)->hash == hash) {
+                if (match_index > home_index) {
+                    *out_previous_index = match_index - 1;
+                }
+                *out_index = match_index;
+                return true;
+            }
+            match_mask &= match_mask - 1;
+        }
+
+        if (empty_mask != 0) {
+            const size_t empty_index = index + cecs_flatmap_group_mask_lowest(empty_mask);
+            if (empty_index > home_index) {
+                *out_previous_index = empty_index - 1;
+            }
+            *out_index = empty_index;
+            return false;
+        }
+        *out_previous_index = index + CECS_FLATMAP_GROUP_WIDTH - 1;
+        index += CECS_FLATMAP_GROUP_WIDTH;
+    }
+#endif
 
     cecs_flatmap_ctrl *ctrl = cecs_flatmap_ctrl_at(m, index);
     while (ctrl->any.occupied || ctrl->non_occupied.deleted) {
@@ -103,6 +237,23 @@ static bool cecs_flatmap_find_or_next_empty(
     return false;
 }
 
+static bool cecs_flatmap_find_or_next_empty(
+    const cecs_flatmap *m,
+    const cecs_flatmap_hash hash,
+    size_t *out_index,
+    const size_t value_size,
+    size_t *out_previous_index
+) {
+    if (m->count == 0) {
+        *out_previous_index = m->count;
+        *out_index = 0;
+        return false;
+    }
+    return cecs_flatmap_find_or_next_empty_from(
+        m, hash, cecs_flatmap_home_index(m, cecs_flatmap_hash_high(hash)), out_index, value_size, out_previous_index
+    );
+}
+
 static bool cecs_flatmap_find_next_empty(
     const cecs_flatmap *m,
     const cecs_flatmap_hash hash,
@@ -115,7 +266,7 @@ static bool cecs_flatmap_find_next_empty(
         return false;
     }
 
-    size_t index = cecs_flatmap_hash_high(hash) % m->count;
+    size_t index = cecs_flatmap_home_index(m, cecs_flatmap_hash_high(hash));
     cecs_flatmap_ctrl *ctrl = cecs_flatmap_ctrl_at(m, index);
     while (ctrl->any.occupied) {
         *out_previous_index = index;
@@ -131,10 +282,26 @@ cecs_flatmap cecs_flatmap_create(void) {
     return (cecs_flatmap){
         .ctrl_and_hash_values = NULL,
         .count = 0,
-        .occupied = 0
+        .occupied = 0,
+        .migration = { 0 },
+        .migration_step_count = 0
     };
 }
 
+cecs_flatmap cecs_flatmap_create_incremental(size_t migration_step_count) {
+    cecs_flatmap m = cecs_flatmap_create();
+    m.migration_step_count = migration_step_count;
+    return m;
+}
+
+void cecs_flatmap_free(cecs_flatmap *m) {
+    if (m->migration_step_count > 0) {
+        free(m->ctrl_and_hash_values);
+        free(m->migration.ctrl_and_hash_values);
+    }
+    *m = cecs_flatmap_create_incremental(m->migration_step_count);
+}
+
 // cecs_flatmap cecs_flatmap_create_with_size(cecs_arena *a, size_t value_count, size_t value_size) {
 //     const size_t count_pow2m1 = cecs_next_pow2(value_count) - 1;
 //     return (cecs_flatmap){
@@ -155,12 +322,66 @@ bool cecs_flatmap_get(
     if (cecs_flatmap_find_or_next_empty(m, hash, &index, value_size, &previous_index)) {
         *out_value = cecs_flatmap_hash_value_at(m, index, value_size) + 1;
         return true;
-    } else {
-        *out_value = NULL;
-        return false;
+    } else if (cecs_flatmap_is_migrating(m)) {
+        const cecs_flatmap old_map = cecs_flatmap_migration_view(m);
+        if (cecs_flatmap_find_or_next_empty(&old_map, hash, &index, value_size, &previous_index)) {
+            *out_value = cecs_flatmap_hash_value_at(&old_map, index, value_size) + 1;
+            return true;
+        }
     }
+
+    *out_value = NULL;
+    return false;
 }
 
+size_t cecs_flatmap_get_many(
+    const cecs_flatmap *m,
+    const cecs_flatmap_hash *hashes,
+    const size_t count,
+    void **out_values,
+    const size_t value_size
+) {
+    if (m->count == 0) {
+        memset(out_values, 0, count * sizeof(void *));
+        return 0;
+    }
+
+    size_t found_count = 0;
+    size_t home_indices[CECS_PREFETCH_BATCH_COUNT];
+    for (size_t batch_start = 0; batch_start < count; batch_start += CECS_PREFETCH_BATCH_COUNT) {
+        const size_t batch_count = min(CECS_PREFETCH_BATCH_COUNT, count - batch_start);
+        for (size_t i = 0; i < batch_count; ++i) {
+            home_indices[i] = cecs_flatmap_home_index(m, cecs_flatmap_hash_high(hashes[batch_start + i]));
+            CECS_PREFETCH(cecs_flatmap_ctrl_at(m, home_indices[i]));
+            CECS_PREFETCH(cecs_flatmap_hash_value_at(m, home_indices[i], value_size));
+        }
+
+        for (size_t i = 0; i < batch_count; ++i) {
+            size_t previous_index;
+            size_t index;
+            if (cecs_flatmap_find_or_next_empty_from(m, hashes[batch_start + i], home_indices[i], &index, value_size, &previous_index)) {
+                out_values[batch_start + i] = cecs_flatmap_hash_value_at(m, index, value_size) + 1;
+                ++found_count;
+            } else if (cecs_flatmap_is_migrating(m)) {
+                found_count += cecs_flatmap_get(m, hashes[batch_start + i], &out_values[batch_start + i], value_size);
+            } else {
+                out_values[batch_start + i] = NULL;
+            }
+        }
+    }
+    return found_count;
+}
+
+static bool cecs_flatmap_table_add(
+    cecs_flatmap *m,
+    cecs_arena *a,
+    const cecs_flatmap_hash hash,
+    const void *value,
+    const size_t value_size,
+    void **out_value,
+    const bool allow_migration
+);
+
 static size_t cecs_flatmap_set_count_and_rehash(cecs_flatmap *m, cecs_arena *a, const size_t value_size, const size_t new_count) {
     assert(cecs_flatmap_count_is_pow2m1(new_count) && "fatal error: flatmap new count is not power of 2 minus 1");
     
@@ -169,7 +390,9 @@ static size_t cecs_flatmap_set_count_and_rehash(cecs_flatmap *m, cecs_arena *a,
     cecs_flatmap old_map = (cecs_flatmap){
         .ctrl_and_hash_values = NULL,
         .count = m->count,
-        .occupied = m->occupied
+        .occupied = m->occupied,
+        .migration = { 0 },
+        .migration_step_count = 0
     };
     if (old_map.count > 0) {
         old_map_size = cecs_flatmap_offset_of_values_end(old_map.count, value_size);
@@ -179,7 +402,7 @@ static size_t cecs_flatmap_set_count_and_rehash(cecs_flatmap *m, cecs_arena *a,
     }
 
     const size_t new_map_size = cecs_flatmap_offset_of_values_end(new_count, value_size);
-    m->ctrl_and_hash_values = cecs_arena_realloc(a, m->ctrl_and_hash_values, old_map_size, new_map_size);
+    m->ctrl_and_hash_values = cecs_flatmap_table_realloc(m, a, m->ctrl_and_hash_values, old_map_size, new_map_size);
     m->count = new_count;
     m->occupied = 0;
     memset(m->ctrl_and_hash_values, 0, new_map_size);
@@ -194,7 +417,7 @@ static size_t cecs_flatmap_set_count_and_rehash(cecs_flatmap *m, cecs_arena *a,
         const cecs_flatmap_hash_header *old_hash_value = cecs_flatmap_hash_value_at(&old_map, it.index, value_size);
 
         void *out_value;
-        bool added = cecs_flatmap_add(m, a, old_hash_value->hash, old_hash_value + 1, value_size, &out_value);
+        bool added = cecs_flatmap_table_add(m, a, old_hash_value->hash, old_hash_value + 1, value_size, &out_value, false);
         assert(added && "fatal error: flatmap rehash failed to add value");
         ++occupied_count;
 
@@ -206,18 +429,64 @@ static size_t cecs_flatmap_set_count_and_rehash(cecs_flatmap *m, cecs_arena *a,
     return new_count;
 }
 
-[[maybe_unused]]
 static inline size_t cecs_flatmap_rehash(cecs_flatmap *m, cecs_arena *a, const size_t value_size) {
     return cecs_flatmap_set_count_and_rehash(m, a, value_size, m->count);
 }
 
-bool cecs_flatmap_add(
+static void cecs_flatmap_begin_migration(cecs_flatmap *m, cecs_arena *a, const size_t value_size, const size_t new_count) {
+    assert(!cecs_flatmap_is_migrating(m) && "error: flatmap is already migrating");
+    assert(cecs_flatmap_count_is_pow2m1(new_count) && "fatal error: flatmap new count is not power of 2 minus 1");
+
+    m->migration = (cecs_flatmap_migration){
+        .ctrl_and_hash_values = m->ctrl_and_hash_values,
+        .count = m->count,
+        .occupied = m->occupied,
+        .next_index = 0
+    };
+
+    const size_t new_map_size = cecs_flatmap_offset_of_values_end(new_count, value_size);
+    m->ctrl_and_hash_values = memset(cecs_flatmap_table_realloc(m, a, NULL, 0, new_map_size), 0, new_map_size);
+    m->count = new_count;
+    m->occupied = 0;
+}
+
+static void cecs_flatmap_end_migration(cecs_flatmap *m) {
+    assert(m->migration.occupied == 0 && "error: flatmap migration must be drained before it ends");
+    free(m->migration.ctrl_and_hash_values);
+    m->migration = (cecs_flatmap_migration){ 0 };
+}
+
+static void cecs_flatmap_mark_deleted(cecs_flatmap *m, const size_t index, const size_t previous_index) {
+    assert(index + 1 < m->count && "error: flatmap removal index must be below the last value index, last is reserved for empty");
+
+    cecs_flatmap_ctrl *ctrl = cecs_flatmap_ctrl_at(m, index);
+    ctrl->any.occupied = false;
+    ctrl->non_occupied.deleted = true;
+    // NOTE: skips only span deleted ctrls, empty ctrls may be occupied again before the next rehash
+    if (ctrl[1].any.occupied || !ctrl[1].non_occupied.deleted) {
+        ctrl->non_occupied.last_non_occupied = 0;
+    } else {
+        ctrl->non_occupied.last_non_occupied =
+            min(cecs_flatmap_ctrl_non_occupied_last_max, ctrl[1].non_occupied.last_non_occupied + 1);
+    }
+
+    if (previous_index < index) {
+        cecs_flatmap_ctrl *prev_ctrl = cecs_flatmap_ctrl_at(m, previous_index);
+        if (!prev_ctrl->any.occupied) {
+            prev_ctrl->non_occupied.last_non_occupied =
+                min(cecs_flatmap_ctrl_non_occupied_last_max, ctrl->non_occupied.last_non_occupied + index - previous_index);
+        }
+    }
+}
+
+static bool cecs_flatmap_table_add(
     cecs_flatmap *m,
     cecs_arena *a,
     const cecs_flatmap_hash hash,
     const void *value,
     const size_t value_size,
-    void **out_value
+    void **out_value,
+    const bool allow_migration
 ) {
     size_t previous_index;
     size_t index;
@@ -226,8 +495,17 @@ bool cecs_flatmap_add(
         return false;
     }
 
+    bool rehashed_in_place = false;
     while (index + 1 >= m->count) {
-        cecs_flatmap_set_count_and_rehash(m, a, value_size, ((m->count + 1) << 1) - 1);
+        // NOTE: deleted ctrls are never reused, purge them before growing a mostly deleted map
+        if (!rehashed_in_place && m->count > 0 && m->occupied <= m->count >> 2) {
+            cecs_flatmap_rehash(m, a, value_size);
+            rehashed_in_place = true;
+        } else if (allow_migration && m->migration_step_count > 0 && m->occupied > 0 && !cecs_flatmap_is_migrating(m)) {
+            cecs_flatmap_begin_migration(m, a, value_size, ((m->count + 1) << 1) - 1);
+        } else {
+            cecs_flatmap_set_count_and_rehash(m, a, value_size, ((m->count + 1) << 1) - 1);
+        }
         cecs_flatmap_find_next_empty(m, hash, &index, &previous_index);
     }
     assert(index + 1 < m->count && "error: flatmap insertion index must be below the last value index, last is reserved for empty");
@@ -252,6 +530,52 @@ bool cecs_flatmap_add(
     return true;
 }
 
+static void cecs_flatmap_migrate(cecs_flatmap *m, cecs_arena *a, const size_t value_size, const size_t slot_count) {
+    cecs_flatmap old_map = cecs_flatmap_migration_view(m);
+    const size_t slot_end = min(old_map.count, m->migration.next_index + slot_count);
+    for (size_t index = m->migration.next_index; index < slot_end && m->migration.occupied > 0; ++index) {
+        if (!cecs_flatmap_ctrl_at(&old_map, index)->any.occupied) {
+            continue;
+        }
+
+        const cecs_flatmap_hash_header *old_hash_value = cecs_flatmap_hash_value_at(&old_map, index, value_size);
+        void *out_value;
+        bool added = cecs_flatmap_table_add(m, a, old_hash_value->hash, old_hash_value + 1, value_size, &out_value, false);
+        assert(added && "fatal error: flatmap migration failed to add value");
+
+        cecs_flatmap_mark_deleted(&old_map, index, index > 0 ? index - 1 : old_map.count);
+        --m->migration.occupied;
+    }
+    m->migration.next_index = slot_end;
+
+    if (m->migration.occupied == 0) {
+        cecs_flatmap_end_migration(m);
+    }
+}
+
+bool cecs_flatmap_add(
+    cecs_flatmap *m,
+    cecs_arena *a,
+    const cecs_flatmap_hash hash,
+    const void *value,
+    const size_t value_size,
+    void **out_value
+) {
+    if (cecs_flatmap_is_migrating(m)) {
+        cecs_flatmap_migrate(m, a, value_size, m->migration_step_count);
+    }
+    if (cecs_flatmap_is_migrating(m)) {
+        const cecs_flatmap old_map = cecs_flatmap_migration_view(m);
+        size_t previous_index;
+        size_t index;
+        if (cecs_flatmap_find_or_next_empty(&old_map, hash, &index, value_size, &previous_index)) {
+            *out_value = NULL;
+            return false;
+        }
+    }
+    return cecs_flatmap_table_add(m, a, hash, value, value_size, out_value, true);
+}
+
 bool cecs_flatmap_remove(
     cecs_flatmap *m,
     cecs_arena *a,
@@ -259,39 +583,36 @@ bool cecs_flatmap_remove(
     void *out_removed_value,
     const size_t value_size
 ) {
+    if (cecs_flatmap_is_migrating(m)) {
+        cecs_flatmap_migrate(m, a, value_size, m->migration_step_count);
+    }
+
     size_t previous_index;
     size_t index;
-    if (!cecs_flatmap_find_or_next_empty(m, hash, &index, value_size, &previous_index)) {
-        return false;
-    }
-    assert(index + 1 < m->count && "error: flatmap removal index must be below the last value index, last is reserved for empty");
-    
-    cecs_flatmap_ctrl *ctrl = cecs_flatmap_ctrl_at(m, index);
-    ctrl->any.occupied = false;
-    ctrl->non_occupied.deleted = true;
-    if (ctrl[1].any.occupied) {
-        ctrl->non_occupied.last_non_occupied = 0;
-    } else {
-        ctrl->non_occupied.last_non_occupied =
-            min(cecs_flatmap_ctrl_non_occupied_last_max, ctrl[1].non_occupied.last_non_occupied + 1);
-    }
+    if (cecs_flatmap_find_or_next_empty(m, hash, &index, value_size, &previous_index)) {
+        memcpy(out_removed_value, cecs_flatmap_hash_value_at(m, index, value_size) + 1, value_size);
+        cecs_flatmap_mark_deleted(m, index, previous_index);
 
-    if (previous_index < index) {
-        cecs_flatmap_ctrl *prev_ctrl = cecs_flatmap_ctrl_at(m, previous_index);
-        if (!prev_ctrl->any.occupied) {
-            prev_ctrl->non_occupied.last_non_occupied =
-                min(cecs_flatmap_ctrl_non_occupied_last_max, ctrl->non_occupied.last_non_occupied + index - previous_index);
+        --m->occupied;
+        if (!cecs_flatmap_is_migrating(m) && m->occupied < m->count >> 3) {
+            cecs_flatmap_set_count_and_rehash(m, a, value_size, ((m->count + 1) >> 1) - 1);
         }
-    }
-
-    cecs_flatmap_hash_header *hash_value = cecs_flatmap_hash_value_at(m, index, value_size);
-    memcpy(out_removed_value, hash_value + 1, value_size);
+        return true;
+    } else if (cecs_flatmap_is_migrating(m)) {
+        cecs_flatmap old_map = cecs_flatmap_migration_view(m);
+        if (!cecs_flatmap_find_or_next_empty(&old_map, hash, &index, value_size, &previous_index)) {
+            return false;
+        }
+        memcpy(out_removed_value, cecs_flatmap_hash_value_at(&old_map, index, value_size) + 1, value_size);
+        cecs_flatmap_mark_deleted(&old_map, index, previous_index);
 
-    --m->occupied;
-    if (m->occupied < m->count >> 3) {
-        cecs_flatmap_set_count_and_rehash(m, a, value_size, ((m->count + 1) >> 1) - 1);
+        if (--m->migration.occupied == 0) {
+            cecs_flatmap_end_migration(m);
+        }
+        return true;
+    } else {
+        return false;
     }
-    return true;
 }
 
 void *cecs_flatmap_get_or_add(
@@ -308,6 +629,23 @@ void *cecs_flatmap_get_or_add(
     return out_value;
 }
 
+cecs_memory_usage cecs_flatmap_memory_usage(const cecs_flatmap *m, const size_t value_size) {
+    if (m->count == 0) {
+        return (cecs_memory_usage){ 0 };
+    }
+    const cecs_memory_usage usage = {
+        .used = m->occupied * (sizeof(cecs_flatmap_ctrl) + cecs_flatmap_offset_of_next_value(value_size)),
+        .reserved = cecs_flatmap_offset_of_values_end(m->count, value_size),
+        .sentinel_padding = 0
+    };
+    if (cecs_flatmap_is_migrating(m)) {
+        const cecs_flatmap old_map = cecs_flatmap_migration_view(m);
+        return cecs_memory_usage_add(usage, cecs_flatmap_memory_usage(&old_map, value_size));
+    } else {
+        return usage;
+    }
+}
+
 cecs_flatmap_iterator cecs_flatmap_iterator_create_at(cecs_flatmap *m, const size_t index) {
     return (cecs_flatmap_iterator){
         .map = m,
@@ -316,33 +654,46 @@ cecs_flatmap_iterator cecs_flatmap_iterator_create_at(cecs_flatmap *m, const siz
 }
 
 bool cecs_flatmap_iterator_done(const cecs_flatmap_iterator *it) {
-    return it->index >= it->map->count;
+    return it->index >= it->map->count + it->map->migration.count;
 }
 
 bool cecs_flatmap_iterator_done_occupied(const cecs_flatmap_iterator *it, const size_t occupied_visited) {
-    return occupied_visited >= it->map->occupied || cecs_flatmap_iterator_done(it);
+    return occupied_visited >= cecs_flatmap_occupied_count(it->map) || cecs_flatmap_iterator_done(it);
 }
 
 size_t cecs_flatmap_iterator_next(cecs_flatmap_iterator *it){
     return ++it->index;
 }
 
+// NOTE: while migrating, indices past the current table's count continue into the old table
+static inline const cecs_flatmap_ctrl *cecs_flatmap_iterator_current_ctrl(const cecs_flatmap_iterator *it) {
+    if (it->index < it->map->count) {
+        return cecs_flatmap_ctrl_at(it->map, it->index);
+    } else {
+        const cecs_flatmap old_map = cecs_flatmap_migration_view(it->map);
+        return cecs_flatmap_ctrl_at(&old_map, it->index - it->map->count);
+    }
+}
+
 size_t cecs_flatmap_iterator_next_occupied(cecs_flatmap_iterator *it) {
     ++it->index;
-    cecs_flatmap_ctrl *ctrl = it->map->ctrl_and_hash_values + it->index;
-
-    while (
-        !cecs_flatmap_iterator_done(it)
-        && !ctrl->any.occupied
-    ) {
+    while (!cecs_flatmap_iterator_done(it)) {
+        const cecs_flatmap_ctrl *ctrl = cecs_flatmap_iterator_current_ctrl(it);
+        if (ctrl->any.occupied) {
+            break;
+        }
         it->index += ctrl->non_occupied.last_non_occupied + 1;
-        ctrl += ctrl->non_occupied.last_non_occupied + 1;
     }
     return it->index;
 }
 
 cecs_flatmap_hash_header *cecs_flatmap_iterator_current_hash(const cecs_flatmap_iterator *it, const size_t value_size) {
-    return cecs_flatmap_hash_value_at(it->map, it->index, value_size);
+    if (it->index < it->map->count) {
+        return cecs_flatmap_hash_value_at(it->map, it->index, value_size);
+    } else {
+        const cecs_flatmap old_map = cecs_flatmap_migration_view(it->map);
+        return cecs_flatmap_hash_value_at(&old_map, it->index - it->map->count, value_size);
+    }
 }
 
 void *cecs_flatmap_iterator_current_value(const cecs_flatmap_iterator *it, const size_t value_size) {
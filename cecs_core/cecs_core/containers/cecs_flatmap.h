@@ -6,6 +6,7 @@
 
 #include "cecs_arena.h"
 #include "cecs_dynamic_array.h"
+#include "cecs_prefetch.h"
 
 typedef uint64_t cecs_flatmap_hash;
 typedef uint8_t cecs_flatmap_low_hash;
@@ -54,13 +55,37 @@ typedef union cecs_flatmap_hash_header {
     cecs_flatmap_hash hash;
 } cecs_flatmap_hash_header;
 
+typedef struct cecs_flatmap_migration {
+    cecs_flatmap_ctrl *ctrl_and_hash_values;
+    size_t count;
+    size_t occupied;
+    size_t next_index;
+} cecs_flatmap_migration;
+
 typedef struct cecs_flatmap {
     cecs_flatmap_ctrl *ctrl_and_hash_values;
     size_t count;
     size_t occupied;
+    cecs_flatmap_migration migration;
+    size_t migration_step_count;
 } cecs_flatmap;
 
+#define CECS_FLATMAP_MIGRATION_STEP_COUNT_DEFAULT 32
+
 cecs_flatmap cecs_flatmap_create(void);
+// NOTE: incremental maps grow into a new table and migrate up to migration_step_count old slots per add or remove,
+// their tables live outside the arena so the old table is freed once migrated, release them with cecs_flatmap_free
+cecs_flatmap cecs_flatmap_create_incremental(size_t migration_step_count);
+// NOTE: arena backed maps are only reset, the arena owns their table
+void cecs_flatmap_free(cecs_flatmap *m);
+
+static inline bool cecs_flatmap_is_migrating(const cecs_flatmap *m) {
+    return m->migration.count > 0;
+}
+
+static inline size_t cecs_flatmap_occupied_count(const cecs_flatmap *m) {
+    return m->occupied + m->migration.occupied;
+}
 // cecs_flatmap cecs_flatmap_create_with_size(cecs_arena *a, size_t capacity, size_t value_size);
 
 bool cecs_flatmap_get(
@@ -70,6 +95,14 @@ bool cecs_flatmap_get(
     const size_t value_size
 );
 
+size_t cecs_flatmap_get_many(
+    const cecs_flatmap *m,
+    const cecs_flatmap_hash *hashes,
+    const size_t count,
+    void **out_values,
+    const size_t value_size
+);
+
 bool cecs_flatmap_add(
     cecs_flatmap *m,
     cecs_arena *a,
@@ -95,6 +128,8 @@ void *cecs_flatmap_get_or_add(
     const size_t value_size
 );
 
+cecs_memory_usage cecs_flatmap_memory_usage(const cecs_flatmap *m, const size_t value_size);
+
 typedef struct cecs_flatmap_iterator {
     cecs_flatmap *map;
     size_t index;
@@ -0,0 +1,19 @@
+#ifndef CECS_PREFETCH_H
+#define CECS_PREFETCH_H
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    #include <intrin.h>
+    #define CECS_PREFETCH(address) _mm_prefetch((const char *)(address), _MM_HINT_T0)
+#elif defined(_MSC_VER) && defined(_M_ARM64)
+    #include <intrin.h>
+    #define CECS_PREFETCH(address) __prefetch((const void *)(address))
+#elif defined(__GNUC__) || defined(__clang__)
+    #define CECS_PREFETCH(address) __builtin_prefetch((const void *)(address), 0, 3)
+#else
+    #define CECS_PREFETCH(address) ((void)(address))
+#endif
+
+// NOTE: keys resolved per batch by the get_many lookups, every stage prefetches the whole batch before the next one reads it
+#define CECS_PREFETCH_BATCH_COUNT 16
+
+#endif
@@ -0,0 +1,172 @@
+#include <stdlib.h>
+#include <stddef.h>
+
+#include "cecs_range_set.h"
+
+cecs_range_set cecs_range_set_create(void) {
+    return (cecs_range_set) {
+        .ranges = cecs_dynamic_array_create(),
+        .ranges_by_length = cecs_dynamic_array_create(),
+        .length = 0
+    };
+}
+
+cecs_range_set cecs_range_set_create_with_capacity(cecs_arena *a, size_t range_capacity) {
+    return (cecs_range_set) {
+        .ranges = CECS_DYNAMIC_ARRAY_CREATE_WITH_CAPACITY(cecs_exclusive_range, a, range_capacity),
+        .ranges_by_length = CECS_DYNAMIC_ARRAY_CREATE_WITH_CAPACITY(cecs_exclusive_range, a, range_capacity),
+        .length = 0
+    };
+}
+
+static size_t cecs_range_set_lower_bound(const cecs_range_set *s, cecs_ssize_t index) {
+    size_t low = 0;
+    size_t high = cecs_range_set_range_count(s);
+    while (low < high) {
+        const size_t middle = low + ((high - low) >> 1);
+        if (cecs_range_set_get(s, middle).end <= index) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+static bool cecs_range_set_length_less(const cecs_exclusive_range range, const cecs_ssize_t length, const cecs_ssize_t start) {
+    const cecs_ssize_t range_length = cecs_exclusive_range_length(range);
+    return range_length < length || (range_length == length && range.start < start);
+}
+
+static size_t cecs_range_set_length_lower_bound(const cecs_range_set *s, cecs_ssize_t length, cecs_ssize_t start) {
+    size_t low = 0;
+    size_t high = CECS_DYNAMIC_ARRAY_COUNT(cecs_exclusive_range, &s->ranges_by_length);
+    while (low < high) {
+        const size_t middle = low + ((high - low) >> 1);
+        if (cecs_range_set_length_less(*CECS_DYNAMIC_ARRAY_GET(cecs_exclusive_range, &s->ranges_by_length, middle), length, start)) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+static void cecs_range_set_index_length(cecs_range_set *s, cecs_arena *a, const cecs_exclusive_range range) {
+    const size_t length_index = cecs_range_set_length_lower_bound(s, cecs_exclusive_range_length(range), range.start);
+    CECS_DYNAMIC_ARRAY_INSERT(cecs_exclusive_range, &s->ranges_by_length, a, length_index, &range);
+}
+
+static void cecs_range_set_unindex_length(cecs_range_set *s, cecs_arena *a, const cecs_exclusive_range range) {
+    const size_t length_index = cecs_range_set_length_lower_bound(s, cecs_exclusive_range_length(range), range.start);
+    assert(
+        length_index < CECS_DYNAMIC_ARRAY_COUNT(cecs_exclusive_range, &s->ranges_by_length)
+        && CECS_DYNAMIC_ARRAY_GET(cecs_exclusive_range, &s->ranges_by_length, length_index)->start == range.start
+        && "unreachable: range set length index is out of sync with its ranges"
+    );
+    CECS_DYNAMIC_ARRAY_REMOVE(cecs_exclusive_range, &s->ranges_by_length, a, length_index);
+}
+
+bool cecs_range_set_contains(const cecs_range_set *s, cecs_ssize_t index) {
+    const size_t range_index = cecs_range_set_lower_bound(s, index);
+    return range_index < cecs_range_set_range_count(s)
+        && cecs_exclusive_range_contains(cecs_range_set_get(s, range_index), index);
+}
+
+cecs_exclusive_range cecs_range_set_insert(cecs_range_set *s, cecs_arena *a, cecs_exclusive_range range) {
+    if (cecs_exclusive_range_is_empty(range)) {
+        return range;
+    }
+
+    size_t range_index = cecs_range_set_lower_bound(s, range.start);
+    const size_t range_count = cecs_range_set_range_count(s);
+    assert(
+        (range_index == range_count || cecs_range_set_get(s, range_index).start >= range.end)
+        && "error: inserted range overlaps a range already in the set"
+    );
+    s->length += (size_t)cecs_exclusive_range_length(range);
+
+    const bool joins_previous = range_index > 0 && cecs_range_set_get(s, range_index - 1).end == range.start;
+    const bool joins_next = range_index < range_count && cecs_range_set_get(s, range_index).start == range.end;
+    cecs_exclusive_range joined;
+    if (joins_previous && joins_next) {
+        cecs_exclusive_range *previous = CECS_DYNAMIC_ARRAY_GET_MUT(cecs_exclusive_range, &s->ranges, range_index - 1);
+        cecs_range_set_unindex_length(s, a, *previous);
+        cecs_range_set_unindex_length(s, a, cecs_range_set_get(s, range_index));
+        previous->end = cecs_range_set_get(s, range_index).end;
+        joined = *previous;
+        CECS_DYNAMIC_ARRAY_REMOVE(cecs_exclusive_range, &s->ranges, a, range_index);
+    } else if (joins_previous) {
+        cecs_exclusive_range *previous = CECS_DYNAMIC_ARRAY_GET_MUT(cecs_exclusive_range, &s->ranges, range_index - 1);
+        cecs_range_set_unindex_length(s, a, *previous);
+        previous->end = range.end;
+        joined = *previous;
+    } else if (joins_next) {
+        cecs_exclusive_range *next = CECS_DYNAMIC_ARRAY_GET_MUT(cecs_exclusive_range, &s->ranges, range_index);
+        cecs_range_set_unindex_length(s, a, *next);
+        next->start = range.start;
+        joined = *next;
+    } else {
+        joined = *CECS_DYNAMIC_ARRAY_INSERT(cecs_exclusive_range, &s->ranges, a, range_index, &range);
+    }
+    cecs_range_set_index_length(s, a, joined);
+    return joined;
+}
+
+static cecs_exclusive_range cecs_range_set_take_front_of(cecs_range_set *s, cecs_arena *a, size_t range_index, size_t count) {
+    cecs_exclusive_range *range = CECS_DYNAMIC_ARRAY_GET_MUT(cecs_exclusive_range, &s->ranges, range_index);
+    assert((size_t)cecs_exclusive_range_length(*range) >= count && "error: range set range is too small");
+
+    cecs_range_set_unindex_length(s, a, *range);
+    const cecs_exclusive_range taken = cecs_exclusive_range_index_count(range->start, (cecs_ssize_t)count);
+    range->start = taken.end;
+    if (cecs_exclusive_range_is_empty(*range)) {
+        CECS_DYNAMIC_ARRAY_REMOVE(cecs_exclusive_range, &s->ranges, a, range_index);
+    } else {
+        cecs_range_set_index_length(s, a, *range);
+    }
+    s->length -= count;
+    return taken;
+}
+
+bool cecs_range_set_take_first(cecs_range_set *s, cecs_arena *a, cecs_ssize_t *out_index) {
+    if (cecs_range_set_is_empty(s)) {
+        *out_index = 0;
+        return false;
+    }
+    *out_index = cecs_range_set_take_front_of(s, a, 0, 1).start;
+    return true;
+}
+
+bool cecs_range_set_take_best_fit(cecs_range_set *s, cecs_arena *a, size_t count, cecs_exclusive_range *out_range) {
+    // NOTE: the shortest fitting range, lowest start among equally long ones
+    const size_t length_index = cecs_range_set_length_lower_bound(s, (cecs_ssize_t)count, PTRDIFF_MIN);
+    if (length_index == CECS_DYNAMIC_ARRAY_COUNT(cecs_exclusive_range, &s->ranges_by_length)) {
+        *out_range = (cecs_exclusive_range){ .start = 0, .end = 0 };
+        return false;
+    }
+
+    const cecs_exclusive_range best = *CECS_DYNAMIC_ARRAY_GET(cecs_exclusive_range, &s->ranges_by_length, length_index);
+    *out_range = cecs_range_set_take_front_of(s, a, cecs_range_set_lower_bound(s, best.start), count);
+    return true;
+}
+
+bool cecs_range_set_take_last_ending_at(cecs_range_set *s, cecs_arena *a, cecs_ssize_t end, cecs_exclusive_range *out_range) {
+    const size_t range_count = cecs_range_set_range_count(s);
+    if (range_count == 0 || cecs_range_set_get(s, range_count - 1).end != end) {
+        *out_range = (cecs_exclusive_range){ .start = end, .end = end };
+        return false;
+    }
+
+    *out_range = cecs_range_set_get(s, range_count - 1);
+    cecs_range_set_unindex_length(s, a, *out_range);
+    s->length -= (size_t)cecs_exclusive_range_length(*out_range);
+    CECS_DYNAMIC_ARRAY_REMOVE(cecs_exclusive_range, &s->ranges, a, range_count - 1);
+    return true;
+}
+
+void cecs_range_set_clear(cecs_range_set *s) {
+    cecs_dynamic_array_clear(&s->ranges);
+    cecs_dynamic_array_clear(&s->ranges_by_length);
+    s->length = 0;
+}
@@ -0,0 +1,58 @@
+#ifndef CECS_RANGE_SET_H
+#define CECS_RANGE_SET_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <assert.h>
+
+#include "cecs_arena.h"
+#include "cecs_dynamic_array.h"
+#include "cecs_range.h"
+
+// NOTE: ranges are ordered by start, ranges_by_length holds the same ranges ordered by length then start,
+// so both position and best fit lookups are binary searches
+typedef struct cecs_range_set {
+    cecs_dynamic_array ranges;
+    cecs_dynamic_array ranges_by_length;
+    size_t length;
+} cecs_range_set;
+
+cecs_range_set cecs_range_set_create(void);
+cecs_range_set cecs_range_set_create_with_capacity(cecs_arena *a, size_t range_capacity);
+
+static inline cecs_memory_usage cecs_range_set_memory_usage(const cecs_range_set *s) {
+    return cecs_memory_usage_add(
+        cecs_dynamic_array_memory_usage(&s->ranges),
+        cecs_dynamic_array_memory_usage(&s->ranges_by_length)
+    );
+}
+
+static inline size_t cecs_range_set_length(const cecs_range_set *s) {
+    return s->length;
+}
+
+static inline size_t cecs_range_set_range_count(const cecs_range_set *s) {
+    return CECS_DYNAMIC_ARRAY_COUNT(cecs_exclusive_range, &s->ranges);
+}
+
+static inline bool cecs_range_set_is_empty(const cecs_range_set *s) {
+    return s->length == 0;
+}
+
+static inline cecs_exclusive_range cecs_range_set_get(const cecs_range_set *s, size_t range_index) {
+    return *CECS_DYNAMIC_ARRAY_GET(cecs_exclusive_range, &s->ranges, range_index);
+}
+
+bool cecs_range_set_contains(const cecs_range_set *s, cecs_ssize_t index);
+
+cecs_exclusive_range cecs_range_set_insert(cecs_range_set *s, cecs_arena *a, cecs_exclusive_range range);
+
+bool cecs_range_set_take_first(cecs_range_set *s, cecs_arena *a, cecs_ssize_t *out_index);
+
+bool cecs_range_set_take_best_fit(cecs_range_set *s, cecs_arena *a, size_t count, cecs_exclusive_range *out_range);
+
+bool cecs_range_set_take_last_ending_at(cecs_range_set *s, cecs_arena *a, cecs_ssize_t end, cecs_exclusive_range *out_range);
+
+void cecs_range_set_clear(cecs_range_set *s);
+
+#endif
@@ -1,4 +1,5 @@
 #include <memory.h>
+#include <stdlib.h>
 
 // #include <cecs_math/arithmetic/cecs_integer_arithmetic.h>
 #include "cecs_sparse_set.h"
@@ -44,7 +45,7 @@ cecs_sparse_set cecs_sparse_set_create(void)
                 CECS_UNION_CREATE(cecs_any_elements, cecs_sparse_set_elements, cecs_dynamic_array_create()),
             .index_to_key = cecs_dynamic_array_create(),
         },
-        .key_to_index = cecs_sentinel_set_create(),
+        .key_to_index = cecs_paged_sentinel_set_create(sizeof(cecs_sparse_set_index)),
     };
 }
 cecs_sparse_set cecs_sparse_set_create_of_integers(void) {
@@ -54,7 +55,7 @@ cecs_sparse_set cecs_sparse_set_create_of_integers(void) {
                 CECS_UNION_CREATE(cecs_integer_elements, cecs_sparse_set_elements, cecs_dynamic_array_create()),
             .index_to_key = cecs_dynamic_array_create(),
         },
-        .key_to_index = cecs_sentinel_set_create(),
+        .key_to_index = cecs_paged_sentinel_set_create(sizeof(cecs_sparse_set_index)),
     };
 }
 cecs_sparse_set cecs_sparse_set_create_with_capacity(cecs_arena* a, size_t element_capacity, size_t element_size) {
@@ -64,7 +65,7 @@ cecs_sparse_set cecs_sparse_set_create_with_capacity(cecs_arena* a, size_t eleme
                 CECS_UNION_CREATE(cecs_any_elements, cecs_sparse_set_elements, cecs_dynamic_array_create_with_capacity(a, element_capacity * element_size)),
             .index_to_key = cecs_dynamic_array_create_with_capacity(a, sizeof(size_t) * element_capacity),
         },
-        .key_to_index = cecs_sentinel_set_create_with_capacity(a, sizeof(cecs_sparse_set_index) * element_capacity),
+        .key_to_index = cecs_paged_sentinel_set_create(sizeof(cecs_sparse_set_index)),
     };
 }
 cecs_sparse_set cecs_sparse_set_create_of_integers_with_capacity(cecs_arena* a, size_t element_capacity, size_t element_size) {
@@ -74,21 +75,72 @@ cecs_sparse_set cecs_sparse_set_create_of_integers_with_capacity(cecs_arena* a,
                 CECS_UNION_CREATE(cecs_any_elements, cecs_sparse_set_elements, cecs_dynamic_array_create_with_capacity(a, element_capacity * element_size)),
             .index_to_key = cecs_dynamic_array_create(),
         },
-        .key_to_index = cecs_sentinel_set_create_with_capacity(a, sizeof(cecs_sparse_set_index) * element_capacity),
+        .key_to_index = cecs_paged_sentinel_set_create(sizeof(cecs_sparse_set_index)),
     };
 }
 
 static inline cecs_sparse_set_index *cecs_sparse_set_get_index_ptr(cecs_sparse_set_key_to_index *k, const size_t key) {
-    return CECS_SENTINEL_SET_GET_INBOUNDS(cecs_sparse_set_index, k, key);
+    return CECS_PAGED_SENTINEL_SET_GET_INBOUNDS(cecs_sparse_set_index, k, key);
 }
 cecs_sparse_set_index cecs_sparse_set_get_index(const cecs_sparse_set *s, size_t key) {
     return *cecs_sparse_set_get_index_ptr((cecs_sparse_set_key_to_index *)&s->key_to_index, key);
 }
 
+static size_t cecs_sparse_set_base_get_batch(
+    cecs_sparse_set_base *s,
+    cecs_sparse_set_key_to_index *const *key_to_indices,
+    const size_t *keys,
+    const size_t count,
+    void **out_elements,
+    const size_t element_size
+) {
+    assert(count <= CECS_PREFETCH_BATCH_COUNT && "error: sparse set batch count must not exceed the prefetch batch count");
+    for (size_t i = 0; i < count; ++i) {
+        if (key_to_indices[i] != NULL) {
+            CECS_PREFETCH(cecs_sparse_set_get_index_ptr(key_to_indices[i], keys[i]));
+        }
+    }
+
+    size_t found_count = 0;
+    cecs_any_elements *values = cecs_sparse_set_base_values_array_any_unchecked(s);
+    for (size_t i = 0; i < count; ++i) {
+        const cecs_sparse_set_index index = key_to_indices[i] == NULL
+            ? cecs_sparse_set_index_invalid
+            : *cecs_sparse_set_get_index_ptr(key_to_indices[i], keys[i]);
+
+        if (cecs_sparse_set_index_check(index)) {
+            out_elements[i] = cecs_dynamic_array_get_mut(values, cecs_sparse_set_index_look(index), element_size);
+            CECS_PREFETCH(out_elements[i]);
+            ++found_count;
+        } else {
+            out_elements[i] = NULL;
+        }
+    }
+    return found_count;
+}
+
 void cecs_sparse_set_clear(cecs_sparse_set *s) {
     cecs_dynamic_array_clear(cecs_sparse_set_base_values_array_any_unchecked(&s->base));
     cecs_dynamic_array_clear(&s->base.index_to_key);
-    cecs_sentinel_set_clear(&s->key_to_index);
+    cecs_paged_sentinel_set_clear(&s->key_to_index);
+}
+
+static cecs_memory_usage cecs_sparse_set_base_memory_usage(const cecs_sparse_set_base *s) {
+    return cecs_memory_usage_add(
+        cecs_dynamic_array_memory_usage(cecs_sparse_set_base_values_array_any_unchecked((cecs_sparse_set_base *)s)),
+        cecs_dynamic_array_memory_usage(&s->index_to_key)
+    );
+}
+
+cecs_memory_usage cecs_sparse_set_memory_usage(const cecs_sparse_set *s, size_t element_size) {
+    return cecs_memory_usage_add(
+        cecs_sparse_set_base_memory_usage(&s->base),
+        cecs_paged_sentinel_set_memory_usage(
+            &s->key_to_index,
+            cecs_sparse_set_count_of_size(s, element_size),
+            sizeof(cecs_sparse_set_index)
+        )
+    );
 }
 
 static cecs_sparse_set_index cecs_sparse_set_add_key(
@@ -99,15 +151,15 @@ static cecs_sparse_set_index cecs_sparse_set_add_key(
     size_t size
 ) {
     cecs_sparse_set_index *index;
-    if (!cecs_sentinel_set_contains_index(k, key)) {
-        cecs_sentinel_set_expand_to_include(
+    if (!cecs_paged_sentinel_set_contains_index(k, key)) {
+        cecs_paged_sentinel_set_expand_to_include(
             k,
             a,
             cecs_inclusive_range_singleton(key),
             sizeof(cecs_sparse_set_index),
             CECS_SPARSE_SET_INDEX_INVALID_VALUE_INT
         );
-        index = cecs_sentinel_set_set_inbounds(k, key, (cecs_sparse_set_index *)&cecs_sparse_set_index_invalid, sizeof(cecs_sparse_set_index));
+        index = cecs_paged_sentinel_set_set_inbounds(k, key, (cecs_sparse_set_index *)&cecs_sparse_set_index_invalid, sizeof(cecs_sparse_set_index));
     } else {
         index = cecs_sparse_set_get_index_ptr(k, key);
     }
@@ -138,7 +190,7 @@ static size_t cecs_sparse_set_add_key_expect(cecs_sparse_set *s, cecs_arena *a,
 }
 
 cecs_optional_element cecs_sparse_set_get(cecs_sparse_set *s, size_t key, size_t element_size) {
-    if (!cecs_sentinel_set_contains_index(&s->key_to_index, key)) {
+    if (!cecs_paged_sentinel_set_contains_index(&s->key_to_index, key)) {
         return CECS_OPTION_CREATE_NONE_STRUCT(cecs_optional_element);
     }
 
@@ -157,6 +209,24 @@ cecs_optional_element cecs_sparse_set_get(cecs_sparse_set *s, size_t key, size_t
     }
 }
 
+size_t cecs_sparse_set_get_many(cecs_sparse_set *s, const size_t *keys, size_t count, void **out_elements, size_t element_size) {
+    size_t found_count = 0;
+    cecs_sparse_set_key_to_index *key_to_indices[CECS_PREFETCH_BATCH_COUNT];
+    for (size_t batch_start = 0; batch_start < count; batch_start += CECS_PREFETCH_BATCH_COUNT) {
+        const size_t batch_count = min(CECS_PREFETCH_BATCH_COUNT, count - batch_start);
+        for (size_t i = 0; i < batch_count; ++i) {
+            key_to_indices[i] = cecs_paged_sentinel_set_contains_index(&s->key_to_index, keys[batch_start + i])
+                ? &s->key_to_index
+                : NULL;
+        }
+
+        found_count += cecs_sparse_set_base_get_batch(
+            &s->base, key_to_indices, keys + batch_start, batch_count, out_elements + batch_start, element_size
+        );
+    }
+    return found_count;
+}
+
 void* cecs_sparse_set_get_expect(cecs_sparse_set* s, size_t key, size_t element_size) {
     return CECS_OPTION_GET(cecs_optional_element, cecs_sparse_set_get(s, key, element_size));
 }
@@ -234,7 +304,7 @@ static bool cecs_sparse_set_remove_key(
     size_t **out_invalidated_key
 ) {
     (void)a;
-    if (!cecs_sentinel_set_contains_index(k, key)) {
+    if (!cecs_paged_sentinel_set_contains_index(k, key)) {
         return false;
     }
 
@@ -359,6 +429,141 @@ bool cecs_sparse_set_remove_range(
     }
 }
 
+typedef struct cecs_sparse_set_sort_entry {
+    uint64_t sort_key;
+    size_t index;
+} cecs_sparse_set_sort_entry;
+
+static int cecs_sparse_set_sort_entry_compare(const void *lhs, const void *rhs) {
+    const cecs_sparse_set_sort_entry *l = lhs;
+    const cecs_sparse_set_sort_entry *r = rhs;
+    if (l->sort_key != r->sort_key) {
+        return l->sort_key < r->sort_key ? -1 : 1;
+    }
+    return (l->index > r->index) - (l->index < r->index);
+}
+
+static inline uint64_t cecs_sparse_set_sort_key_at(
+    cecs_sparse_set *s,
+    size_t index,
+    cecs_sparse_set_sort_key *sort_key,
+    void *context,
+    size_t element_size
+) {
+    const size_t key = cecs_sparse_set_key_unchecked(s, index);
+    if (sort_key == NULL) {
+        return (uint64_t)key;
+    }
+    return sort_key(
+        key,
+        cecs_dynamic_array_get(cecs_sparse_set_base_values_array_any_unchecked(&s->base), index, element_size),
+        context
+    );
+}
+
+void cecs_sparse_set_sort(cecs_sparse_set *s, cecs_sparse_set_sort_key *sort_key, void *context, size_t element_size) {
+    const size_t count = cecs_sparse_set_count_of_size(s, element_size);
+    if (count < 2) {
+        return;
+    }
+
+    const bool integer = cecs_sparse_set_base_is_of_integers(&s->base);
+    cecs_arena arena = cecs_arena_create_with_capacity(
+        count * (sizeof(cecs_sparse_set_sort_entry) + element_size + (integer ? 0 : sizeof(size_t)))
+    );
+    cecs_sparse_set_sort_entry *entries = cecs_arena_alloc(&arena, count * sizeof(cecs_sparse_set_sort_entry));
+    for (size_t i = 0; i < count; i++) {
+        entries[i] = (cecs_sparse_set_sort_entry){
+            .sort_key = cecs_sparse_set_sort_key_at(s, i, sort_key, context, element_size),
+            .index = i
+        };
+    }
+    qsort(entries, count, sizeof(cecs_sparse_set_sort_entry), cecs_sparse_set_sort_entry_compare);
+
+    uint8_t *values = cecs_sparse_set_values_mut(s);
+    uint8_t *sorted_values = cecs_arena_alloc(&arena, count * element_size);
+    for (size_t i = 0; i < count; i++) {
+        memcpy(sorted_values + i * element_size, values + entries[i].index * element_size, element_size);
+    }
+    memcpy(values, sorted_values, count * element_size);
+
+    if (!integer) {
+        size_t *keys = cecs_sparse_set_keys(s);
+        size_t *sorted_keys = cecs_arena_alloc(&arena, count * sizeof(size_t));
+        for (size_t i = 0; i < count; i++) {
+            sorted_keys[i] = keys[entries[i].index];
+        }
+        memcpy(keys, sorted_keys, count * sizeof(size_t));
+    }
+    cecs_arena_free(&arena);
+
+    for (size_t i = 0; i < count; i++) {
+        *cecs_sparse_set_get_index_ptr(&s->key_to_index, cecs_sparse_set_key_unchecked(s, i)) = (cecs_sparse_set_index){ i };
+    }
+}
+
+static void cecs_sparse_set_swap_adjacent(cecs_sparse_set *s, size_t index, size_t element_size) {
+    uint8_t *first = (uint8_t *)cecs_sparse_set_values_mut(s) + index * element_size;
+    uint8_t *second = first + element_size;
+    uint8_t buffer[64];
+    for (size_t offset = 0; offset < element_size; offset += sizeof(buffer)) {
+        const size_t chunk_size = min(sizeof(buffer), element_size - offset);
+        memcpy(buffer, first + offset, chunk_size);
+        memcpy(first + offset, second + offset, chunk_size);
+        memcpy(second + offset, buffer, chunk_size);
+    }
+
+    if (!cecs_sparse_set_base_is_of_integers(&s->base)) {
+        size_t *keys = cecs_sparse_set_keys(s);
+        const size_t key = keys[index];
+        keys[index] = keys[index + 1];
+        keys[index + 1] = key;
+    }
+    *cecs_sparse_set_get_index_ptr(&s->key_to_index, cecs_sparse_set_key_unchecked(s, index)) = (cecs_sparse_set_index){ index };
+    *cecs_sparse_set_get_index_ptr(&s->key_to_index, cecs_sparse_set_key_unchecked(s, index + 1)) = (cecs_sparse_set_index){ index + 1 };
+}
+
+size_t cecs_sparse_set_sort_step(
+    cecs_sparse_set *s,
+    size_t sorted_count,
+    size_t move_budget,
+    cecs_sparse_set_sort_key *sort_key,
+    void *context,
+    size_t element_size
+) {
+    const size_t count = cecs_sparse_set_count_of_size(s, element_size);
+    const size_t initial_move_budget = move_budget;
+    if (sorted_count == 0 && count > 0) {
+        sorted_count = 1;
+    }
+
+    while (sorted_count < count && move_budget > 0) {
+        const uint64_t inserted_sort_key = cecs_sparse_set_sort_key_at(s, sorted_count, sort_key, context, element_size);
+        size_t low = 0;
+        size_t high = sorted_count;
+        while (low < high) {
+            const size_t middle = low + ((high - low) >> 1);
+            if (cecs_sparse_set_sort_key_at(s, middle, sort_key, context, element_size) <= inserted_sort_key) {
+                low = middle + 1;
+            } else {
+                high = middle;
+            }
+        }
+
+        const size_t move_count = sorted_count - low;
+        if (move_count > move_budget && move_budget < initial_move_budget) {
+            // NOTE: leave the insertion to a later step rather than splitting it, the sorted prefix must stay sorted
+            break;
+        }
+        for (size_t i = sorted_count; i > low; i--) {
+            cecs_sparse_set_swap_adjacent(s, i - 1, element_size);
+        }
+        move_budget -= min(move_budget, move_count + 1);
+        ++sorted_count;
+    }
+    return min(sorted_count, count);
+}
+
 const size_t cecs_paged_sparse_set_page_size = CECS_PAGED_SPARSE_SET_PAGE_SIZE;
 
 static inline uint64_t cecs_paged_sparse_set_page_index(size_t key) {
@@ -369,12 +574,17 @@ static inline size_t cecs_paged_sparse_set_page_key(size_t key) {
     return key & (CECS_PAGED_SPARSE_SET_PAGE_SIZE - 1);
 }
 
+static inline bool cecs_paged_sparse_set_page_is_direct(uint64_t page_index) {
+    return page_index < CECS_PAGED_SPARSE_SET_DIRECT_PAGE_COUNT;
+}
+
 cecs_paged_sparse_set cecs_paged_sparse_set_create(void) {
     cecs_paged_sparse_set set = (cecs_paged_sparse_set){
         .base = (cecs_sparse_set_base){
             .values = CECS_UNION_CREATE(cecs_any_elements, cecs_sparse_set_elements, cecs_dynamic_array_create()),
             .index_to_key = cecs_dynamic_array_create(),
         },
+        .page_table = cecs_dynamic_array_create(),
         .key_to_pagekey_to_index = cecs_flatmap_create(),
     };
     return set;
@@ -385,6 +595,7 @@ cecs_paged_sparse_set cecs_paged_sparse_set_create_of_integers(void) {
             .values = CECS_UNION_CREATE(cecs_integer_elements, cecs_sparse_set_elements, cecs_dynamic_array_create()),
             .index_to_key = cecs_dynamic_array_create(),
         },
+        .page_table = cecs_dynamic_array_create(),
         .key_to_pagekey_to_index = cecs_flatmap_create(),
     };
     return set;
@@ -395,6 +606,7 @@ cecs_paged_sparse_set cecs_paged_sparse_set_create_with_capacity(cecs_arena* a,
             .values = CECS_UNION_CREATE(cecs_any_elements, cecs_sparse_set_elements, cecs_dynamic_array_create_with_capacity(a, element_capacity * element_size)),
             .index_to_key = cecs_dynamic_array_create_with_capacity(a, sizeof(size_t) * element_capacity),
         },
+        .page_table = cecs_dynamic_array_create(),
         .key_to_pagekey_to_index = cecs_flatmap_create(),
     };
     return set;
@@ -405,26 +617,52 @@ cecs_paged_sparse_set cecs_paged_sparse_set_create_of_integers_with_capacity(cec
             .values = CECS_UNION_CREATE(cecs_integer_elements, cecs_sparse_set_elements, cecs_dynamic_array_create_with_capacity(a, element_capacity * element_size)),
             .index_to_key = cecs_dynamic_array_create(),
         },
+        .page_table = cecs_dynamic_array_create(),
         .key_to_pagekey_to_index = cecs_flatmap_create(),
     };
     return set;
 }
 
-static bool cecs_paged_sparse_set_key_to_index(
-    cecs_paged_sparse_set *s,
+static bool cecs_paged_sparse_set_find_key_to_index(
+    const cecs_paged_sparse_set *s,
     const size_t key,
-    cecs_sparse_set_key_to_index **out_key_to_index,
+    const cecs_sparse_set_key_to_index **out_key_to_index,
     size_t *out_page_key
 ) {
     uint64_t page_index = cecs_paged_sparse_set_page_index(key);
     *out_page_key = cecs_paged_sparse_set_page_key(key);
-    
-    return cecs_flatmap_get(
+
+    if (cecs_paged_sparse_set_page_is_direct(page_index)) {
+        if (page_index >= CECS_DYNAMIC_ARRAY_COUNT(cecs_sparse_set_key_to_index, &s->page_table)) {
+            *out_key_to_index = NULL;
+            return false;
+        }
+        *out_key_to_index = CECS_DYNAMIC_ARRAY_GET(cecs_sparse_set_key_to_index, &s->page_table, page_index);
+        return true;
+    }
+
+    void *key_to_index;
+    const bool found = cecs_flatmap_get(
         &s->key_to_pagekey_to_index,
         page_index,
-        (void **)out_key_to_index,
+        &key_to_index,
         sizeof(cecs_sparse_set_key_to_index)
     );
+    *out_key_to_index = key_to_index;
+    return found;
+}
+
+static bool cecs_paged_sparse_set_key_to_index(
+    cecs_paged_sparse_set *s,
+    const size_t key,
+    cecs_sparse_set_key_to_index **out_key_to_index,
+    size_t *out_page_key
+) {
+    const cecs_sparse_set_key_to_index *key_to_index;
+    const bool found = cecs_paged_sparse_set_find_key_to_index(s, key, &key_to_index, out_page_key);
+    // NOTE: pages of a mutable set are mutable
+    *out_key_to_index = (cecs_sparse_set_key_to_index *)key_to_index;
+    return found;
 }
 
 static cecs_sparse_set_key_to_index *cecs_paged_sparse_set_key_to_index_or_add(
@@ -435,8 +673,21 @@ static cecs_sparse_set_key_to_index *cecs_paged_sparse_set_key_to_index_or_add(
 ) {
     uint64_t page_index = cecs_paged_sparse_set_page_index(key);
     *out_page_key = cecs_paged_sparse_set_page_key(key);
+
+    if (cecs_paged_sparse_set_page_is_direct(page_index)) {
+        const size_t page_count = CECS_DYNAMIC_ARRAY_COUNT(cecs_sparse_set_key_to_index, &s->page_table);
+        if (page_index >= page_count) {
+            cecs_sparse_set_key_to_index *new_pages = CECS_DYNAMIC_ARRAY_APPEND_EMPTY(
+                cecs_sparse_set_key_to_index, &s->page_table, a, page_index + 1 - page_count
+            );
+            for (size_t i = 0; i < page_index + 1 - page_count; ++i) {
+                new_pages[i] = cecs_paged_sentinel_set_create(sizeof(cecs_sparse_set_index));
+            }
+        }
+        return CECS_DYNAMIC_ARRAY_GET_MUT(cecs_sparse_set_key_to_index, &s->page_table, page_index);
+    }
     
-    cecs_sparse_set_key_to_index key_to_index = cecs_sentinel_set_create();
+    cecs_sparse_set_key_to_index key_to_index = cecs_paged_sentinel_set_create(sizeof(cecs_sparse_set_index));
     return cecs_flatmap_get_or_add(
         &s->key_to_pagekey_to_index,
         a,
@@ -448,24 +699,61 @@ static cecs_sparse_set_key_to_index *cecs_paged_sparse_set_key_to_index_or_add(
 
 bool cecs_paged_sparse_set_contains(const cecs_paged_sparse_set *s, size_t key) {
     size_t page_key;
-    cecs_sparse_set_key_to_index *key_to_index;
+    const cecs_sparse_set_key_to_index *key_to_index;
 
-    return cecs_paged_sparse_set_key_to_index((cecs_paged_sparse_set *)s, key, &key_to_index, &page_key)
-        && cecs_sentinel_set_contains_index(key_to_index, page_key)
-        && cecs_sparse_set_index_check(*CECS_SENTINEL_SET_GET_INBOUNDS(cecs_sparse_set_index, key_to_index, page_key));
+    return cecs_paged_sparse_set_find_key_to_index(s, key, &key_to_index, &page_key)
+        && cecs_paged_sentinel_set_contains_index(key_to_index, page_key)
+        && cecs_sparse_set_index_check(*CECS_PAGED_SENTINEL_SET_GET_INBOUNDS(cecs_sparse_set_index, key_to_index, page_key));
+}
+
+cecs_memory_usage cecs_paged_sparse_set_memory_usage(const cecs_paged_sparse_set *s, size_t element_size) {
+    cecs_memory_usage usage = cecs_memory_usage_add(
+        cecs_memory_usage_add(
+            cecs_sparse_set_base_memory_usage(&s->base),
+            cecs_dynamic_array_memory_usage(&s->page_table)
+        ),
+        cecs_flatmap_memory_usage(&s->key_to_pagekey_to_index, sizeof(cecs_sparse_set_key_to_index))
+    );
+
+    cecs_memory_usage pages_usage = { 0 };
+    for (size_t i = 0; i < CECS_DYNAMIC_ARRAY_COUNT(cecs_sparse_set_key_to_index, &s->page_table); ++i) {
+        const cecs_sparse_set_key_to_index *key_to_index = CECS_DYNAMIC_ARRAY_GET(cecs_sparse_set_key_to_index, &s->page_table, i);
+        pages_usage = cecs_memory_usage_add(pages_usage, cecs_paged_sentinel_set_memory_usage(key_to_index, 0, sizeof(cecs_sparse_set_index)));
+    }
+
+    cecs_flatmap_iterator it = cecs_flatmap_iterator_create_at((cecs_flatmap *)&s->key_to_pagekey_to_index, 0);
+    if (s->key_to_pagekey_to_index.count > 0 && !s->key_to_pagekey_to_index.ctrl_and_hash_values[0].any.occupied) {
+        cecs_flatmap_iterator_next_occupied(&it);
+    }
+
+    size_t occupied_count = 0;
+    while (!cecs_flatmap_iterator_done_occupied(&it, occupied_count)) {
+        const cecs_sparse_set_key_to_index *key_to_index =
+            cecs_flatmap_iterator_current_value(&it, sizeof(cecs_sparse_set_key_to_index));
+        pages_usage = cecs_memory_usage_add(pages_usage, cecs_paged_sentinel_set_memory_usage(key_to_index, 0, sizeof(cecs_sparse_set_index)));
+
+        ++occupied_count;
+        cecs_flatmap_iterator_next_occupied(&it);
+    }
+
+    const size_t present_size = cecs_paged_sparse_set_count_of_size(s, element_size) * sizeof(cecs_sparse_set_index);
+    assert(present_size <= pages_usage.sentinel_padding && "fatal error: paged sparse set page count mismatch");
+    pages_usage.used = present_size;
+    pages_usage.sentinel_padding -= present_size;
+    return cecs_memory_usage_add(usage, pages_usage);
 }
 
 cecs_optional_element cecs_paged_sparse_set_get(cecs_paged_sparse_set *s, size_t key, size_t element_size) {
     size_t page_key;
-    cecs_sentinel_set* key_to_index;
+    cecs_paged_sentinel_set *key_to_index;
     if (
         !cecs_paged_sparse_set_key_to_index(s, key, &key_to_index, &page_key)
-        || !cecs_sentinel_set_contains_index(key_to_index, page_key)
+        || !cecs_paged_sentinel_set_contains_index(key_to_index, page_key)
     ) {
         return CECS_OPTION_CREATE_NONE_STRUCT(cecs_optional_element);
     }
 
-    const cecs_sparse_set_index index = *CECS_SENTINEL_SET_GET_INBOUNDS(cecs_sparse_set_index, key_to_index, page_key);
+    const cecs_sparse_set_index index = *CECS_PAGED_SENTINEL_SET_GET_INBOUNDS(cecs_sparse_set_index, key_to_index, page_key);
     if (cecs_sparse_set_index_check(index)) {
         return CECS_OPTION_CREATE_SOME_STRUCT(
             cecs_optional_element,
@@ -480,6 +768,70 @@ cecs_optional_element cecs_paged_sparse_set_get(cecs_paged_sparse_set *s, size_t
     }
 }
 
+const void *cecs_paged_sparse_set_find(const cecs_paged_sparse_set *s, size_t key, size_t element_size) {
+    size_t page_key;
+    const cecs_sparse_set_key_to_index *key_to_index;
+    if (
+        !cecs_paged_sparse_set_find_key_to_index(s, key, &key_to_index, &page_key)
+        || !cecs_paged_sentinel_set_contains_index(key_to_index, page_key)
+    ) {
+        return NULL;
+    }
+
+    const cecs_sparse_set_index index = *CECS_PAGED_SENTINEL_SET_GET_INBOUNDS(cecs_sparse_set_index, key_to_index, page_key);
+    if (!cecs_sparse_set_index_check(index)) {
+        return NULL;
+    }
+    return (const uint8_t *)cecs_paged_sparse_set_values(s) + cecs_sparse_set_index_look(index) * element_size;
+}
+
+size_t cecs_paged_sparse_set_get_many(cecs_paged_sparse_set *s, const size_t *keys, size_t count, void **out_elements, size_t element_size) {
+    size_t found_count = 0;
+    size_t page_keys[CECS_PREFETCH_BATCH_COUNT];
+    cecs_sparse_set_key_to_index *key_to_indices[CECS_PREFETCH_BATCH_COUNT];
+    cecs_flatmap_hash hashed_page_indices[CECS_PREFETCH_BATCH_COUNT];
+    size_t hashed_batch_indices[CECS_PREFETCH_BATCH_COUNT];
+    cecs_sparse_set_key_to_index *hashed_key_to_indices[CECS_PREFETCH_BATCH_COUNT];
+    for (size_t batch_start = 0; batch_start < count; batch_start += CECS_PREFETCH_BATCH_COUNT) {
+        const size_t batch_count = min(CECS_PREFETCH_BATCH_COUNT, count - batch_start);
+        size_t hashed_count = 0;
+        for (size_t i = 0; i < batch_count; ++i) {
+            const uint64_t page_index = cecs_paged_sparse_set_page_index(keys[batch_start + i]);
+            if (cecs_paged_sparse_set_page_is_direct(page_index)) {
+                cecs_paged_sparse_set_key_to_index(s, keys[batch_start + i], &key_to_indices[i], &page_keys[i]);
+            } else {
+                page_keys[i] = cecs_paged_sparse_set_page_key(keys[batch_start + i]);
+                hashed_page_indices[hashed_count] = page_index;
+                hashed_batch_indices[hashed_count] = i;
+                ++hashed_count;
+            }
+        }
+
+        if (hashed_count > 0) {
+            cecs_flatmap_get_many(
+                &s->key_to_pagekey_to_index,
+                hashed_page_indices,
+                hashed_count,
+                (void **)hashed_key_to_indices,
+                sizeof(cecs_sparse_set_key_to_index)
+            );
+            for (size_t i = 0; i < hashed_count; ++i) {
+                key_to_indices[hashed_batch_indices[i]] = hashed_key_to_indices[i];
+            }
+        }
+        for (size_t i = 0; i < batch_count; ++i) {
+            if (key_to_indices[i] != NULL && !cecs_paged_sentinel_set_contains_index(key_to_indices[i], page_keys[i])) {
+                key_to_indices[i] = NULL;
+            }
+        }
+
+        found_count += cecs_sparse_set_base_get_batch(
+            &s->base, key_to_indices, page_keys, batch_count, out_elements + batch_start, element_size
+        );
+    }
+    return found_count;
+}
+
 void* cecs_paged_sparse_set_get_unchecked(cecs_paged_sparse_set* s, size_t key, size_t element_size) {
     return CECS_OPTION_GET(cecs_optional_element, cecs_paged_sparse_set_get(s, key, element_size));
 }
@@ -519,7 +871,7 @@ bool cecs_paged_sparse_set_remove(cecs_paged_sparse_set* s, cecs_arena* a, size_
     cecs_sparse_set_key_to_index *key_to_index;
     if (
         !cecs_paged_sparse_set_key_to_index(s, key, &key_to_index, &page_key)
-        || !cecs_sentinel_set_contains_index(key_to_index, page_key)
+        || !cecs_paged_sentinel_set_contains_index(key_to_index, page_key)
         || cecs_paged_sparse_set_is_empty(s)
     ) {
         memset(out_removed_element, 0, element_size);
@@ -13,6 +13,7 @@
 #include "cecs_dynamic_array.h"
 #include "cecs_displaced_set.h"
 #include "cecs_flatmap.h"
+#include "cecs_prefetch.h"
 
 
 #define CECS_DEREFERENCE_EQUALS(type, element_ref, value) (*((type *)(element_ref)) == (type)(value))
@@ -79,7 +80,7 @@ typedef CECS_UNION_STRUCT(
 ) cecs_sparse_set_elements;
 
 typedef cecs_dynamic_array cecs_sparse_set_index_to_key;
-typedef cecs_sentinel_set cecs_sparse_set_key_to_index;
+typedef cecs_paged_sentinel_set cecs_sparse_set_key_to_index;
 
 typedef struct cecs_sparse_set_base {
     cecs_sparse_set_elements values;
@@ -135,9 +136,8 @@ static inline size_t cecs_sparse_set_get_index_expect(const cecs_sparse_set *s,
     return cecs_sparse_set_index_look(cecs_sparse_set_get_index(s, key));
 }
 
-extern inline bool cecs_sentinel_set_contains_index(const cecs_sentinel_set *s, const size_t index);
 static inline bool cecs_sparse_set_contains(const cecs_sparse_set *s, size_t key) {
-    return cecs_sentinel_set_contains_index(&s->key_to_index, key)
+    return cecs_paged_sentinel_set_contains_index(&s->key_to_index, key)
         && cecs_sparse_set_index_check(cecs_sparse_set_get_index(s, key));
 }
 static inline bool cecs_sparse_set_is_empty(const cecs_sparse_set *s) {
@@ -146,10 +146,16 @@ static inline bool cecs_sparse_set_is_empty(const cecs_sparse_set *s) {
 
 void cecs_sparse_set_clear(cecs_sparse_set *s);
 
+cecs_memory_usage cecs_sparse_set_memory_usage(const cecs_sparse_set *s, size_t element_size);
+
 cecs_optional_element cecs_sparse_set_get(cecs_sparse_set *s, size_t key, size_t element_size);
 #define CECS_SPARSE_SET_GET(type, sparse_set_ref, key) \
     cecs_sparse_set_get(sparse_set_ref, key, sizeof(type))
 
+size_t cecs_sparse_set_get_many(cecs_sparse_set *s, const size_t *keys, size_t count, void **out_elements, size_t element_size);
+#define CECS_SPARSE_SET_GET_MANY(type, sparse_set_ref, keys, count, out_elements) \
+    cecs_sparse_set_get_many(sparse_set_ref, keys, count, (void **)(out_elements), sizeof(type))
+
 void *cecs_sparse_set_get_expect(cecs_sparse_set *s, size_t key, size_t element_size);
 #define CECS_SPARSE_SET_GET_UNCHECKED(type, sparse_set_ref, key) \
     ((type *)cecs_sparse_set_get_unchecked(sparse_set_ref, key, sizeof(type)))
@@ -178,6 +184,25 @@ bool cecs_sparse_set_remove(cecs_sparse_set *s, cecs_arena *a, size_t key, void
 #define CECS_SPARSE_SET_REMOVE(type, sparse_set_ref, arena_ref, key, out_removed_element_ref) \
     cecs_sparse_set_remove(sparse_set_ref, arena_ref, key, out_removed_element_ref, sizeof(type))
 
+// NOTE: sort keys order elements ascending, a NULL sort key orders them by their sparse set key
+typedef uint64_t cecs_sparse_set_sort_key(size_t key, const void *element, void *context);
+
+void cecs_sparse_set_sort(cecs_sparse_set *s, cecs_sparse_set_sort_key *sort_key, void *context, size_t element_size);
+#define CECS_SPARSE_SET_SORT(type, sparse_set_ref, sort_key, context) \
+    cecs_sparse_set_sort(sparse_set_ref, sort_key, context, sizeof(type))
+
+// NOTE: insertion sorts past sorted_count until move_budget runs out, returns the new sorted_count; the set is sorted once it equals its count
+size_t cecs_sparse_set_sort_step(
+    cecs_sparse_set *s,
+    size_t sorted_count,
+    size_t move_budget,
+    cecs_sparse_set_sort_key *sort_key,
+    void *context,
+    size_t element_size
+);
+#define CECS_SPARSE_SET_SORT_STEP(type, sparse_set_ref, sorted_count, move_budget, sort_key, context) \
+    cecs_sparse_set_sort_step(sparse_set_ref, sorted_count, move_budget, sort_key, context, sizeof(type))
+
 typedef struct cecs_sparse_set_iterator {
     cecs_sparse_set_base *set;
     size_t index;
@@ -188,6 +213,9 @@ bool cecs_sparse_set_iterator_done(const cecs_sparse_set_iterator *it, size_t va
 static inline size_t cecs_sparse_set_iterator_current_index(const cecs_sparse_set_iterator *it) {
     return it->index;
 }
+static inline size_t cecs_sparse_set_iterator_next(cecs_sparse_set_iterator *it) {
+    return ++it->index;
+}
 size_t cecs_sparse_set_iterator_current_key(const cecs_sparse_set_iterator *it);
 void *cecs_sparse_set_iterator_current_value(const cecs_sparse_set_iterator *it, size_t value_size);
 
@@ -219,8 +247,12 @@ static_assert(
 );
 extern const size_t cecs_paged_sparse_set_page_size;
 
+// NOTE: pages below this index are found through the direct page table, pages above (e.g. relation ids) through hashing
+#define CECS_PAGED_SPARSE_SET_DIRECT_PAGE_COUNT 1024
+
 typedef struct cecs_paged_sparse_set {
     cecs_sparse_set_base base;
+    cecs_dynamic_array page_table;
     cecs_flatmap key_to_pagekey_to_index;
 } cecs_paged_sparse_set;
 
@@ -244,6 +276,8 @@ static inline size_t cecs_paged_sparse_set_count_of_size(const cecs_paged_sparse
 
 
 bool cecs_paged_sparse_set_contains(const cecs_paged_sparse_set *s, size_t key);
+
+cecs_memory_usage cecs_paged_sparse_set_memory_usage(const cecs_paged_sparse_set *s, size_t element_size);
 static inline bool cecs_paged_sparse_set_is_empty(const cecs_paged_sparse_set *s) {
     return cecs_sparse_set_base_is_empty(&s->base);
 }
@@ -252,6 +286,15 @@ cecs_optional_element cecs_paged_sparse_set_get(cecs_paged_sparse_set *s, size_t
 #define CECS_PAGED_SPARSE_SET_GET(type, paged_sparse_set_ref, key) \
     cecs_paged_sparse_set_get(paged_sparse_set_ref, key, sizeof(type))
 
+// NOTE: read only lookup, NULL when the key is absent
+const void *cecs_paged_sparse_set_find(const cecs_paged_sparse_set *s, size_t key, size_t element_size);
+#define CECS_PAGED_SPARSE_SET_FIND(type, paged_sparse_set_ref, key) \
+    ((const type *)cecs_paged_sparse_set_find(paged_sparse_set_ref, key, sizeof(type)))
+
+size_t cecs_paged_sparse_set_get_many(cecs_paged_sparse_set *s, const size_t *keys, size_t count, void **out_elements, size_t element_size);
+#define CECS_PAGED_SPARSE_SET_GET_MANY(type, paged_sparse_set_ref, keys, count, out_elements) \
+    cecs_paged_sparse_set_get_many(paged_sparse_set_ref, keys, count, (void **)(out_elements), sizeof(type))
+
 void *cecs_paged_sparse_set_get_unchecked(cecs_paged_sparse_set *s, size_t key, size_t element_size);
 #define CECS_PAGED_SPARSE_SET_GET_UNCHECKED(type, paged_sparse_set_ref, key) \
     ((type *)cecs_paged_sparse_set_get_unchecked(paged_sparse_set_ref, key, sizeof(type)))
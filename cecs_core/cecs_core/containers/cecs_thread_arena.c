@@ -0,0 +1,324 @@
+#include <stdlib.h>
+#include <stddef.h>
+#include <assert.h>
+#include <string.h>
+
+#include "cecs_thread_arena.h"
+
+// NOTE: block data starts max aligned, so an allocation of the whole block capacity needs no padding
+#define CECS_BLOCK_POOL_HEADER_SIZE \
+    ((sizeof(cecs_block_pool_entry) + _Alignof(max_align_t) - 1) / _Alignof(max_align_t) * _Alignof(max_align_t))
+
+static inline uint64_t cecs_block_pool_head_create(const uint32_t index, const uint32_t generation) {
+    return ((uint64_t)generation << 32) | (uint64_t)index;
+}
+
+static inline uint32_t cecs_block_pool_head_index(const uint64_t head) {
+    return (uint32_t)head;
+}
+
+static inline uint32_t cecs_block_pool_head_generation(const uint64_t head) {
+    return (uint32_t)(head >> 32);
+}
+
+static inline cecs_block_pool_entry *cecs_block_pool_entry_from_block(cecs_linked_block *block) {
+    return (cecs_block_pool_entry *)block;
+}
+
+static cecs_block_pool_entry *cecs_block_pool_get_entry(cecs_block_pool *p, const uint32_t index) {
+    cecs_block_pool_page *page = atomic_load_explicit(&p->pages[index / CECS_BLOCK_POOL_PAGE_BLOCK_COUNT], memory_order_acquire);
+    assert(page != NULL && "fatal error: block pool index has no page");
+    return atomic_load_explicit(&(*page)[index % CECS_BLOCK_POOL_PAGE_BLOCK_COUNT], memory_order_acquire);
+}
+
+void cecs_block_pool_init(cecs_block_pool *p, size_t block_capacity) {
+    assert(block_capacity > 0 && "error: block pool capacity must be greater than 0");
+    atomic_init(&p->free_head, cecs_block_pool_head_create(CECS_BLOCK_POOL_INVALID_BLOCK_INDEX, 0));
+    atomic_init(&p->block_count, 0);
+    p->block_capacity = block_capacity;
+    for (size_t i = 0; i < CECS_BLOCK_POOL_PAGE_COUNT; ++i) {
+        atomic_init(&p->pages[i], NULL);
+    }
+}
+
+static cecs_block_pool_page *cecs_block_pool_get_or_add_page(cecs_block_pool *p, const size_t page_index) {
+    cecs_block_pool_page *page = atomic_load_explicit(&p->pages[page_index], memory_order_acquire);
+    if (page != NULL) {
+        return page;
+    }
+
+    cecs_block_pool_page *new = calloc(1, sizeof(cecs_block_pool_page));
+    assert(new != NULL && "fatal error: could not allocate block pool page");
+    if (atomic_compare_exchange_strong_explicit(&p->pages[page_index], &page, new, memory_order_acq_rel, memory_order_acquire)) {
+        return new;
+    } else {
+        free(new);
+        return page;
+    }
+}
+
+static cecs_linked_block *cecs_block_pool_add_block(cecs_block_pool *p) {
+    const size_t index = atomic_fetch_add_explicit(&p->block_count, 1, memory_order_relaxed);
+    assert(
+        index < (size_t)CECS_BLOCK_POOL_PAGE_COUNT * CECS_BLOCK_POOL_PAGE_BLOCK_COUNT
+        && "error: exceeded maximum block pool block count"
+    );
+
+    cecs_block_pool_entry *new = malloc(CECS_BLOCK_POOL_HEADER_SIZE + p->block_capacity);
+    assert(new != NULL && "fatal error: could not allocate block pool block");
+    new->block = cecs_linked_block_create(
+        cecs_block_create_from_existing(p->block_capacity, 0, (uint8_t *)new + CECS_BLOCK_POOL_HEADER_SIZE),
+        NULL
+    );
+    new->index = (uint32_t)index;
+    atomic_init(&new->next_free_index, CECS_BLOCK_POOL_INVALID_BLOCK_INDEX);
+
+    cecs_block_pool_page *page = cecs_block_pool_get_or_add_page(p, index / CECS_BLOCK_POOL_PAGE_BLOCK_COUNT);
+    atomic_store_explicit(&(*page)[index % CECS_BLOCK_POOL_PAGE_BLOCK_COUNT], new, memory_order_release);
+    return &new->block;
+}
+
+cecs_linked_block *cecs_block_pool_acquire(cecs_block_pool *p) {
+    uint64_t head = atomic_load_explicit(&p->free_head, memory_order_acquire);
+    cecs_block_pool_entry *first;
+    uint64_t next_head;
+    do {
+        const uint32_t index = cecs_block_pool_head_index(head);
+        if (index == CECS_BLOCK_POOL_INVALID_BLOCK_INDEX) {
+            return cecs_block_pool_add_block(p);
+        }
+        first = cecs_block_pool_get_entry(p, index);
+        next_head = cecs_block_pool_head_create(
+            atomic_load_explicit(&first->next_free_index, memory_order_relaxed),
+            cecs_block_pool_head_generation(head) + 1
+        );
+    } while (!atomic_compare_exchange_weak_explicit(&p->free_head, &head, next_head, memory_order_acquire, memory_order_acquire));
+
+    first->block.next = NULL;
+    first->block.b.size = 0;
+    return &first->block;
+}
+
+void cecs_block_pool_release(cecs_block_pool *p, cecs_linked_block *first, cecs_linked_block *last) {
+    assert(first != NULL && last != NULL && "error: released block chain must not be empty");
+    assert(last->next == NULL && "error: released block chain must be terminated");
+
+    for (cecs_linked_block *current = first; current != last; current = current->next) {
+        atomic_store_explicit(
+            &cecs_block_pool_entry_from_block(current)->next_free_index,
+            cecs_block_pool_entry_from_block(current->next)->index,
+            memory_order_relaxed
+        );
+    }
+
+    cecs_block_pool_entry *last_entry = cecs_block_pool_entry_from_block(last);
+    const uint32_t first_index = cecs_block_pool_entry_from_block(first)->index;
+    uint64_t head = atomic_load_explicit(&p->free_head, memory_order_relaxed);
+    do {
+        atomic_store_explicit(&last_entry->next_free_index, cecs_block_pool_head_index(head), memory_order_relaxed);
+    } while (!atomic_compare_exchange_weak_explicit(
+        &p->free_head,
+        &head,
+        cecs_block_pool_head_create(first_index, cecs_block_pool_head_generation(head) + 1),
+        memory_order_release,
+        memory_order_relaxed
+    ));
+}
+
+void cecs_block_pool_free(cecs_block_pool *p) {
+    const size_t block_count = atomic_load(&p->block_count);
+    size_t free_block_count = 0;
+    uint32_t index = cecs_block_pool_head_index(atomic_load(&p->free_head));
+    while (index != CECS_BLOCK_POOL_INVALID_BLOCK_INDEX) {
+        ++free_block_count;
+        index = atomic_load(&cecs_block_pool_get_entry(p, index)->next_free_index);
+    }
+    assert(free_block_count == block_count && "error: all blocks must be released to the pool before freeing it");
+    (void)free_block_count;
+
+    for (size_t i = 0; i < CECS_BLOCK_POOL_PAGE_COUNT; ++i) {
+        cecs_block_pool_page *page = atomic_load(&p->pages[i]);
+        if (page == NULL) {
+            continue;
+        }
+        for (size_t j = 0; j < CECS_BLOCK_POOL_PAGE_BLOCK_COUNT && i * CECS_BLOCK_POOL_PAGE_BLOCK_COUNT + j < block_count; ++j) {
+            free(atomic_load(&(*page)[j]));
+        }
+        free(page);
+        atomic_store(&p->pages[i], NULL);
+    }
+    atomic_store(&p->free_head, cecs_block_pool_head_create(CECS_BLOCK_POOL_INVALID_BLOCK_INDEX, 0));
+    atomic_store(&p->block_count, 0);
+}
+
+
+cecs_thread_arena cecs_thread_arena_create(cecs_block_pool *pool) {
+    return (cecs_thread_arena) {
+        .pool = pool,
+        .first_block = NULL,
+        .arena = cecs_arena_create()
+    };
+}
+
+void *cecs_thread_arena_alloc(cecs_thread_arena *ta, size_t size) {
+    if (size > ta->pool->block_capacity) {
+        return cecs_arena_alloc(&ta->arena, size);
+    }
+
+    if (ta->first_block == NULL || !cecs_block_can_alloc(&ta->first_block->b, size)) {
+        cecs_linked_block *new = cecs_block_pool_acquire(ta->pool);
+        new->next = ta->first_block;
+        ta->first_block = new;
+    }
+    if (!cecs_block_can_alloc(&ta->first_block->b, size)) {
+        return cecs_arena_alloc(&ta->arena, size);
+    }
+    return cecs_block_alloc(&ta->first_block->b, size);
+}
+
+void cecs_thread_arena_reset(cecs_thread_arena *ta) {
+    if (ta->first_block != NULL) {
+        cecs_linked_block *released = ta->first_block->next;
+        if (released != NULL) {
+            cecs_linked_block *last = released;
+            while (last->next != NULL) {
+                last = last->next;
+            }
+            cecs_block_pool_release(ta->pool, released, last);
+        }
+        ta->first_block->next = NULL;
+        ta->first_block->b.size = 0;
+    }
+    cecs_arena_reset(&ta->arena);
+}
+
+void cecs_thread_arena_free(cecs_thread_arena *ta) {
+    if (ta->first_block != NULL) {
+        cecs_linked_block *last = ta->first_block;
+        while (last->next != NULL) {
+            last = last->next;
+        }
+        cecs_block_pool_release(ta->pool, ta->first_block, last);
+        ta->first_block = NULL;
+    }
+    cecs_arena_free(&ta->arena);
+}
+
+cecs_arena_dbg_info cecs_thread_arena_get_dbg_info(const cecs_thread_arena *ta) {
+    cecs_arena_dbg_info info = cecs_arena_get_dbg_info_compare_capacity(&ta->arena);
+    cecs_linked_block *current = ta->first_block;
+    while (current != NULL) {
+        ++info.block_count;
+        info.total_capacity += current->b.capacity;
+        info.total_size += current->b.size;
+
+        if (current->b.capacity > info.largest_block_capacity) {
+            info.largest_block_capacity = current->b.capacity;
+            info.largest_block_size = current->b.size;
+        }
+        if (current->b.capacity < info.smallest_block_capacity) {
+            info.smallest_block_capacity = current->b.capacity;
+            info.smallest_block_size = current->b.size;
+        }
+
+        if (current->b.capacity - current->b.size > info.largest_remaining_capacity) {
+            info.largest_remaining_capacity = current->b.capacity - current->b.size;
+        }
+
+        current = current->next;
+    }
+    return info;
+}
+
+
+static atomic_size_t cecs_thread_arenas_next_epoch = 1;
+
+void cecs_thread_arenas_init(cecs_thread_arenas *registry, size_t block_capacity) {
+    cecs_block_pool_init(&registry->pool, block_capacity);
+    registry->epoch = atomic_fetch_add(&cecs_thread_arenas_next_epoch, 1);
+    atomic_init(&registry->registered_count, 0);
+    for (size_t i = 0; i < CECS_THREAD_ARENA_MAX_COUNT; ++i) {
+        atomic_init(&registry->is_registered[i], false);
+        registry->arenas[i] = cecs_thread_arena_create(&registry->pool);
+    }
+}
+
+cecs_thread_arena_index cecs_thread_arenas_register(cecs_thread_arenas *registry) {
+    for (cecs_thread_arena_index index = 0; index < CECS_THREAD_ARENA_MAX_COUNT; ++index) {
+        bool is_registered = false;
+        if (atomic_compare_exchange_strong(&registry->is_registered[index], &is_registered, true)) {
+            size_t registered_count = atomic_load(&registry->registered_count);
+            while (
+                registered_count <= index
+                && !atomic_compare_exchange_weak(&registry->registered_count, &registered_count, index + 1)
+            ) {}
+            return index;
+        }
+    }
+    assert(false && "error: exceeded maximum thread arena count");
+    return CECS_THREAD_ARENA_MAX_COUNT;
+}
+
+void cecs_thread_arenas_unregister(cecs_thread_arenas *registry, cecs_thread_arena_index index) {
+    assert(
+        index < CECS_THREAD_ARENA_MAX_COUNT && atomic_load(&registry->is_registered[index])
+        && "error: thread arena index was not registered"
+    );
+    cecs_thread_arena_free(&registry->arenas[index]);
+    registry->arenas[index] = cecs_thread_arena_create(&registry->pool);
+    atomic_store(&registry->is_registered[index], false);
+}
+
+cecs_thread_arena *cecs_thread_arenas_get(cecs_thread_arenas *registry, cecs_thread_arena_index index) {
+    assert(
+        index < CECS_THREAD_ARENA_MAX_COUNT && atomic_load_explicit(&registry->is_registered[index], memory_order_relaxed)
+        && "error: thread arena index was not registered"
+    );
+    return &registry->arenas[index];
+}
+
+// NOTE: the epoch tells registries apart when one is freed and another initialized at the same address
+static _Thread_local struct {
+    const cecs_thread_arenas *registry;
+    size_t epoch;
+    cecs_thread_arena_index index;
+} cecs_thread_arenas_local_slot = { .registry = NULL, .epoch = 0, .index = 0 };
+
+static bool cecs_thread_arenas_local_slot_is(const cecs_thread_arenas *registry) {
+    return cecs_thread_arenas_local_slot.registry == registry && cecs_thread_arenas_local_slot.epoch == registry->epoch;
+}
+
+cecs_thread_arena *cecs_thread_arenas_local(cecs_thread_arenas *registry) {
+    assert(registry->epoch != 0 && "error: thread arenas were freed");
+    if (!cecs_thread_arenas_local_slot_is(registry)) {
+        cecs_thread_arenas_local_slot.registry = registry;
+        cecs_thread_arenas_local_slot.epoch = registry->epoch;
+        cecs_thread_arenas_local_slot.index = cecs_thread_arenas_register(registry);
+    }
+    return &registry->arenas[cecs_thread_arenas_local_slot.index];
+}
+
+void cecs_thread_arenas_release_local(cecs_thread_arenas *registry) {
+    if (cecs_thread_arenas_local_slot_is(registry)) {
+        cecs_thread_arenas_unregister(registry, cecs_thread_arenas_local_slot.index);
+        cecs_thread_arenas_local_slot.registry = NULL;
+        cecs_thread_arenas_local_slot.epoch = 0;
+    }
+}
+
+void cecs_thread_arenas_reset(cecs_thread_arenas *registry) {
+    size_t registered_count = atomic_load(&registry->registered_count);
+    for (size_t i = 0; i < registered_count; ++i) {
+        cecs_thread_arena_reset(&registry->arenas[i]);
+    }
+}
+
+void cecs_thread_arenas_free(cecs_thread_arenas *registry) {
+    for (size_t i = 0; i < CECS_THREAD_ARENA_MAX_COUNT; ++i) {
+        cecs_thread_arena_free(&registry->arenas[i]);
+        atomic_store(&registry->is_registered[i], false);
+    }
+    atomic_store(&registry->registered_count, 0);
+    registry->epoch = 0;
+    cecs_block_pool_free(&registry->pool);
+}
@@ -0,0 +1,88 @@
+#ifndef CECS_THREAD_ARENA_H
+#define CECS_THREAD_ARENA_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include "cecs_arena.h"
+
+#define CECS_THREAD_ARENA_MAX_COUNT 64
+
+#define CECS_BLOCK_POOL_PAGE_BLOCK_COUNT 1024
+#define CECS_BLOCK_POOL_PAGE_COUNT 1024
+#define CECS_BLOCK_POOL_INVALID_BLOCK_INDEX UINT32_MAX
+
+typedef struct cecs_block_pool_entry {
+    cecs_linked_block block;
+    uint32_t index;
+    _Atomic uint32_t next_free_index;
+} cecs_block_pool_entry;
+
+typedef _Atomic(cecs_block_pool_entry *) cecs_block_pool_page[CECS_BLOCK_POOL_PAGE_BLOCK_COUNT];
+
+// NOTE: the free list is a lock-free stack of block indices, its head packs the top index with a generation
+// bumped by every push and pop, so a stale head from before an interleaved pop and push fails its compare exchange.
+// Blocks are never freed before the pool, so reading a popped block's next index is always safe
+typedef struct cecs_block_pool {
+    _Atomic uint64_t free_head;
+    atomic_size_t block_count;
+    size_t block_capacity;
+    _Atomic(cecs_block_pool_page *) pages[CECS_BLOCK_POOL_PAGE_COUNT];
+} cecs_block_pool;
+
+void cecs_block_pool_init(cecs_block_pool *p, size_t block_capacity);
+
+cecs_linked_block *cecs_block_pool_acquire(cecs_block_pool *p);
+
+void cecs_block_pool_release(cecs_block_pool *p, cecs_linked_block *first, cecs_linked_block *last);
+
+void cecs_block_pool_free(cecs_block_pool *p);
+
+
+typedef struct cecs_thread_arena {
+    cecs_block_pool *pool;
+    cecs_linked_block *first_block;
+    cecs_arena arena;
+} cecs_thread_arena;
+
+cecs_thread_arena cecs_thread_arena_create(cecs_block_pool *pool);
+
+void *cecs_thread_arena_alloc(cecs_thread_arena *ta, size_t size);
+
+void cecs_thread_arena_reset(cecs_thread_arena *ta);
+
+void cecs_thread_arena_free(cecs_thread_arena *ta);
+
+cecs_arena_dbg_info cecs_thread_arena_get_dbg_info(const cecs_thread_arena *ta);
+
+
+typedef size_t cecs_thread_arena_index;
+
+// NOTE: registered count is the highest registered index plus one, unregistered indices are reused
+typedef struct cecs_thread_arenas {
+    cecs_block_pool pool;
+    size_t epoch;
+    atomic_size_t registered_count;
+    atomic_bool is_registered[CECS_THREAD_ARENA_MAX_COUNT];
+    cecs_thread_arena arenas[CECS_THREAD_ARENA_MAX_COUNT];
+} cecs_thread_arenas;
+
+void cecs_thread_arenas_init(cecs_thread_arenas *registry, size_t block_capacity);
+
+cecs_thread_arena_index cecs_thread_arenas_register(cecs_thread_arenas *registry);
+
+// NOTE: returns the arena's blocks to the pool, the index may be handed out again
+void cecs_thread_arenas_unregister(cecs_thread_arenas *registry, cecs_thread_arena_index index);
+
+cecs_thread_arena *cecs_thread_arenas_get(cecs_thread_arenas *registry, cecs_thread_arena_index index);
+
+cecs_thread_arena *cecs_thread_arenas_local(cecs_thread_arenas *registry);
+
+// NOTE: unregisters the calling thread's arena, threads call it before exiting
+void cecs_thread_arenas_release_local(cecs_thread_arenas *registry);
+
+void cecs_thread_arenas_reset(cecs_thread_arenas *registry);
+
+void cecs_thread_arenas_free(cecs_thread_arenas *registry);
+
+#endif
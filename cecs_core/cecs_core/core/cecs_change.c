@@ -0,0 +1,193 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "cecs_change.h"
+
+cecs_world_changes cecs_world_changes_create(void) {
+    return (cecs_world_changes) {
+        .changes_arena = cecs_arena_create(),
+        .tick = CECS_CHANGE_TICK_FIRST,
+        .added_ticks = cecs_dynamic_array_create(),
+        .added_indices = cecs_dynamic_array_create(),
+        .entity_removals = cecs_dynamic_array_create(),
+        .component_changes = cecs_dynamic_array_create(),
+        .component_to_changes_index = cecs_flatmap_create()
+    };
+}
+
+void cecs_world_changes_free(cecs_world_changes *wc) {
+    cecs_arena_free(&wc->changes_arena);
+    wc->tick = CECS_CHANGE_TICK_NONE;
+    wc->added_ticks = (cecs_dynamic_array){ 0 };
+    wc->added_indices = (cecs_dynamic_array){ 0 };
+    wc->entity_removals = (cecs_dynamic_array){ 0 };
+    wc->component_changes = (cecs_dynamic_array){ 0 };
+    wc->component_to_changes_index = (cecs_flatmap){ 0 };
+}
+
+cecs_memory_usage cecs_world_changes_memory_usage(const cecs_world_changes *wc) {
+    cecs_memory_usage usage = cecs_memory_usage_add(
+        cecs_memory_usage_add(
+            cecs_memory_usage_add(
+                cecs_dynamic_array_memory_usage(&wc->added_ticks),
+                cecs_dynamic_array_memory_usage(&wc->added_indices)
+            ),
+            cecs_dynamic_array_memory_usage(&wc->entity_removals)
+        ),
+        cecs_memory_usage_add(
+            cecs_dynamic_array_memory_usage(&wc->component_changes),
+            cecs_flatmap_memory_usage(&wc->component_to_changes_index, sizeof(size_t))
+        )
+    );
+    for (size_t i = 0; i < cecs_world_changes_component_count(wc); ++i) {
+        const cecs_component_changes *changes = CECS_DYNAMIC_ARRAY_GET(cecs_component_changes, &wc->component_changes, i);
+        usage = cecs_memory_usage_add(
+            usage,
+            cecs_memory_usage_add(
+                cecs_memory_usage_add(
+                    cecs_dynamic_array_memory_usage(&changes->changed_ticks),
+                    cecs_dynamic_array_memory_usage(&changes->changed_indices)
+                ),
+                cecs_dynamic_array_memory_usage(&changes->removals)
+            )
+        );
+    }
+    return usage;
+}
+
+bool cecs_world_changes_get(const cecs_world_changes *wc, const cecs_component_id component_id, cecs_component_changes **out_changes) {
+    size_t *changes_index;
+    if (cecs_flatmap_get(&wc->component_to_changes_index, (cecs_flatmap_hash)component_id, (void **)&changes_index, sizeof(size_t))) {
+        *out_changes = CECS_DYNAMIC_ARRAY_GET_MUT(cecs_component_changes, &wc->component_changes, *changes_index);
+        return true;
+    } else {
+        *out_changes = NULL;
+        return false;
+    }
+}
+
+cecs_component_changes *cecs_world_changes_track_component(cecs_world_changes *wc, const cecs_component_id component_id) {
+    cecs_component_changes *changes;
+    if (cecs_world_changes_get(wc, component_id, &changes)) {
+        return changes;
+    }
+
+    const size_t changes_index = cecs_world_changes_component_count(wc);
+    cecs_flatmap_add(
+        &wc->component_to_changes_index,
+        &wc->changes_arena,
+        (cecs_flatmap_hash)component_id,
+        &changes_index,
+        sizeof(size_t),
+        &(void *){ NULL }
+    );
+    return CECS_DYNAMIC_ARRAY_ADD(cecs_component_changes, &wc->component_changes, &wc->changes_arena, (&(cecs_component_changes){
+        .component_id = component_id,
+        .changed_ticks = cecs_dynamic_array_create(),
+        .changed_indices = cecs_dynamic_array_create(),
+        .removals = cecs_dynamic_array_create()
+    }));
+}
+
+// NOTE: ticks of indices never stamped before are zeroed, reading them back gives CECS_CHANGE_TICK_NONE
+static void cecs_change_ticks_stamp_range(
+    cecs_dynamic_array *ticks,
+    cecs_dynamic_array *stamped_indices,
+    cecs_arena *a,
+    const cecs_entity_id_range index_range,
+    const cecs_change_tick tick
+) {
+    const size_t count = CECS_DYNAMIC_ARRAY_COUNT(cecs_change_tick, ticks);
+    if ((size_t)index_range.end > count) {
+        memset(
+            CECS_DYNAMIC_ARRAY_APPEND_EMPTY(cecs_change_tick, ticks, a, (size_t)index_range.end - count),
+            0,
+            ((size_t)index_range.end - count) * sizeof(cecs_change_tick)
+        );
+    }
+
+    cecs_change_tick *stamped = CECS_DYNAMIC_ARRAY_GET_MUT(cecs_change_tick, ticks, (size_t)index_range.start);
+    for (cecs_ssize_t i = 0; i < cecs_exclusive_range_length(index_range); ++i) {
+        if (stamped[i] != tick) {
+            stamped[i] = tick;
+            CECS_DYNAMIC_ARRAY_ADD(cecs_change_record, stamped_indices, a, (&(cecs_change_record){
+                .entity = (cecs_entity_id)(index_range.start + i),
+                .tick = tick
+            }));
+        }
+    }
+}
+
+void cecs_world_changes_entity_range_added(cecs_world_changes *wc, const cecs_entity_id_range index_range) {
+    if (!cecs_world_changes_is_tracking(wc) || cecs_exclusive_range_is_empty(index_range)) {
+        return;
+    }
+    cecs_change_ticks_stamp_range(&wc->added_ticks, &wc->added_indices, &wc->changes_arena, index_range, wc->tick);
+}
+
+void cecs_world_changes_entity_removed(cecs_world_changes *wc, const cecs_entity_id entity) {
+    if (!cecs_world_changes_is_tracking(wc)) {
+        return;
+    }
+    CECS_DYNAMIC_ARRAY_ADD(cecs_change_record, &wc->entity_removals, &wc->changes_arena, (&(cecs_change_record){
+        .entity = entity,
+        .tick = wc->tick
+    }));
+}
+
+void cecs_world_changes_component_range_changed(
+    cecs_world_changes *wc,
+    const cecs_component_id component_id,
+    const cecs_entity_id_range index_range
+) {
+    cecs_component_changes *changes;
+    if (
+        !cecs_world_changes_is_tracking(wc)
+        || cecs_exclusive_range_is_empty(index_range)
+        || !cecs_world_changes_get(wc, component_id, &changes)
+    ) {
+        return;
+    }
+    cecs_change_ticks_stamp_range(&changes->changed_ticks, &changes->changed_indices, &wc->changes_arena, index_range, wc->tick);
+}
+
+void cecs_world_changes_component_removed(cecs_world_changes *wc, const cecs_component_id component_id, const cecs_entity_id entity) {
+    cecs_component_changes *changes;
+    if (!cecs_world_changes_is_tracking(wc) || !cecs_world_changes_get(wc, component_id, &changes)) {
+        return;
+    }
+    CECS_DYNAMIC_ARRAY_ADD(cecs_change_record, &changes->removals, &wc->changes_arena, (&(cecs_change_record){
+        .entity = entity,
+        .tick = wc->tick
+    }));
+}
+
+cecs_change_tick cecs_world_changes_advance_tick(cecs_world_changes *wc) {
+    assert(wc->tick < UINT32_MAX && "error: change tick overflow");
+    return ++wc->tick;
+}
+
+static size_t cecs_change_records_trim(cecs_dynamic_array *records, cecs_arena *a, const cecs_change_tick tick) {
+    size_t trimmed_count = 0;
+    while (
+        trimmed_count < CECS_DYNAMIC_ARRAY_COUNT(cecs_change_record, records)
+        && CECS_DYNAMIC_ARRAY_GET(cecs_change_record, records, trimmed_count)->tick <= tick
+    ) {
+        ++trimmed_count;
+    }
+    if (trimmed_count > 0) {
+        CECS_DYNAMIC_ARRAY_REMOVE_RANGE(cecs_change_record, records, a, 0, trimmed_count);
+    }
+    return trimmed_count;
+}
+
+size_t cecs_world_changes_trim(cecs_world_changes *wc, const cecs_change_tick tick) {
+    size_t trimmed_count = cecs_change_records_trim(&wc->entity_removals, &wc->changes_arena, tick);
+    cecs_change_records_trim(&wc->added_indices, &wc->changes_arena, tick);
+    for (size_t i = 0; i < cecs_world_changes_component_count(wc); ++i) {
+        cecs_component_changes *changes = cecs_world_changes_at(wc, i);
+        trimmed_count += cecs_change_records_trim(&changes->removals, &wc->changes_arena, tick);
+        cecs_change_records_trim(&changes->changed_indices, &wc->changes_arena, tick);
+    }
+    return trimmed_count;
+}
@@ -0,0 +1,102 @@
+#ifndef CECS_CHANGE_H
+#define CECS_CHANGE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <assert.h>
+#include "../containers/cecs_arena.h"
+#include "../containers/cecs_flatmap.h"
+#include "../containers/cecs_dynamic_array.h"
+#include "component/entity/cecs_entity.h"
+#include "component/cecs_component.h"
+
+// NOTE: ticks start at 1, a tick of 0 marks entities and components unchanged since tracking began
+typedef uint32_t cecs_change_tick;
+#define CECS_CHANGE_TICK_NONE ((cecs_change_tick)0)
+#define CECS_CHANGE_TICK_FIRST ((cecs_change_tick)1)
+
+typedef struct cecs_change_record {
+    cecs_entity_id entity;
+    cecs_change_tick tick;
+} cecs_change_record;
+
+// NOTE: changed ticks are indexed by entity index, removals are recorded in tick order.
+// Indices stamped for the first time in a tick are recorded in tick order as well, as records holding the index,
+// so deltas only walk what changed since their tick; a record is stale once its index was stamped again
+typedef struct cecs_component_changes {
+    cecs_component_id component_id;
+    cecs_dynamic_array changed_ticks;
+    cecs_dynamic_array changed_indices;
+    cecs_dynamic_array removals;
+} cecs_component_changes;
+
+typedef struct cecs_world_changes {
+    cecs_arena changes_arena;
+    cecs_change_tick tick;
+    cecs_dynamic_array added_ticks;
+    cecs_dynamic_array added_indices;
+    cecs_dynamic_array entity_removals;
+    cecs_dynamic_array component_changes;
+    cecs_flatmap component_to_changes_index;
+} cecs_world_changes;
+
+cecs_world_changes cecs_world_changes_create(void);
+
+void cecs_world_changes_free(cecs_world_changes *wc);
+
+cecs_memory_usage cecs_world_changes_memory_usage(const cecs_world_changes *wc);
+
+static inline size_t cecs_world_changes_component_count(const cecs_world_changes *wc) {
+    return CECS_DYNAMIC_ARRAY_COUNT(cecs_component_changes, &wc->component_changes);
+}
+static inline cecs_component_changes *cecs_world_changes_at(cecs_world_changes *wc, const size_t index) {
+    return CECS_DYNAMIC_ARRAY_GET_MUT(cecs_component_changes, &wc->component_changes, index);
+}
+
+// NOTE: entities are only tracked while some component is, untracked worlds pay a single count check per change
+static inline bool cecs_world_changes_is_tracking(const cecs_world_changes *wc) {
+    return cecs_world_changes_component_count(wc) > 0;
+}
+
+bool cecs_world_changes_get(const cecs_world_changes *wc, const cecs_component_id component_id, cecs_component_changes **out_changes);
+
+cecs_component_changes *cecs_world_changes_track_component(cecs_world_changes *wc, const cecs_component_id component_id);
+
+static inline cecs_change_tick cecs_component_changes_get_tick(const cecs_component_changes *changes, const cecs_entity_id index) {
+    return index < CECS_DYNAMIC_ARRAY_COUNT(cecs_change_tick, &changes->changed_ticks)
+        ? *CECS_DYNAMIC_ARRAY_GET(cecs_change_tick, &changes->changed_ticks, index)
+        : CECS_CHANGE_TICK_NONE;
+}
+
+static inline cecs_change_tick cecs_world_changes_get_added_tick(const cecs_world_changes *wc, const cecs_entity_id index) {
+    return index < CECS_DYNAMIC_ARRAY_COUNT(cecs_change_tick, &wc->added_ticks)
+        ? *CECS_DYNAMIC_ARRAY_GET(cecs_change_tick, &wc->added_ticks, index)
+        : CECS_CHANGE_TICK_NONE;
+}
+
+void cecs_world_changes_entity_range_added(cecs_world_changes *wc, const cecs_entity_id_range index_range);
+void cecs_world_changes_entity_removed(cecs_world_changes *wc, const cecs_entity_id entity);
+
+void cecs_world_changes_component_range_changed(
+    cecs_world_changes *wc,
+    const cecs_component_id component_id,
+    const cecs_entity_id_range index_range
+);
+void cecs_world_changes_component_removed(cecs_world_changes *wc, const cecs_component_id component_id, const cecs_entity_id entity);
+
+static inline void cecs_world_changes_entity_added(cecs_world_changes *wc, const cecs_entity_id entity) {
+    cecs_world_changes_entity_range_added(wc, cecs_exclusive_range_singleton((cecs_ssize_t)cecs_entity_id_index(entity)));
+}
+static inline void cecs_world_changes_component_changed(cecs_world_changes *wc, const cecs_component_id component_id, const cecs_entity_id entity) {
+    cecs_world_changes_component_range_changed(
+        wc, component_id, cecs_exclusive_range_singleton((cecs_ssize_t)cecs_entity_id_index(entity))
+    );
+}
+
+cecs_change_tick cecs_world_changes_advance_tick(cecs_world_changes *wc);
+
+// NOTE: drops removals and changed or added index records up to the tick, once every consumer has seen them;
+// changed and added ticks are overwritten in place
+size_t cecs_world_changes_trim(cecs_world_changes *wc, const cecs_change_tick tick);
+
+#endif
@@ -0,0 +1,272 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "cecs_event.h"
+
+static const cecs_event_kind cecs_event_kinds[] = {
+    cecs_event_kind_add,
+    cecs_event_kind_remove,
+    cecs_event_kind_mutate
+};
+
+static inline cecs_event_queue cecs_event_queue_create(void) {
+    return (cecs_event_queue) {
+        .pending = cecs_dynamic_array_create(),
+        .dispatching = cecs_dynamic_array_create()
+    };
+}
+
+static inline cecs_memory_usage cecs_event_queue_memory_usage(const cecs_event_queue *queue) {
+    return cecs_memory_usage_add(
+        cecs_dynamic_array_memory_usage(&queue->pending),
+        cecs_dynamic_array_memory_usage(&queue->dispatching)
+    );
+}
+
+cecs_world_events cecs_world_events_create(void) {
+    return (cecs_world_events) {
+        .events_arena = cecs_arena_create(),
+        .component_events = cecs_dynamic_array_create(),
+        .component_to_events_index = cecs_flatmap_create(),
+        .observer_count = 0,
+        .event_channel_ids = cecs_dynamic_array_create(),
+        .remove_hooks = cecs_dynamic_array_create()
+    };
+}
+
+void cecs_world_events_free(cecs_world_events *we) {
+    cecs_arena_free(&we->events_arena);
+    we->component_events = (cecs_dynamic_array){ 0 };
+    we->component_to_events_index = (cecs_flatmap){ 0 };
+    we->observer_count = 0;
+    we->event_channel_ids = (cecs_dynamic_array){ 0 };
+    we->remove_hooks = (cecs_dynamic_array){ 0 };
+}
+
+cecs_memory_usage cecs_world_events_memory_usage(const cecs_world_events *we) {
+    cecs_memory_usage usage = cecs_memory_usage_add(
+        cecs_memory_usage_add(
+            cecs_dynamic_array_memory_usage(&we->component_events),
+            cecs_flatmap_memory_usage(&we->component_to_events_index, sizeof(size_t))
+        ),
+        cecs_memory_usage_add(
+            cecs_dynamic_array_memory_usage(&we->event_channel_ids),
+            cecs_dynamic_array_memory_usage(&we->remove_hooks)
+        )
+    );
+    for (size_t i = 0; i < cecs_world_events_component_count(we); ++i) {
+        const cecs_component_events *events = CECS_DYNAMIC_ARRAY_GET(cecs_component_events, &we->component_events, i);
+        usage = cecs_memory_usage_add(
+            usage,
+            cecs_memory_usage_add(
+                cecs_memory_usage_add(
+                    cecs_event_queue_memory_usage(&events->added),
+                    cecs_event_queue_memory_usage(&events->removed)
+                ),
+                cecs_memory_usage_add(
+                    cecs_event_queue_memory_usage(&events->mutated),
+                    cecs_dynamic_array_memory_usage(&events->observers)
+                )
+            )
+        );
+    }
+    return usage;
+}
+
+bool cecs_world_events_get(const cecs_world_events *we, const cecs_component_id component_id, cecs_component_events **out_events) {
+    size_t *events_index;
+    if (cecs_flatmap_get(&we->component_to_events_index, (cecs_flatmap_hash)component_id, (void **)&events_index, sizeof(size_t))) {
+        *out_events = CECS_DYNAMIC_ARRAY_GET_MUT(cecs_component_events, &we->component_events, *events_index);
+        return true;
+    } else {
+        *out_events = NULL;
+        return false;
+    }
+}
+
+static cecs_component_events *cecs_world_events_get_or_add(cecs_world_events *we, const cecs_component_id component_id) {
+    cecs_component_events *events;
+    if (cecs_world_events_get(we, component_id, &events)) {
+        return events;
+    }
+
+    const size_t events_index = cecs_world_events_component_count(we);
+    cecs_flatmap_add(
+        &we->component_to_events_index,
+        &we->events_arena,
+        (cecs_flatmap_hash)component_id,
+        &events_index,
+        sizeof(size_t),
+        &(void *){ NULL }
+    );
+    return CECS_DYNAMIC_ARRAY_ADD(cecs_component_events, &we->component_events, &we->events_arena, (&(cecs_component_events){
+        .component_id = component_id,
+        .observed_kinds = cecs_event_kind_none,
+        .added = cecs_event_queue_create(),
+        .removed = cecs_event_queue_create(),
+        .mutated = cecs_event_queue_create(),
+        .observers = cecs_dynamic_array_create()
+    }));
+}
+
+cecs_event_queue *cecs_component_events_queue(cecs_component_events *events, const cecs_event_kind kind) {
+    switch (kind) {
+    case cecs_event_kind_add:
+        return &events->added;
+    case cecs_event_kind_remove:
+        return &events->removed;
+    case cecs_event_kind_mutate:
+        return &events->mutated;
+    default:
+        assert(false && "unreachable: event queues exist for single event kinds only");
+        exit(EXIT_FAILURE);
+    }
+}
+
+static cecs_event_kind_flags cecs_component_events_observed_kinds(const cecs_component_events *events) {
+    cecs_event_kind_flags kinds = cecs_event_kind_none;
+    for (size_t i = 0; i < CECS_DYNAMIC_ARRAY_COUNT(cecs_observer, &events->observers); ++i) {
+        kinds |= CECS_DYNAMIC_ARRAY_GET(cecs_observer, &events->observers, i)->kinds;
+    }
+    return kinds;
+}
+
+cecs_observer *cecs_world_events_add_observer(cecs_world_events *we, const cecs_component_id component_id, const cecs_observer observer) {
+    assert(observer.predicate != NULL && "error: observer must have a predicate");
+    assert((observer.kinds & cecs_event_kind_all) != cecs_event_kind_none && "error: observer must observe at least one event kind");
+
+    cecs_component_events *events = cecs_world_events_get_or_add(we, component_id);
+    events->observed_kinds |= observer.kinds;
+    ++we->observer_count;
+    return CECS_DYNAMIC_ARRAY_ADD(cecs_observer, &events->observers, &we->events_arena, &observer);
+}
+
+size_t cecs_world_events_remove_observers(cecs_world_events *we, const cecs_component_id component_id, cecs_observer_predicate *const predicate) {
+    cecs_component_events *events;
+    if (!cecs_world_events_get(we, component_id, &events)) {
+        return 0;
+    }
+
+    size_t removed_count = 0;
+    for (size_t i = CECS_DYNAMIC_ARRAY_COUNT(cecs_observer, &events->observers); i > 0; --i) {
+        if (CECS_DYNAMIC_ARRAY_GET(cecs_observer, &events->observers, i - 1)->predicate == predicate) {
+            CECS_DYNAMIC_ARRAY_REMOVE(cecs_observer, &events->observers, &we->events_arena, i - 1);
+            ++removed_count;
+        }
+    }
+    we->observer_count -= removed_count;
+
+    // NOTE: kinds nobody observes anymore stop queueing, events already queued for them are dropped
+    events->observed_kinds = cecs_component_events_observed_kinds(events);
+    for (size_t i = 0; i < sizeof(cecs_event_kinds) / sizeof(cecs_event_kinds[0]); ++i) {
+        if (!(events->observed_kinds & cecs_event_kinds[i])) {
+            cecs_dynamic_array_clear(&cecs_component_events_queue(events, cecs_event_kinds[i])->pending);
+        }
+    }
+    return removed_count;
+}
+
+void cecs_world_events_set_remove_hook(cecs_world_events *we, const cecs_component_id component_id, cecs_remove_hook *const hook) {
+    for (size_t i = 0; i < cecs_world_events_remove_hook_count(we); ++i) {
+        cecs_component_remove_hook *component_hook = CECS_DYNAMIC_ARRAY_GET_MUT(cecs_component_remove_hook, &we->remove_hooks, i);
+        if (component_hook->component_id == component_id) {
+            if (hook == NULL) {
+                CECS_DYNAMIC_ARRAY_REMOVE(cecs_component_remove_hook, &we->remove_hooks, &we->events_arena, i);
+            } else {
+                component_hook->hook = hook;
+            }
+            return;
+        }
+    }
+
+    if (hook != NULL) {
+        CECS_DYNAMIC_ARRAY_ADD(cecs_component_remove_hook, &we->remove_hooks, &we->events_arena, (&(cecs_component_remove_hook){
+            .component_id = component_id,
+            .hook = hook
+        }));
+    }
+}
+
+void cecs_world_events_push(cecs_world_events *we, const cecs_component_id component_id, const cecs_event_kind kind, const cecs_entity_id entity) {
+    cecs_world_events_push_range(we, component_id, kind, &entity, 1);
+}
+
+void cecs_world_events_push_range(
+    cecs_world_events *we,
+    const cecs_component_id component_id,
+    const cecs_event_kind kind,
+    const cecs_entity_id entities[],
+    const size_t entity_count
+) {
+    cecs_component_events *events;
+    if (
+        entity_count == 0
+        || we->observer_count == 0
+        || !cecs_world_events_get(we, component_id, &events)
+        || !(events->observed_kinds & kind)
+    ) {
+        return;
+    }
+    CECS_DYNAMIC_ARRAY_ADD_RANGE(
+        cecs_entity_id, &cecs_component_events_queue(events, kind)->pending, &we->events_arena, entities, entity_count
+    );
+}
+
+size_t cecs_world_events_pending_count(const cecs_world_events *we) {
+    size_t count = 0;
+    for (size_t i = 0; i < cecs_world_events_component_count(we); ++i) {
+        const cecs_component_events *events = CECS_DYNAMIC_ARRAY_GET(cecs_component_events, &we->component_events, i);
+        count += CECS_DYNAMIC_ARRAY_COUNT(cecs_entity_id, &events->added.pending)
+            + CECS_DYNAMIC_ARRAY_COUNT(cecs_entity_id, &events->removed.pending)
+            + CECS_DYNAMIC_ARRAY_COUNT(cecs_entity_id, &events->mutated.pending);
+    }
+    return count;
+}
+
+bool cecs_world_events_add_event_channel_id(cecs_world_events *we, const cecs_resource_id channel_id) {
+    for (size_t i = 0; i < cecs_world_events_event_channel_count(we); ++i) {
+        if (cecs_world_events_event_channel_id(we, i) == channel_id) {
+            return false;
+        }
+    }
+    CECS_DYNAMIC_ARRAY_ADD(cecs_resource_id, &we->event_channel_ids, &we->events_arena, &channel_id);
+    return true;
+}
+
+size_t cecs_world_events_dispatch(cecs_world_events *we, cecs_world *w) {
+    // NOTE: every queue is swapped before any observer runs, events raised while dispatching wait for the next dispatch
+    const size_t component_count = cecs_world_events_component_count(we);
+    for (size_t i = 0; i < component_count; ++i) {
+        for (size_t k = 0; k < sizeof(cecs_event_kinds) / sizeof(cecs_event_kinds[0]); ++k) {
+            cecs_event_queue *queue = cecs_component_events_queue(cecs_world_events_at(we, i), cecs_event_kinds[k]);
+            const cecs_dynamic_array batch = queue->pending;
+            queue->pending = queue->dispatching;
+            queue->dispatching = batch;
+            cecs_dynamic_array_clear(&queue->pending);
+        }
+    }
+
+    size_t dispatched_count = 0;
+    for (size_t i = 0; i < component_count; ++i) {
+        for (size_t k = 0; k < sizeof(cecs_event_kinds) / sizeof(cecs_event_kinds[0]); ++k) {
+            const cecs_event_kind kind = cecs_event_kinds[k];
+            const cecs_dynamic_array batch = cecs_component_events_queue(cecs_world_events_at(we, i), kind)->dispatching;
+            const size_t entity_count = CECS_DYNAMIC_ARRAY_COUNT(cecs_entity_id, &batch);
+            if (entity_count == 0) {
+                continue;
+            }
+
+            // NOTE: observers may add component events or observers, the events are looked up again after every call
+            const cecs_entity_id *entities = CECS_DYNAMIC_ARRAY_GET(cecs_entity_id, &batch, 0);
+            for (size_t j = 0; j < CECS_DYNAMIC_ARRAY_COUNT(cecs_observer, &cecs_world_events_at(we, i)->observers); ++j) {
+                const cecs_component_events *events = cecs_world_events_at(we, i);
+                const cecs_observer observer = *CECS_DYNAMIC_ARRAY_GET(cecs_observer, &events->observers, j);
+                if (observer.kinds & kind) {
+                    observer.predicate(entities, entity_count, events->component_id, kind, w, observer.user_data);
+                }
+            }
+            dispatched_count += entity_count;
+        }
+    }
+    return dispatched_count;
+}
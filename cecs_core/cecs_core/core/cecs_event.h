@@ -0,0 +1,135 @@
+#ifndef CECS_EVENT_H
+#define CECS_EVENT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <assert.h>
+#include "../containers/cecs_arena.h"
+#include "../containers/cecs_flatmap.h"
+#include "../containers/cecs_dynamic_array.h"
+#include "component/entity/cecs_entity.h"
+#include "component/cecs_component.h"
+#include "resource/cecs_resource.h"
+
+typedef enum cecs_event_kind {
+    cecs_event_kind_none = 0,
+    cecs_event_kind_add = 1 << 0,
+    cecs_event_kind_remove = 1 << 1,
+    cecs_event_kind_mutate = 1 << 2,
+    cecs_event_kind_all = cecs_event_kind_add | cecs_event_kind_remove | cecs_event_kind_mutate
+} cecs_event_kind;
+typedef uint8_t cecs_event_kind_flags;
+
+typedef struct cecs_world cecs_world;
+// NOTE: called once per dispatch with every entity queued for the component and kind since the previous dispatch,
+// entities may repeat and may no longer be alive
+typedef void cecs_observer_predicate(
+    const cecs_entity_id entities[],
+    size_t entity_count,
+    cecs_component_id component_id,
+    cecs_event_kind kind,
+    cecs_world *world,
+    void *user_data
+);
+
+typedef struct cecs_observer {
+    cecs_observer_predicate *predicate;
+    void *user_data;
+    cecs_event_kind_flags kinds;
+} cecs_observer;
+
+// NOTE: remove hooks run right away while the removed entity still has the component, they are never queued like observers
+typedef void cecs_remove_hook(cecs_world *world, cecs_entity_id entity);
+
+typedef struct cecs_component_remove_hook {
+    cecs_component_id component_id;
+    cecs_remove_hook *hook;
+} cecs_component_remove_hook;
+
+// NOTE: events are queued into pending, dispatch swaps the buffers so events raised by observers wait for the next dispatch
+typedef struct cecs_event_queue {
+    cecs_dynamic_array pending;
+    cecs_dynamic_array dispatching;
+} cecs_event_queue;
+
+typedef struct cecs_component_events {
+    cecs_component_id component_id;
+    cecs_event_kind_flags observed_kinds;
+    cecs_event_queue added;
+    cecs_event_queue removed;
+    cecs_event_queue mutated;
+    cecs_dynamic_array observers;
+} cecs_component_events;
+
+typedef struct cecs_world_events {
+    cecs_arena events_arena;
+    cecs_dynamic_array component_events;
+    cecs_flatmap component_to_events_index;
+    size_t observer_count;
+    cecs_dynamic_array event_channel_ids;
+    cecs_dynamic_array remove_hooks;
+} cecs_world_events;
+
+cecs_world_events cecs_world_events_create(void);
+
+void cecs_world_events_free(cecs_world_events *we);
+
+cecs_memory_usage cecs_world_events_memory_usage(const cecs_world_events *we);
+
+static inline size_t cecs_world_events_component_count(const cecs_world_events *we) {
+    return CECS_DYNAMIC_ARRAY_COUNT(cecs_component_events, &we->component_events);
+}
+static inline cecs_component_events *cecs_world_events_at(cecs_world_events *we, const size_t index) {
+    return CECS_DYNAMIC_ARRAY_GET_MUT(cecs_component_events, &we->component_events, index);
+}
+
+bool cecs_world_events_get(const cecs_world_events *we, const cecs_component_id component_id, cecs_component_events **out_events);
+
+static inline bool cecs_world_events_is_observed(
+    const cecs_world_events *we,
+    const cecs_component_id component_id,
+    const cecs_event_kind_flags kinds
+) {
+    cecs_component_events *events;
+    return we->observer_count > 0
+        && cecs_world_events_get(we, component_id, &events)
+        && (events->observed_kinds & kinds);
+}
+
+cecs_observer *cecs_world_events_add_observer(cecs_world_events *we, const cecs_component_id component_id, const cecs_observer observer);
+size_t cecs_world_events_remove_observers(cecs_world_events *we, const cecs_component_id component_id, cecs_observer_predicate *const predicate);
+
+// NOTE: a component has at most one remove hook, setting NULL removes it
+void cecs_world_events_set_remove_hook(cecs_world_events *we, const cecs_component_id component_id, cecs_remove_hook *const hook);
+static inline size_t cecs_world_events_remove_hook_count(const cecs_world_events *we) {
+    return CECS_DYNAMIC_ARRAY_COUNT(cecs_component_remove_hook, &we->remove_hooks);
+}
+static inline const cecs_component_remove_hook *cecs_world_events_remove_hook_at(const cecs_world_events *we, const size_t index) {
+    return CECS_DYNAMIC_ARRAY_GET(cecs_component_remove_hook, &we->remove_hooks, index);
+}
+
+cecs_event_queue *cecs_component_events_queue(cecs_component_events *events, const cecs_event_kind kind);
+
+void cecs_world_events_push(cecs_world_events *we, const cecs_component_id component_id, const cecs_event_kind kind, const cecs_entity_id entity);
+void cecs_world_events_push_range(
+    cecs_world_events *we,
+    const cecs_component_id component_id,
+    const cecs_event_kind kind,
+    const cecs_entity_id entities[],
+    const size_t entity_count
+);
+
+size_t cecs_world_events_pending_count(const cecs_world_events *we);
+
+bool cecs_world_events_add_event_channel_id(cecs_world_events *we, const cecs_resource_id channel_id);
+static inline size_t cecs_world_events_event_channel_count(const cecs_world_events *we) {
+    return CECS_DYNAMIC_ARRAY_COUNT(cecs_resource_id, &we->event_channel_ids);
+}
+static inline cecs_resource_id cecs_world_events_event_channel_id(const cecs_world_events *we, const size_t index) {
+    return *CECS_DYNAMIC_ARRAY_GET(cecs_resource_id, &we->event_channel_ids, index);
+}
+
+// NOTE: returns the number of dispatched events, observers may raise events and add observers while being dispatched
+size_t cecs_world_events_dispatch(cecs_world_events *we, cecs_world *w);
+
+#endif
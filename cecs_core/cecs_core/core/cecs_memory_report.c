@@ -0,0 +1,110 @@
+#include <assert.h>
+
+#include "cecs_memory_report.h"
+
+static cecs_world_arenas_dbg_info cecs_world_arenas_get_dbg_info(const cecs_world *w) {
+    return (cecs_world_arenas_dbg_info) {
+        .entity_ids_arena = cecs_arena_get_dbg_info_compare_capacity(&w->entities.entity_ids_arena),
+        .storages_arena = cecs_arena_get_dbg_info_compare_capacity(&w->components.storages_arena),
+        .components_arena = cecs_arena_get_dbg_info_compare_capacity(&w->components.components_arena),
+        .associations_arena = cecs_arena_get_dbg_info_compare_capacity(&w->relations.associations_arena),
+        .resources_arena = cecs_arena_get_dbg_info_compare_capacity(&w->resources.resources_arena),
+        .events_arena = cecs_arena_get_dbg_info_compare_capacity(&w->events.events_arena),
+        .changes_arena = cecs_arena_get_dbg_info_compare_capacity(&w->changes.changes_arena)
+    };
+}
+
+cecs_world_memory_report cecs_world_get_memory_report(const cecs_world *w, cecs_arena *report_arena) {
+    cecs_world_memory_report report = {
+        .arenas = cecs_world_arenas_get_dbg_info(w),
+        .entities = cecs_world_entities_memory_usage(&w->entities),
+        .component_storages_map = cecs_memory_usage_add(
+            cecs_memory_usage_add(
+                cecs_paged_sparse_set_memory_usage(&w->components.component_storages, sizeof(cecs_sized_component_storage)),
+                cecs_paged_sparse_set_memory_usage(
+                    &w->components.component_storages_attachments, sizeof(cecs_component_storage_attachments)
+                )
+            ),
+            cecs_world_components_entity_signatures_memory_usage(&w->components)
+        ),
+        .components = { 0 },
+        .component_storages = CECS_DYNAMIC_ARRAY_CREATE_WITH_CAPACITY(
+            cecs_component_storage_memory_report,
+            report_arena,
+            cecs_world_components_get_component_storage_count(&w->components)
+        ),
+        .relations = cecs_world_relations_get_memory_usage(&w->relations),
+        .resources = cecs_world_resources_memory_usage(&w->resources),
+        .resource_sizes = cecs_dynamic_array_create(),
+        .events = cecs_world_events_memory_usage(&w->events),
+        .changes = cecs_world_changes_memory_usage(&w->changes),
+        .total = { 0 }
+    };
+    report.components.reserved += w->components.discard.size;
+
+    cecs_world_components_iterator it = cecs_world_components_iterator_create(&w->components);
+    while (!cecs_world_components_iterator_done(&it)) {
+        cecs_associated_component_storage current = cecs_world_components_iterator_current(&it);
+        const cecs_component_storage *storage = &current.storage->storage;
+        const size_t entity_count = cecs_hibitset_count_set(&storage->entity_bitset);
+
+        cecs_component_storage_memory_report storage_report = {
+            .component_id = current.component_id,
+            .component_size = current.storage->component_size,
+            .entity_count = entity_count,
+            .components = cecs_component_storage_memory_usage(storage, entity_count, current.storage->component_size),
+            .entity_bitset = cecs_hibitset_memory_usage(&storage->entity_bitset)
+        };
+        report.components = cecs_memory_usage_add(
+            report.components,
+            cecs_memory_usage_add(storage_report.components, storage_report.entity_bitset)
+        );
+        CECS_DYNAMIC_ARRAY_ADD(cecs_component_storage_memory_report, &report.component_storages, report_arena, &storage_report);
+
+        cecs_world_components_iterator_next(&it);
+    }
+
+    const cecs_exclusive_range resource_range = cecs_paged_sentinel_set_index_range(&w->resources.resource_handles);
+    for (cecs_ssize_t i = resource_range.start; i < resource_range.end; ++i) {
+        if (cecs_world_resources_has_resource(&w->resources, (cecs_resource_id)i)) {
+            cecs_resource_memory_report resource_report = {
+                .resource_id = (cecs_resource_id)i,
+                .resource_size = cecs_world_resources_get_resource_size(&w->resources, (cecs_resource_id)i)
+            };
+            CECS_DYNAMIC_ARRAY_ADD(cecs_resource_memory_report, &report.resource_sizes, report_arena, &resource_report);
+        }
+    }
+
+    for (size_t i = 0; i < cecs_world_events_event_channel_count(&w->events); ++i) {
+        const cecs_resource_id channel_id = cecs_world_events_event_channel_id(&w->events, i);
+        if (cecs_world_resources_has_resource(&w->resources, channel_id)) {
+            report.events = cecs_memory_usage_add(
+                report.events,
+                cecs_event_channel_memory_usage(cecs_world_resources_get_resource(&w->resources, channel_id))
+            );
+        }
+    }
+
+    report.total = cecs_memory_usage_add(report.entities, report.component_storages_map);
+    report.total = cecs_memory_usage_add(report.total, report.components);
+    report.total = cecs_memory_usage_add(report.total, report.relations.associations);
+    report.total = cecs_memory_usage_add(report.total, report.relations.target_holders);
+    report.total = cecs_memory_usage_add(report.total, report.relations.reverse_associations);
+    report.total = cecs_memory_usage_add(report.total, report.relations.source_holders);
+    report.total = cecs_memory_usage_add(report.total, report.relations.pair_tables);
+    report.total = cecs_memory_usage_add(report.total, report.resources);
+    report.total = cecs_memory_usage_add(report.total, report.events);
+    report.total = cecs_memory_usage_add(report.total, report.changes);
+    return report;
+}
+
+const cecs_component_storage_memory_report *cecs_world_memory_report_largest_component_storage(const cecs_world_memory_report *report) {
+    const cecs_component_storage_memory_report *largest = NULL;
+    for (size_t i = 0; i < cecs_world_memory_report_component_storage_count(report); ++i) {
+        const cecs_component_storage_memory_report *current = cecs_world_memory_report_component_storage(report, i);
+        if (largest == NULL || current->components.reserved > largest->components.reserved) {
+            largest = current;
+        }
+    }
+    return largest;
+}
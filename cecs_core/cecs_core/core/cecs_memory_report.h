@@ -0,0 +1,79 @@
+#ifndef CECS_MEMORY_REPORT_H
+#define CECS_MEMORY_REPORT_H
+
+#include <stdint.h>
+#include "../containers/cecs_arena.h"
+#include "../containers/cecs_dynamic_array.h"
+#include "cecs_world.h"
+
+typedef struct cecs_component_storage_memory_report {
+    cecs_component_id component_id;
+    size_t component_size;
+    size_t entity_count;
+    cecs_memory_usage components;
+    cecs_memory_usage entity_bitset;
+} cecs_component_storage_memory_report;
+
+typedef struct cecs_resource_memory_report {
+    cecs_resource_id resource_id;
+    size_t resource_size;
+} cecs_resource_memory_report;
+
+typedef struct cecs_world_arenas_dbg_info {
+    cecs_arena_dbg_info entity_ids_arena;
+    cecs_arena_dbg_info storages_arena;
+    cecs_arena_dbg_info components_arena;
+    cecs_arena_dbg_info associations_arena;
+    cecs_arena_dbg_info resources_arena;
+    cecs_arena_dbg_info events_arena;
+    cecs_arena_dbg_info changes_arena;
+} cecs_world_arenas_dbg_info;
+
+typedef struct cecs_world_memory_report {
+    cecs_world_arenas_dbg_info arenas;
+
+    cecs_memory_usage entities;
+
+    cecs_memory_usage component_storages_map;
+    cecs_memory_usage components;
+    cecs_dynamic_array component_storages;
+
+    cecs_world_relations_memory_usage relations;
+
+    cecs_memory_usage resources;
+    cecs_dynamic_array resource_sizes;
+
+    cecs_memory_usage events;
+
+    cecs_memory_usage changes;
+
+    cecs_memory_usage total;
+} cecs_world_memory_report;
+
+cecs_world_memory_report cecs_world_get_memory_report(const cecs_world *w, cecs_arena *report_arena);
+
+static inline size_t cecs_world_memory_report_component_storage_count(const cecs_world_memory_report *report) {
+    return CECS_DYNAMIC_ARRAY_COUNT(cecs_component_storage_memory_report, &report->component_storages);
+}
+
+static inline const cecs_component_storage_memory_report *cecs_world_memory_report_component_storage(
+    const cecs_world_memory_report *report,
+    size_t index
+) {
+    return CECS_DYNAMIC_ARRAY_GET(cecs_component_storage_memory_report, &report->component_storages, index);
+}
+
+static inline size_t cecs_world_memory_report_resource_count(const cecs_world_memory_report *report) {
+    return CECS_DYNAMIC_ARRAY_COUNT(cecs_resource_memory_report, &report->resource_sizes);
+}
+
+static inline const cecs_resource_memory_report *cecs_world_memory_report_resource(
+    const cecs_world_memory_report *report,
+    size_t index
+) {
+    return CECS_DYNAMIC_ARRAY_GET(cecs_resource_memory_report, &report->resource_sizes, index);
+}
+
+const cecs_component_storage_memory_report *cecs_world_memory_report_largest_component_storage(const cecs_world_memory_report *report);
+
+#endif
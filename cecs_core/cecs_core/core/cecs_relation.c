@@ -5,21 +5,151 @@ cecs_world_relations cecs_world_relations_create(size_t entity_capacity) {
     cecs_world_relations wr;
     wr.associations_arena = cecs_arena_create_with_capacity(sizeof(cecs_entity_associated_holders) * initial_capacity);
     wr.associations = (cecs_entity_associations){
-        .entity_to_target_holders = cecs_flatmap_create(),
+        .entity_to_target_holders = cecs_flatmap_create_incremental(CECS_FLATMAP_MIGRATION_STEP_COUNT_DEFAULT),
+        .target_to_source_holders = cecs_flatmap_create_incremental(CECS_FLATMAP_MIGRATION_STEP_COUNT_DEFAULT),
     };
+    wr.cleanup_policies = cecs_flatmap_create();
+    wr.recycled_holders = cecs_dynamic_array_create();
+    wr.pair_tables = cecs_relation_pair_tables_create();
     return wr;
 }
 
 void cecs_world_relations_free(cecs_world_relations* wr) {
+    cecs_flatmap_free(&wr->associations.entity_to_target_holders);
+    cecs_flatmap_free(&wr->associations.target_to_source_holders);
+    cecs_relation_pair_tables_free(&wr->pair_tables);
     cecs_arena_free(&wr->associations_arena);
     wr->associations = (cecs_entity_associations){ 0 };
+    wr->cleanup_policies = (cecs_flatmap){ 0 };
+    wr->recycled_holders = (cecs_dynamic_array){ 0 };
 }
 
+cecs_world_relations_memory_usage cecs_world_relations_get_memory_usage(const cecs_world_relations *wr) {
+    const cecs_flatmap *associations = &wr->associations.entity_to_target_holders;
+    cecs_world_relations_memory_usage usage = {
+        .associations = cecs_flatmap_memory_usage(associations, sizeof(cecs_entity_associated_holders)),
+        .target_holders = { 0 },
+        .source_count = cecs_flatmap_occupied_count(associations),
+        .target_count = 0,
+        .largest_source = CECS_ENTITY_ID_MAX,
+        .largest_source_target_holders = { 0 }
+    };
+
+    cecs_flatmap_iterator it = cecs_flatmap_iterator_create_at((cecs_flatmap *)associations, 0);
+    if (associations->count > 0 && !associations->ctrl_and_hash_values[0].any.occupied) {
+        cecs_flatmap_iterator_next_occupied(&it);
+    }
+
+    size_t occupied_count = 0;
+    while (!cecs_flatmap_iterator_done_occupied(&it, occupied_count)) {
+        const cecs_entity_associated_holders *holders =
+            cecs_flatmap_iterator_current_value(&it, sizeof(cecs_entity_associated_holders));
+        const cecs_memory_usage holders_usage =
+            cecs_sparse_set_memory_usage(&holders->target_to_holder, sizeof(cecs_target_holder_info));
+
+        usage.target_holders = cecs_memory_usage_add(usage.target_holders, holders_usage);
+        usage.target_count += cecs_sparse_set_count_of_size(&holders->target_to_holder, sizeof(cecs_target_holder_info));
+        if (holders_usage.reserved > usage.largest_source_target_holders.reserved) {
+            usage.largest_source = (cecs_entity_id)cecs_flatmap_iterator_current_hash(&it, sizeof(cecs_entity_associated_holders))->hash;
+            usage.largest_source_target_holders = holders_usage;
+        }
+
+        ++occupied_count;
+        cecs_flatmap_iterator_next_occupied(&it);
+    }
+
+    const cecs_flatmap *reverse_associations = &wr->associations.target_to_source_holders;
+    usage.reverse_associations = cecs_flatmap_memory_usage(reverse_associations, sizeof(cecs_target_associated_holders));
+    cecs_flatmap_iterator reverse_it = cecs_flatmap_iterator_create_at((cecs_flatmap *)reverse_associations, 0);
+    if (reverse_associations->count > 0 && !reverse_associations->ctrl_and_hash_values[0].any.occupied) {
+        cecs_flatmap_iterator_next_occupied(&reverse_it);
+    }
+
+    size_t reverse_occupied_count = 0;
+    while (!cecs_flatmap_iterator_done_occupied(&reverse_it, reverse_occupied_count)) {
+        const cecs_target_associated_holders *holders =
+            cecs_flatmap_iterator_current_value(&reverse_it, sizeof(cecs_target_associated_holders));
+        usage.source_holders = cecs_memory_usage_add(
+            usage.source_holders,
+            cecs_sparse_set_memory_usage(&holders->source_to_holder, sizeof(cecs_target_holder_info))
+        );
+
+        ++reverse_occupied_count;
+        cecs_flatmap_iterator_next_occupied(&reverse_it);
+    }
+    usage.pair_tables = cecs_relation_pair_tables_memory_usage(&wr->pair_tables);
+    return usage;
+}
+
+static void cecs_world_relations_add_source_holder(
+    cecs_world_relations *wr,
+    const cecs_entity_id source,
+    const cecs_relation_target target,
+    const cecs_target_holder_info holder_info
+) {
+    const cecs_target_associated_holders default_holders = { cecs_sparse_set_create() };
+    cecs_target_associated_holders *holders = cecs_flatmap_get_or_add(
+        &wr->associations.target_to_source_holders,
+        &wr->associations_arena,
+        (cecs_flatmap_hash)target.tag_id,
+        &default_holders,
+        sizeof(cecs_target_associated_holders)
+    );
+    cecs_target_holder_info source_holder_info = holder_info;
+    cecs_sparse_set_set(
+        &holders->source_to_holder,
+        &wr->associations_arena,
+        (size_t)source,
+        &source_holder_info,
+        sizeof(cecs_target_holder_info)
+    );
+}
+
+// NOTE: orphaned sources were already dropped from the reverse index, so a missing source is not an error
+static bool cecs_world_relations_remove_source_holder(cecs_world_relations *wr, const cecs_entity_id source, const cecs_relation_target target) {
+    cecs_target_associated_holders *holders;
+    if (
+        !cecs_flatmap_get(
+            &wr->associations.target_to_source_holders,
+            (cecs_flatmap_hash)target.tag_id,
+            (void **)&holders,
+            sizeof(cecs_target_associated_holders)
+        )
+    ) {
+        return false;
+    }
+
+    cecs_target_holder_info removed;
+    if (
+        !cecs_sparse_set_remove(
+            &holders->source_to_holder,
+            &wr->associations_arena,
+            (size_t)source,
+            &removed,
+            sizeof(cecs_target_holder_info)
+        )
+    ) {
+        return false;
+    }
+
+    if (cecs_sparse_set_is_empty(&holders->source_to_holder)) {
+        cecs_target_associated_holders out;
+        cecs_flatmap_remove(
+            &wr->associations.target_to_source_holders,
+            &wr->associations_arena,
+            (cecs_flatmap_hash)target.tag_id,
+            &out,
+            sizeof(cecs_target_associated_holders)
+        );
+    }
+    return true;
+}
 
 bool cecs_world_relations_add_target_holder(
     cecs_world_relations *wr,
     const cecs_entity_id source,
     const cecs_relation_target target,
+    const cecs_relation_target_kind target_kind,
     const cecs_target_holder_id holder
 ) {
     const cecs_entity_associated_holders default_holders = { cecs_sparse_set_create() };
@@ -34,7 +164,7 @@ bool cecs_world_relations_add_target_holder(
     if (cecs_sparse_set_contains(&holders->target_to_holder, (size_t)target.tag_id)) {
         return false;
     } else {
-        cecs_target_holder_info holder_info = { holder };
+        cecs_target_holder_info holder_info = { holder, target_kind };
         cecs_sparse_set_set(
             &holders->target_to_holder,
             &wr->associations_arena,
@@ -42,6 +172,9 @@ bool cecs_world_relations_add_target_holder(
             &holder_info,
             sizeof(cecs_target_holder_info)
         );
+        if (target_kind == cecs_relation_target_kind_entity) {
+            cecs_world_relations_add_source_holder(wr, source, target, holder_info);
+        }
         return true;
     }
 }
@@ -115,6 +248,9 @@ bool cecs_world_relations_remove_target(cecs_world_relations *wr, const cecs_ent
     }
 
     *out_target_holder = holder.holder;
+    if (holder.target_kind == cecs_relation_target_kind_entity) {
+        cecs_world_relations_remove_source_holder(wr, source, target);
+    }
     if (cecs_sparse_set_is_empty(&holders->target_to_holder)) {
         cecs_entity_associated_holders out;
         cecs_flatmap_remove(
@@ -129,6 +265,100 @@ bool cecs_world_relations_remove_target(cecs_world_relations *wr, const cecs_ent
     return true;
 }
 
+bool cecs_world_relations_orphan_source(cecs_world_relations *wr, const cecs_entity_id source, const cecs_relation_target target) {
+    cecs_entity_associated_holders *holders;
+    if (!cecs_world_relations_has_holder_for_target(wr, source, target, &holders)) {
+        return false;
+    }
+
+    cecs_target_holder_info *holder =
+        cecs_sparse_set_get_expect(&holders->target_to_holder, (size_t)target.tag_id, sizeof(cecs_target_holder_info));
+    holder->target_kind = cecs_relation_target_kind_orphaned;
+    return cecs_world_relations_remove_source_holder(wr, source, target);
+}
+
+bool cecs_world_relations_has_associations(const cecs_world_relations *wr, const cecs_entity_id entity) {
+    void *holders;
+    return cecs_flatmap_get(
+        &wr->associations.entity_to_target_holders, (cecs_flatmap_hash)entity, &holders, sizeof(cecs_entity_associated_holders)
+    ) || cecs_flatmap_get(
+        &wr->associations.target_to_source_holders, (cecs_flatmap_hash)entity, &holders, sizeof(cecs_target_associated_holders)
+    ) || cecs_world_relations_has_pairs(wr, entity);
+}
+
+bool cecs_world_relations_has_pairs(const cecs_world_relations *wr, const cecs_entity_id entity) {
+    for (size_t i = 0; i < cecs_relation_pair_tables_count(&wr->pair_tables); ++i) {
+        void *links;
+        const cecs_relation_pair_table *table = CECS_DYNAMIC_ARRAY_GET(cecs_relation_pair_table, &wr->pair_tables.tables, i);
+        if (cecs_flatmap_get(&table->entity_links, (cecs_flatmap_hash)entity, &links, sizeof(cecs_relation_pair_links))) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool cecs_world_relations_is_empty(const cecs_world_relations *wr) {
+    if (
+        cecs_flatmap_occupied_count(&wr->associations.entity_to_target_holders) > 0
+        || cecs_flatmap_occupied_count(&wr->associations.target_to_source_holders) > 0
+    ) {
+        return false;
+    }
+    for (size_t i = 0; i < cecs_relation_pair_tables_count(&wr->pair_tables); ++i) {
+        const cecs_relation_pair_table *table = CECS_DYNAMIC_ARRAY_GET(cecs_relation_pair_table, &wr->pair_tables.tables, i);
+        if (cecs_flatmap_occupied_count(&table->entity_links) > 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void cecs_world_relations_set_cleanup_policy(
+    cecs_world_relations *wr,
+    const cecs_component_id relation_component_id,
+    const cecs_relation_cleanup_policy policy
+) {
+    *(cecs_relation_cleanup_policy *)cecs_flatmap_get_or_add(
+        &wr->cleanup_policies,
+        &wr->associations_arena,
+        (cecs_flatmap_hash)relation_component_id,
+        &policy,
+        sizeof(cecs_relation_cleanup_policy)
+    ) = policy;
+}
+
+cecs_relation_cleanup_policy cecs_world_relations_get_cleanup_policy(const cecs_world_relations *wr, const cecs_component_id relation_component_id) {
+    cecs_relation_cleanup_policy *policy;
+    if (
+        cecs_flatmap_get(
+            &wr->cleanup_policies,
+            (cecs_flatmap_hash)relation_component_id,
+            (void **)&policy,
+            sizeof(cecs_relation_cleanup_policy)
+        )
+    ) {
+        return *policy;
+    } else {
+        return cecs_relation_cleanup_policy_remove_relation;
+    }
+}
+
+void cecs_world_relations_recycle_holders(cecs_world_relations *wr, const cecs_target_holder_id *holders, const size_t count) {
+    if (count > 0) {
+        CECS_DYNAMIC_ARRAY_ADD_RANGE(cecs_target_holder_id, &wr->recycled_holders, &wr->associations_arena, holders, count);
+    }
+}
+
+bool cecs_world_relations_take_recycled_holder(cecs_world_relations *wr, cecs_target_holder_id *out_holder) {
+    const size_t recycled_count = CECS_DYNAMIC_ARRAY_COUNT(cecs_target_holder_id, &wr->recycled_holders);
+    if (recycled_count == 0) {
+        return false;
+    }
+    *out_holder = *CECS_DYNAMIC_ARRAY_GET(cecs_target_holder_id, &wr->recycled_holders, recycled_count - 1);
+    CECS_DYNAMIC_ARRAY_REMOVE(cecs_target_holder_id, &wr->recycled_holders, &wr->associations_arena, recycled_count - 1);
+    return true;
+}
+
 bool cecs_world_relations_get_targets(cecs_world_relations *wr, const cecs_entity_id source, cecs_relation_targets_iterator *out_iterator) {
     cecs_entity_associated_holders *holders;
     if (
@@ -144,4 +374,36 @@ bool cecs_world_relations_get_targets(cecs_world_relations *wr, const cecs_entit
 
     *out_iterator = cecs_sparse_set_iterator_create_at_index(&holders->target_to_holder, 0);
     return true;
-}
\ No newline at end of file
+}
+
+bool cecs_world_relations_get_sources(cecs_world_relations *wr, const cecs_relation_target target, cecs_relation_sources_iterator *out_iterator) {
+    cecs_target_associated_holders *holders;
+    if (
+        !cecs_flatmap_get(
+            &wr->associations.target_to_source_holders,
+            (cecs_flatmap_hash)target.tag_id,
+            (void **)&holders,
+            sizeof(cecs_target_associated_holders)
+        )
+    ) {
+        return false;
+    }
+
+    *out_iterator = cecs_sparse_set_iterator_create_at_index(&holders->source_to_holder, 0);
+    return true;
+}
+
+size_t cecs_world_relations_source_count(const cecs_world_relations *wr, const cecs_relation_target target) {
+    cecs_target_associated_holders *holders;
+    if (
+        !cecs_flatmap_get(
+            &wr->associations.target_to_source_holders,
+            (cecs_flatmap_hash)target.tag_id,
+            (void **)&holders,
+            sizeof(cecs_target_associated_holders)
+        )
+    ) {
+        return 0;
+    }
+    return cecs_sparse_set_count_of_size(&holders->source_to_holder, sizeof(cecs_target_holder_info));
+}
@@ -2,10 +2,14 @@
 #define CECS_RELATION_H
 
 #include <stdint.h>
+#include <stdbool.h>
+#include <assert.h>
 #include "../containers/cecs_flatmap.h"
+#include "../containers/cecs_dynamic_array.h"
 #include "component/entity/cecs_entity.h"
 #include "component/entity/cecs_tag.h"
 #include "component/cecs_component.h"
+#include "cecs_relation_pair.h"
 
 typedef union cecs_relation_target {
     cecs_entity_id entity_id;
@@ -60,39 +64,139 @@ static inline cecs_relation_id cecs_relation_id_create(cecs_relation_id_descript
 #define CECS_RELATION_ID(component_type, target_id) \
     cecs_relation_id_create(cecs_relation_id_descriptor_create_tag(CECS_COMPONENT_ID(component_type), target_id))
 
+#define CECS_RELATION_ID_TARGET_MASK ((((cecs_component_id)1) << CECS_COMPONENT_ID_RELATION_SHIFT) - 1)
+static inline bool cecs_relation_id_is_relation(cecs_component_id id) {
+    return (id >> CECS_COMPONENT_ID_RELATION_SHIFT) != 0;
+}
+// NOTE: the largest target and component halves are reserved for wildcards, R(*) matches R to any target and *(T) any relation to T.
+// R(*) covers holder relations and pairs, *(T) only holder relations, see CECS_WORLD_ANY_COMPONENT_WILDCARDS
+#define CECS_RELATION_TARGET_WILDCARD ((cecs_tag_id)CECS_RELATION_ID_TARGET_MASK)
+#define CECS_RELATION_COMPONENT_WILDCARD ((cecs_component_id)((((cecs_component_id)-1) >> CECS_COMPONENT_ID_RELATION_SHIFT) - 1))
+static inline bool cecs_relation_id_is_wildcard(cecs_relation_id id) {
+    return cecs_relation_id_is_relation(id)
+        && (
+            (id & CECS_RELATION_ID_TARGET_MASK) == CECS_RELATION_TARGET_WILDCARD
+            || (id >> CECS_COMPONENT_ID_RELATION_SHIFT) == (CECS_RELATION_COMPONENT_WILDCARD + 1)
+        );
+}
+static inline bool cecs_relation_id_is_pair(cecs_component_id id) {
+    return cecs_relation_id_is_relation(id) && !cecs_relation_id_is_wildcard(id);
+}
+
+static inline cecs_relation_id cecs_relation_id_create_any_target(cecs_component_id component_id) {
+    return cecs_relation_id_create(cecs_relation_id_descriptor_create_tag(component_id, CECS_RELATION_TARGET_WILDCARD));
+}
+#define CECS_RELATION_ID_ANY_TARGET(component_type) \
+    cecs_relation_id_create_any_target(CECS_COMPONENT_ID(component_type))
+
+static inline cecs_relation_id cecs_relation_id_create_any_component(cecs_tag_id target_id) {
+    return cecs_relation_id_create(cecs_relation_id_descriptor_create_tag(CECS_RELATION_COMPONENT_WILDCARD, target_id));
+}
+#define CECS_RELATION_ID_ANY_COMPONENT(target_id) \
+    cecs_relation_id_create_any_component(target_id)
+
+static inline cecs_relation_id_descriptor cecs_relation_id_descriptor_from(cecs_relation_id id) {
+    assert(cecs_relation_id_is_relation(id) && "error: component id is not a relation id");
+    return cecs_relation_id_descriptor_create_tag(
+        (id >> CECS_COMPONENT_ID_RELATION_SHIFT) - 1,
+        (cecs_tag_id)(id & CECS_RELATION_ID_TARGET_MASK)
+    );
+}
+
 typedef cecs_entity_id cecs_target_holder_id;
+// NOTE: only entity targets are kept in the reverse index, tag targets such as scenes are left alone when entities are removed
+typedef enum cecs_relation_target_kind {
+    cecs_relation_target_kind_entity,
+    cecs_relation_target_kind_tag,
+    // NOTE: the target entity was removed while the source kept the relation under the orphan policy
+    cecs_relation_target_kind_orphaned,
+} cecs_relation_target_kind;
+
 typedef struct cecs_target_holder_info {
     cecs_target_holder_id holder;
+    cecs_relation_target_kind target_kind;
 } cecs_target_holder_info;
 typedef struct cecs_entity_associated_holders {
     cecs_sparse_set target_to_holder;
 } cecs_entity_associated_holders;
 
+typedef struct cecs_target_associated_holders {
+    cecs_sparse_set source_to_holder;
+} cecs_target_associated_holders;
+
 typedef struct cecs_entity_associations {
     cecs_flatmap entity_to_target_holders;
+    // NOTE: reverse index of entity_to_target_holders, every add and remove of a target keeps both in sync
+    cecs_flatmap target_to_source_holders;
 } cecs_entity_associations;
 
+// NOTE: what happens to the sources of a relation when its target entity is removed
+typedef enum cecs_relation_cleanup_policy {
+    cecs_relation_cleanup_policy_remove_relation,
+    // NOTE: sources keep the relation and its holder until they are removed themselves
+    cecs_relation_cleanup_policy_orphan,
+    cecs_relation_cleanup_policy_delete_sources,
+} cecs_relation_cleanup_policy;
+
 typedef struct cecs_world_relations {
     cecs_arena associations_arena;
     cecs_entity_associations associations;
+    cecs_flatmap cleanup_policies;
+    cecs_dynamic_array recycled_holders;
+    cecs_relation_pair_tables pair_tables;
 } cecs_world_relations;
 
 cecs_world_relations cecs_world_relations_create(size_t entity_capacity);
 void cecs_world_relations_free(cecs_world_relations *wr);
 
+typedef struct cecs_world_relations_memory_usage {
+    cecs_memory_usage associations;
+    cecs_memory_usage target_holders;
+    size_t source_count;
+    size_t target_count;
+    cecs_entity_id largest_source;
+    cecs_memory_usage largest_source_target_holders;
+    cecs_memory_usage reverse_associations;
+    cecs_memory_usage source_holders;
+    cecs_memory_usage pair_tables;
+} cecs_world_relations_memory_usage;
+
+cecs_world_relations_memory_usage cecs_world_relations_get_memory_usage(const cecs_world_relations *wr);
+
 bool cecs_world_relations_add_target_holder(
     cecs_world_relations *wr,
     const cecs_entity_id source,
     const cecs_relation_target target,
+    const cecs_relation_target_kind target_kind,
     const cecs_target_holder_id holder
 );
 
 cecs_target_holder_id cecs_world_relations_add_target_expect(cecs_world_relations *wr, const cecs_entity_id source, const cecs_relation_target target);
 bool cecs_world_relations_get_target(cecs_world_relations *wr, const cecs_entity_id source, const cecs_relation_target target, cecs_target_holder_id *out_target_holder);
 bool cecs_world_relations_remove_target(cecs_world_relations *wr, const cecs_entity_id source, const cecs_relation_target target, cecs_target_holder_id *out_target_holder);
+bool cecs_world_relations_orphan_source(cecs_world_relations *wr, const cecs_entity_id source, const cecs_relation_target target);
+
+bool cecs_world_relations_has_associations(const cecs_world_relations *wr, const cecs_entity_id entity);
+bool cecs_world_relations_has_pairs(const cecs_world_relations *wr, const cecs_entity_id entity);
+bool cecs_world_relations_is_empty(const cecs_world_relations *wr);
+
+void cecs_world_relations_set_cleanup_policy(
+    cecs_world_relations *wr,
+    const cecs_component_id relation_component_id,
+    const cecs_relation_cleanup_policy policy
+);
+cecs_relation_cleanup_policy cecs_world_relations_get_cleanup_policy(const cecs_world_relations *wr, const cecs_component_id relation_component_id);
+
+void cecs_world_relations_recycle_holders(cecs_world_relations *wr, const cecs_target_holder_id *holders, const size_t count);
+bool cecs_world_relations_take_recycled_holder(cecs_world_relations *wr, cecs_target_holder_id *out_holder);
 
 
 typedef cecs_sparse_set_iterator cecs_relation_targets_iterator;
 bool cecs_world_relations_get_targets(cecs_world_relations *wr, const cecs_entity_id source, cecs_relation_targets_iterator *out_iterator);
 
+// NOTE: iterates the sources related to a target, keys are source ids and values cecs_target_holder_info
+typedef cecs_sparse_set_iterator cecs_relation_sources_iterator;
+bool cecs_world_relations_get_sources(cecs_world_relations *wr, const cecs_relation_target target, cecs_relation_sources_iterator *out_iterator);
+size_t cecs_world_relations_source_count(const cecs_world_relations *wr, const cecs_relation_target target);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,325 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "cecs_relation_pair.h"
+
+static const cecs_relation_pair_links cecs_relation_pair_links_empty = {
+    .first_target = CECS_RELATION_PAIR_INDEX_NONE,
+    .first_source = CECS_RELATION_PAIR_INDEX_NONE,
+    .target_count = 0,
+    .source_count = 0
+};
+
+// NOTE: bijective mix, keys stay unique while consecutive entity ids spread over the table
+static inline cecs_flatmap_hash cecs_relation_pair_key(const cecs_relation_pair_index source, const cecs_relation_pair_index target) {
+    cecs_flatmap_hash key = ((cecs_flatmap_hash)source << 32) | (cecs_flatmap_hash)target;
+    key *= 0x9E3779B97F4A7C15ull;
+    return key ^ (key >> 32);
+}
+
+static inline cecs_relation_pair_index cecs_relation_pair_index_from(const cecs_entity_id entity) {
+    const cecs_entity_id index = cecs_entity_id_index(entity);
+    assert(index < CECS_RELATION_PAIR_INDEX_NONE && "error: entity index is too large for a relation pair");
+    return (cecs_relation_pair_index)index;
+}
+
+static inline bool cecs_relation_pair_matches(const cecs_relation_pair *pair, const cecs_entity_id source, const cecs_entity_id target) {
+    return pair->source_generation == cecs_entity_id_generation(source) && pair->target_generation == cecs_entity_id_generation(target);
+}
+
+cecs_relation_pair_tables cecs_relation_pair_tables_create(void) {
+    return (cecs_relation_pair_tables) {
+        .tables = cecs_dynamic_array_create(),
+        .component_to_table_index = cecs_flatmap_create()
+    };
+}
+
+void cecs_relation_pair_tables_free(cecs_relation_pair_tables *tables) {
+    for (size_t i = 0; i < CECS_DYNAMIC_ARRAY_COUNT(cecs_relation_pair_table, &tables->tables); ++i) {
+        cecs_relation_pair_table *table = CECS_DYNAMIC_ARRAY_GET_MUT(cecs_relation_pair_table, &tables->tables, i);
+        cecs_flatmap_free(&table->pairs);
+        cecs_flatmap_free(&table->entity_links);
+    }
+    *tables = (cecs_relation_pair_tables){ 0 };
+}
+
+cecs_memory_usage cecs_relation_pair_tables_memory_usage(const cecs_relation_pair_tables *tables) {
+    cecs_memory_usage usage = cecs_memory_usage_add(
+        cecs_dynamic_array_memory_usage(&tables->tables),
+        cecs_flatmap_memory_usage(&tables->component_to_table_index, sizeof(size_t))
+    );
+    for (size_t i = 0; i < CECS_DYNAMIC_ARRAY_COUNT(cecs_relation_pair_table, &tables->tables); ++i) {
+        const cecs_relation_pair_table *table = CECS_DYNAMIC_ARRAY_GET(cecs_relation_pair_table, &tables->tables, i);
+        usage = cecs_memory_usage_add(
+            usage,
+            cecs_memory_usage_add(
+                cecs_flatmap_memory_usage(&table->pairs, table->pair_size),
+                cecs_flatmap_memory_usage(&table->entity_links, sizeof(cecs_relation_pair_links))
+            )
+        );
+    }
+    return usage;
+}
+
+bool cecs_relation_pair_tables_get(
+    const cecs_relation_pair_tables *tables,
+    const cecs_component_id component_id,
+    cecs_relation_pair_table **out_table
+) {
+    size_t *table_index;
+    if (cecs_flatmap_get(&tables->component_to_table_index, (cecs_flatmap_hash)component_id, (void **)&table_index, sizeof(size_t))) {
+        *out_table = CECS_DYNAMIC_ARRAY_GET_MUT(cecs_relation_pair_table, &tables->tables, *table_index);
+        return true;
+    } else {
+        *out_table = NULL;
+        return false;
+    }
+}
+
+cecs_relation_pair_table *cecs_relation_pair_tables_get_or_add(
+    cecs_relation_pair_tables *tables,
+    cecs_arena *a,
+    const cecs_component_id component_id,
+    const size_t component_size
+) {
+    cecs_relation_pair_table *table;
+    if (cecs_relation_pair_tables_get(tables, component_id, &table)) {
+        assert(table->component_size == component_size && "error: relation pair component size mismatch");
+        return table;
+    }
+
+    const size_t alignment = sizeof(cecs_flatmap_hash_header);
+    const size_t pair_size = ((sizeof(cecs_relation_pair) + component_size + alignment - 1) / alignment) * alignment;
+    const size_t table_index = cecs_relation_pair_tables_count(tables);
+    cecs_flatmap_add(
+        &tables->component_to_table_index,
+        a,
+        (cecs_flatmap_hash)component_id,
+        &table_index,
+        sizeof(size_t),
+        &(void *){ NULL }
+    );
+    return CECS_DYNAMIC_ARRAY_ADD(cecs_relation_pair_table, &tables->tables, a, (&(cecs_relation_pair_table){
+        .pairs = cecs_flatmap_create_incremental(CECS_FLATMAP_MIGRATION_STEP_COUNT_DEFAULT),
+        .entity_links = cecs_flatmap_create_incremental(CECS_FLATMAP_MIGRATION_STEP_COUNT_DEFAULT),
+        .scratch_pair = cecs_arena_alloc(a, pair_size),
+        .component_id = component_id,
+        .component_size = component_size,
+        .pair_size = pair_size
+    }));
+}
+
+static inline cecs_relation_pair *cecs_relation_pair_table_get_expect(
+    const cecs_relation_pair_table *table,
+    const cecs_relation_pair_index source,
+    const cecs_relation_pair_index target
+) {
+    cecs_relation_pair *pair;
+    if (!cecs_flatmap_get(&table->pairs, cecs_relation_pair_key(source, target), (void **)&pair, table->pair_size)) {
+        assert(false && "unreachable: linked relation pair is missing from its table");
+        exit(EXIT_FAILURE);
+    }
+    return pair;
+}
+
+static inline cecs_relation_pair_links *cecs_relation_pair_table_get_or_add_links(
+    cecs_relation_pair_table *table,
+    cecs_arena *a,
+    const cecs_relation_pair_index entity
+) {
+    return cecs_flatmap_get_or_add(
+        &table->entity_links, a, (cecs_flatmap_hash)entity, &cecs_relation_pair_links_empty, sizeof(cecs_relation_pair_links)
+    );
+}
+
+static inline cecs_relation_pair_links *cecs_relation_pair_table_get_links_expect(
+    const cecs_relation_pair_table *table,
+    const cecs_relation_pair_index entity
+) {
+    cecs_relation_pair_links *links;
+    if (!cecs_flatmap_get(&table->entity_links, (cecs_flatmap_hash)entity, (void **)&links, sizeof(cecs_relation_pair_links))) {
+        assert(false && "unreachable: relation pair entity has no links");
+        exit(EXIT_FAILURE);
+    }
+    return links;
+}
+
+cecs_relation_pair_links cecs_relation_pair_table_get_links(const cecs_relation_pair_table *table, const cecs_entity_id entity) {
+    cecs_relation_pair_links *links;
+    if (cecs_flatmap_get(
+        &table->entity_links, (cecs_flatmap_hash)cecs_entity_id_index(entity), (void **)&links, sizeof(cecs_relation_pair_links)
+    )) {
+        return *links;
+    } else {
+        return cecs_relation_pair_links_empty;
+    }
+}
+
+bool cecs_relation_pair_table_get(
+    const cecs_relation_pair_table *table,
+    const cecs_entity_id source,
+    const cecs_entity_id target,
+    cecs_relation_pair **out_pair
+) {
+    if (
+        cecs_flatmap_get(
+            &table->pairs,
+            cecs_relation_pair_key(cecs_relation_pair_index_from(source), cecs_relation_pair_index_from(target)),
+            (void **)out_pair,
+            table->pair_size
+        )
+        && cecs_relation_pair_matches(*out_pair, source, target)
+    ) {
+        return true;
+    } else {
+        *out_pair = NULL;
+        return false;
+    }
+}
+
+void *cecs_relation_pair_table_set(
+    cecs_relation_pair_table *table,
+    cecs_arena *a,
+    const cecs_entity_id source,
+    const cecs_entity_id target,
+    const void *component,
+    bool *out_added
+) {
+    const cecs_relation_pair_index source_index = cecs_relation_pair_index_from(source);
+    const cecs_relation_pair_index target_index = cecs_relation_pair_index_from(target);
+    assert(target_index != CECS_RELATION_PAIR_INDEX_NONE && "error: relation pair target is reserved");
+    const cecs_flatmap_hash key = cecs_relation_pair_key(source_index, target_index);
+
+    cecs_relation_pair *pair;
+    if (cecs_flatmap_get(&table->pairs, key, (void **)&pair, table->pair_size)) {
+        // NOTE: a pair left by the previous entities of both slots is taken over by the new ids
+        *out_added = !cecs_relation_pair_matches(pair, source, target);
+        pair->source_generation = cecs_entity_id_generation(source);
+        pair->target_generation = cecs_entity_id_generation(target);
+        if (table->component_size > 0) {
+            memcpy(cecs_relation_pair_component(pair), component, table->component_size);
+        }
+        return cecs_relation_pair_component(pair);
+    }
+
+    // NOTE: links move on every add, each one is updated before the next lookup
+    cecs_relation_pair_links *source_links = cecs_relation_pair_table_get_or_add_links(table, a, source_index);
+    const cecs_relation_pair_index next_target = source_links->first_target;
+    source_links->first_target = target_index;
+    ++source_links->target_count;
+
+    cecs_relation_pair_links *target_links = cecs_relation_pair_table_get_or_add_links(table, a, target_index);
+    const cecs_relation_pair_index next_source = target_links->first_source;
+    target_links->first_source = source_index;
+    ++target_links->source_count;
+
+    *table->scratch_pair = (cecs_relation_pair){
+        .source = source_index,
+        .target = target_index,
+        .next_target = next_target,
+        .previous_target = CECS_RELATION_PAIR_INDEX_NONE,
+        .next_source = next_source,
+        .previous_source = CECS_RELATION_PAIR_INDEX_NONE,
+        .source_generation = cecs_entity_id_generation(source),
+        .target_generation = cecs_entity_id_generation(target)
+    };
+    if (table->component_size > 0) {
+        memcpy(cecs_relation_pair_component(table->scratch_pair), component, table->component_size);
+    }
+    cecs_flatmap_add(&table->pairs, a, key, table->scratch_pair, table->pair_size, (void **)&pair);
+
+    if (next_target != CECS_RELATION_PAIR_INDEX_NONE) {
+        cecs_relation_pair_table_get_expect(table, source_index, next_target)->previous_target = target_index;
+    }
+    if (next_source != CECS_RELATION_PAIR_INDEX_NONE) {
+        cecs_relation_pair_table_get_expect(table, next_source, target_index)->previous_source = source_index;
+    }
+
+    *out_added = true;
+    cecs_flatmap_get(&table->pairs, key, (void **)&pair, table->pair_size);
+    return cecs_relation_pair_component(pair);
+}
+
+static void cecs_relation_pair_table_release_links(cecs_relation_pair_table *table, cecs_arena *a, const cecs_relation_pair_index entity) {
+    const cecs_relation_pair_links *links = cecs_relation_pair_table_get_links_expect(table, entity);
+    if (links->target_count == 0 && links->source_count == 0) {
+        cecs_flatmap_remove(&table->entity_links, a, (cecs_flatmap_hash)entity, &(cecs_relation_pair_links){ 0 }, sizeof(cecs_relation_pair_links));
+    }
+}
+
+bool cecs_relation_pair_table_remove(
+    cecs_relation_pair_table *table,
+    cecs_arena *a,
+    const cecs_entity_id source,
+    const cecs_entity_id target,
+    void *out_removed_component
+) {
+    const cecs_relation_pair_index source_index = cecs_relation_pair_index_from(source);
+    const cecs_relation_pair_index target_index = cecs_relation_pair_index_from(target);
+    const cecs_flatmap_hash key = cecs_relation_pair_key(source_index, target_index);
+    cecs_relation_pair *pair;
+    if (!cecs_flatmap_get(&table->pairs, key, (void **)&pair, table->pair_size) || !cecs_relation_pair_matches(pair, source, target)) {
+        return false;
+    }
+    cecs_flatmap_remove(&table->pairs, a, key, table->scratch_pair, table->pair_size);
+    const cecs_relation_pair removed = *table->scratch_pair;
+    if (out_removed_component != NULL && table->component_size > 0) {
+        memcpy(out_removed_component, cecs_relation_pair_component(table->scratch_pair), table->component_size);
+    }
+
+    if (removed.previous_target == CECS_RELATION_PAIR_INDEX_NONE) {
+        cecs_relation_pair_table_get_links_expect(table, source_index)->first_target = removed.next_target;
+    } else {
+        cecs_relation_pair_table_get_expect(table, source_index, removed.previous_target)->next_target = removed.next_target;
+    }
+    if (removed.next_target != CECS_RELATION_PAIR_INDEX_NONE) {
+        cecs_relation_pair_table_get_expect(table, source_index, removed.next_target)->previous_target = removed.previous_target;
+    }
+
+    if (removed.previous_source == CECS_RELATION_PAIR_INDEX_NONE) {
+        cecs_relation_pair_table_get_links_expect(table, target_index)->first_source = removed.next_source;
+    } else {
+        cecs_relation_pair_table_get_expect(table, removed.previous_source, target_index)->next_source = removed.next_source;
+    }
+    if (removed.next_source != CECS_RELATION_PAIR_INDEX_NONE) {
+        cecs_relation_pair_table_get_expect(table, removed.next_source, target_index)->previous_source = removed.previous_source;
+    }
+
+    --cecs_relation_pair_table_get_links_expect(table, source_index)->target_count;
+    --cecs_relation_pair_table_get_links_expect(table, target_index)->source_count;
+    cecs_relation_pair_table_release_links(table, a, source_index);
+    if (target_index != source_index) {
+        cecs_relation_pair_table_release_links(table, a, target_index);
+    }
+    return true;
+}
+
+cecs_relation_pair_iterator cecs_relation_pair_iterator_create_targets(const cecs_relation_pair_table *table, const cecs_entity_id source) {
+    return (cecs_relation_pair_iterator) {
+        .table = table,
+        .entity = cecs_relation_pair_index_from(source),
+        .current = cecs_relation_pair_table_get_links(table, source).first_target,
+        .over_targets = true
+    };
+}
+
+cecs_relation_pair_iterator cecs_relation_pair_iterator_create_sources(const cecs_relation_pair_table *table, const cecs_entity_id target) {
+    return (cecs_relation_pair_iterator) {
+        .table = table,
+        .entity = cecs_relation_pair_index_from(target),
+        .current = cecs_relation_pair_table_get_links(table, target).first_source,
+        .over_targets = false
+    };
+}
+
+cecs_relation_pair *cecs_relation_pair_iterator_current(const cecs_relation_pair_iterator *it) {
+    assert(!cecs_relation_pair_iterator_done(it) && "error: relation pair iterator is done");
+    return it->over_targets
+        ? cecs_relation_pair_table_get_expect(it->table, it->entity, it->current)
+        : cecs_relation_pair_table_get_expect(it->table, it->current, it->entity);
+}
+
+cecs_relation_pair_index cecs_relation_pair_iterator_next(cecs_relation_pair_iterator *it) {
+    const cecs_relation_pair *pair = cecs_relation_pair_iterator_current(it);
+    return it->current = it->over_targets ? pair->next_target : pair->next_source;
+}
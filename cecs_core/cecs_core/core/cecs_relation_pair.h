@@ -0,0 +1,127 @@
+#ifndef CECS_RELATION_PAIR_H
+#define CECS_RELATION_PAIR_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <assert.h>
+#include "../containers/cecs_arena.h"
+#include "../containers/cecs_flatmap.h"
+#include "../containers/cecs_dynamic_array.h"
+#include "component/entity/cecs_entity.h"
+#include "component/cecs_component.h"
+
+typedef uint32_t cecs_relation_pair_index;
+#define CECS_RELATION_PAIR_INDEX_NONE UINT32_MAX
+
+// NOTE: pairs are linked twice, through the pairs of their source and through the pairs of their target.
+// Pairs are keyed by entity index, the generations keep ids of recycled slots from matching pairs of their previous entities
+typedef struct cecs_relation_pair {
+    cecs_relation_pair_index source;
+    cecs_relation_pair_index target;
+    cecs_relation_pair_index next_target;
+    cecs_relation_pair_index previous_target;
+    cecs_relation_pair_index next_source;
+    cecs_relation_pair_index previous_source;
+    cecs_entity_generation source_generation;
+    cecs_entity_generation target_generation;
+} cecs_relation_pair;
+
+static inline cecs_entity_id cecs_relation_pair_source_id(const cecs_relation_pair *pair) {
+    return cecs_entity_id_create(pair->source, pair->source_generation);
+}
+static inline cecs_entity_id cecs_relation_pair_target_id(const cecs_relation_pair *pair) {
+    return cecs_entity_id_create(pair->target, pair->target_generation);
+}
+
+typedef struct cecs_relation_pair_links {
+    cecs_relation_pair_index first_target;
+    cecs_relation_pair_index first_source;
+    cecs_relation_pair_index target_count;
+    cecs_relation_pair_index source_count;
+} cecs_relation_pair_links;
+
+// NOTE: one table per relation component, pair values are the pair followed by the component, padded to keep slots aligned
+typedef struct cecs_relation_pair_table {
+    cecs_flatmap pairs;
+    cecs_flatmap entity_links;
+    cecs_relation_pair *scratch_pair;
+    cecs_component_id component_id;
+    size_t component_size;
+    size_t pair_size;
+} cecs_relation_pair_table;
+
+typedef struct cecs_relation_pair_tables {
+    cecs_dynamic_array tables;
+    cecs_flatmap component_to_table_index;
+} cecs_relation_pair_tables;
+
+cecs_relation_pair_tables cecs_relation_pair_tables_create(void);
+void cecs_relation_pair_tables_free(cecs_relation_pair_tables *tables);
+
+cecs_memory_usage cecs_relation_pair_tables_memory_usage(const cecs_relation_pair_tables *tables);
+
+static inline size_t cecs_relation_pair_tables_count(const cecs_relation_pair_tables *tables) {
+    return CECS_DYNAMIC_ARRAY_COUNT(cecs_relation_pair_table, &tables->tables);
+}
+static inline cecs_relation_pair_table *cecs_relation_pair_tables_at(cecs_relation_pair_tables *tables, const size_t index) {
+    return CECS_DYNAMIC_ARRAY_GET_MUT(cecs_relation_pair_table, &tables->tables, index);
+}
+
+bool cecs_relation_pair_tables_get(
+    const cecs_relation_pair_tables *tables,
+    const cecs_component_id component_id,
+    cecs_relation_pair_table **out_table
+);
+cecs_relation_pair_table *cecs_relation_pair_tables_get_or_add(
+    cecs_relation_pair_tables *tables,
+    cecs_arena *a,
+    const cecs_component_id component_id,
+    const size_t component_size
+);
+
+static inline void *cecs_relation_pair_component(cecs_relation_pair *pair) {
+    return pair + 1;
+}
+
+bool cecs_relation_pair_table_get(
+    const cecs_relation_pair_table *table,
+    const cecs_entity_id source,
+    const cecs_entity_id target,
+    cecs_relation_pair **out_pair
+);
+void *cecs_relation_pair_table_set(
+    cecs_relation_pair_table *table,
+    cecs_arena *a,
+    const cecs_entity_id source,
+    const cecs_entity_id target,
+    const void *component,
+    bool *out_added
+);
+bool cecs_relation_pair_table_remove(
+    cecs_relation_pair_table *table,
+    cecs_arena *a,
+    const cecs_entity_id source,
+    const cecs_entity_id target,
+    void *out_removed_component
+);
+
+cecs_relation_pair_links cecs_relation_pair_table_get_links(const cecs_relation_pair_table *table, const cecs_entity_id entity);
+
+// NOTE: walks the targets of a source or the sources of a target, removing the current pair invalidates the iterator
+typedef struct cecs_relation_pair_iterator {
+    const cecs_relation_pair_table *table;
+    cecs_relation_pair_index entity;
+    cecs_relation_pair_index current;
+    bool over_targets;
+} cecs_relation_pair_iterator;
+
+cecs_relation_pair_iterator cecs_relation_pair_iterator_create_targets(const cecs_relation_pair_table *table, const cecs_entity_id source);
+cecs_relation_pair_iterator cecs_relation_pair_iterator_create_sources(const cecs_relation_pair_table *table, const cecs_entity_id target);
+
+static inline bool cecs_relation_pair_iterator_done(const cecs_relation_pair_iterator *it) {
+    return it->current == CECS_RELATION_PAIR_INDEX_NONE;
+}
+cecs_relation_pair *cecs_relation_pair_iterator_current(const cecs_relation_pair_iterator *it);
+cecs_relation_pair_index cecs_relation_pair_iterator_next(cecs_relation_pair_iterator *it);
+
+#endif
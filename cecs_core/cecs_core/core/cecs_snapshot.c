@@ -0,0 +1,774 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+#if defined(_WIN32)
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+#endif
+
+#include "cecs_snapshot.h"
+
+static inline uint64_t cecs_snapshot_align(const uint64_t offset) {
+    return (offset + CECS_SNAPSHOT_SECTION_ALIGNMENT - 1) & ~(uint64_t)(CECS_SNAPSHOT_SECTION_ALIGNMENT - 1);
+}
+
+// NOTE: component sizes are multiples of their alignment, so rounding to the record header keeps
+// every record and its component naturally aligned within the cache line aligned section
+static inline size_t cecs_snapshot_pair_record_size(const size_t component_size) {
+    const size_t alignment = _Alignof(cecs_snapshot_pair_record);
+    return (sizeof(cecs_snapshot_pair_record) + component_size + alignment - 1) & ~(alignment - 1);
+}
+
+// NOTE: FNV-1a, type names only need to be told apart from each other
+static uint64_t cecs_snapshot_name_hash(const char *name) {
+    uint64_t hash = 0xCBF29CE484222325ull;
+    for (const char *c = name; *c != '\0'; ++c) {
+        hash ^= (uint64_t)(uint8_t)*c;
+        hash *= 0x100000001B3ull;
+    }
+    return hash;
+}
+
+static inline cecs_snapshot_range cecs_snapshot_range_from(const cecs_range range) {
+    return (cecs_snapshot_range){ .start = (int64_t)range.start, .end = (int64_t)range.end };
+}
+
+static inline cecs_exclusive_range cecs_snapshot_range_to_exclusive(const cecs_snapshot_range range) {
+    return (cecs_exclusive_range){ .start = (cecs_ssize_t)range.start, .end = (cecs_ssize_t)range.end };
+}
+
+static cecs_flatmap_iterator cecs_snapshot_flatmap_iterator_first(cecs_flatmap *m) {
+    cecs_flatmap_iterator it = cecs_flatmap_iterator_create_at(m, 0);
+    if (m->count > 0 && !m->ctrl_and_hash_values[0].any.occupied) {
+        cecs_flatmap_iterator_next_occupied(&it);
+    }
+    return it;
+}
+
+typedef struct cecs_snapshot_writer {
+    cecs_arena arena;
+    cecs_dynamic_array sections;
+    cecs_dynamic_array payloads;
+} cecs_snapshot_writer;
+
+static void cecs_snapshot_writer_add(cecs_snapshot_writer *writer, cecs_snapshot_section section, const void *payload) {
+    assert((section.size == 0 || payload != NULL) && "error: snapshot section has a size but no payload");
+    CECS_DYNAMIC_ARRAY_ADD(cecs_snapshot_section, &writer->sections, &writer->arena, &section);
+    CECS_DYNAMIC_ARRAY_ADD(const void *, &writer->payloads, &writer->arena, &payload);
+}
+
+static void cecs_snapshot_writer_add_types(cecs_snapshot_writer *writer, const cecs_snapshot_type types[], const size_t type_count) {
+    cecs_snapshot_type_record *records = cecs_arena_alloc(&writer->arena, (type_count + 1) * sizeof(cecs_snapshot_type_record));
+    for (size_t i = 0; i < type_count; ++i) {
+        records[i] = (cecs_snapshot_type_record){
+            .name_hash = cecs_snapshot_name_hash(types[i].name),
+            .id = (uint64_t)types[i].id,
+            .size = (uint64_t)types[i].size
+        };
+    }
+    cecs_snapshot_writer_add(writer, (cecs_snapshot_section){
+        .kind = cecs_snapshot_section_kind_types,
+        .size = type_count * sizeof(cecs_snapshot_type_record),
+        .element_size = sizeof(cecs_snapshot_type_record)
+    }, records);
+}
+
+static void cecs_snapshot_writer_add_entities(cecs_snapshot_writer *writer, cecs_world_entities *we) {
+    // NOTE: stacked single free ids are saved as part of the free ranges
+    cecs_world_entities_coalesce_free_ids(we);
+    const size_t entity_count = cecs_world_entities_count(we);
+    cecs_snapshot_writer_add(writer, (cecs_snapshot_section){
+        .kind = cecs_snapshot_section_kind_entity_ids,
+        .size = entity_count * sizeof(cecs_entity_id),
+        .element_size = sizeof(cecs_entity_id)
+    }, cecs_sparse_set_values(&we->entity_ids));
+
+    cecs_snapshot_writer_add(writer, (cecs_snapshot_section){
+        .kind = cecs_snapshot_section_kind_entity_generations,
+        .size = we->generations.count,
+        .element_size = sizeof(cecs_entity_generation)
+    }, we->generations.values);
+
+    const size_t free_range_count = cecs_range_set_range_count(&we->free_entity_id_ranges);
+    cecs_snapshot_range *free_ranges = cecs_arena_alloc(&writer->arena, (free_range_count + 1) * sizeof(cecs_snapshot_range));
+    for (size_t i = 0; i < free_range_count; ++i) {
+        free_ranges[i] = cecs_snapshot_range_from(cecs_range_set_get(&we->free_entity_id_ranges, i).range);
+    }
+    cecs_snapshot_writer_add(writer, (cecs_snapshot_section){
+        .kind = cecs_snapshot_section_kind_free_entity_id_ranges,
+        .size = free_range_count * sizeof(cecs_snapshot_range),
+        .element_size = sizeof(cecs_snapshot_range)
+    }, free_ranges);
+}
+
+static void cecs_snapshot_writer_add_storages(cecs_snapshot_writer *writer, cecs_world_components *wc) {
+    const cecs_sized_component_storage *storages = cecs_paged_sparse_set_values(&wc->component_storages);
+    const size_t storage_count = cecs_world_components_get_component_storage_count(wc);
+    for (size_t i = 0; i < storage_count; ++i) {
+        const cecs_sized_component_storage *storage = &storages[i];
+        const cecs_component_id component_id =
+            (cecs_component_id)cecs_sparse_set_base_key_unchecked(&wc->component_storages.base, i);
+
+        cecs_snapshot_section section = {
+            .kind = cecs_snapshot_section_kind_storage,
+            .id = (uint64_t)component_id,
+            .element_size = (uint64_t)storage->component_size,
+        };
+        const void *payload = NULL;
+        CECS_UNION_MATCH(storage->storage.storage) {
+            case CECS_UNION_VARIANT(cecs_sparse_component_storage, cecs_component_storage_union): {
+                const cecs_sentinel_set *components =
+                    &CECS_UNION_GET_UNCHECKED(cecs_sparse_component_storage, storage->storage.storage).components;
+                section.variant = cecs_snapshot_storage_kind_sparse;
+                section.range = cecs_snapshot_range_from(components->index_range.range);
+                section.set_range = cecs_snapshot_range_from(components->first_last_set.range);
+                section.size = components->values.count;
+                payload = components->values.values;
+                break;
+            }
+            case CECS_UNION_VARIANT(cecs_unit_component_storage, cecs_component_storage_union): {
+                section.variant = cecs_snapshot_storage_kind_unit;
+                break;
+            }
+            case CECS_UNION_VARIANT(cecs_indirect_component_storage, cecs_component_storage_union): {
+                // NOTE: only the referenced entity ids are written, component references are pointers and get rebuilt on load
+                const cecs_indirect_component_storage *indirect =
+                    &CECS_UNION_GET_UNCHECKED(cecs_indirect_component_storage, storage->storage.storage);
+                const size_t referenced_index =
+                    (size_t)((const cecs_sized_component_storage *)indirect->referenced_storage - storages);
+                section.variant = cecs_snapshot_storage_kind_indirect;
+                section.reference_id =
+                    (uint64_t)cecs_sparse_set_base_key_unchecked(&wc->component_storages.base, referenced_index);
+                section.range = cecs_snapshot_range_from(indirect->component_indices.index_range.range);
+                section.set_range = cecs_snapshot_range_from(indirect->component_indices.first_last_set.range);
+                section.size = indirect->component_indices.values.count;
+                payload = indirect->component_indices.values.values;
+                break;
+            }
+            default: {
+                assert(false && "unreachable: invalid component storage variant");
+                exit(EXIT_FAILURE);
+            }
+        }
+        cecs_snapshot_writer_add(writer, section, payload);
+
+        // NOTE: layers directly follow their storage section
+        for (uint32_t layer = 0; layer < CECS_BIT_LAYER_COUNT; ++layer) {
+            const cecs_bitset *bitset = &storage->storage.entity_bitset.bitsets[layer];
+            if (cecs_exclusive_range_is_empty(bitset->word_range)) {
+                continue;
+            }
+            cecs_snapshot_writer_add(writer, (cecs_snapshot_section){
+                .kind = cecs_snapshot_section_kind_storage_bitset_layer,
+                .id = (uint64_t)component_id,
+                .variant = layer,
+                .range = cecs_snapshot_range_from(bitset->word_range.range),
+                .size = bitset->bit_words.count,
+                .element_size = sizeof(cecs_bit_word)
+            }, bitset->bit_words.values);
+        }
+    }
+}
+
+static void cecs_snapshot_writer_add_relations(cecs_snapshot_writer *writer, cecs_world_relations *wr) {
+    cecs_dynamic_array targets = cecs_dynamic_array_create();
+    cecs_flatmap_iterator it = cecs_snapshot_flatmap_iterator_first(&wr->associations.entity_to_target_holders);
+    for (size_t visited = 0; !cecs_flatmap_iterator_done_occupied(&it, visited); ++visited, cecs_flatmap_iterator_next_occupied(&it)) {
+        const uint64_t source = (uint64_t)cecs_flatmap_iterator_current_hash(&it, sizeof(cecs_entity_associated_holders))->hash;
+        const cecs_entity_associated_holders *holders =
+            cecs_flatmap_iterator_current_value(&it, sizeof(cecs_entity_associated_holders));
+        const cecs_target_holder_info *infos = cecs_sparse_set_values(&holders->target_to_holder);
+        const size_t target_count = cecs_sparse_set_count_of_size(&holders->target_to_holder, sizeof(cecs_target_holder_info));
+        for (size_t i = 0; i < target_count; ++i) {
+            CECS_DYNAMIC_ARRAY_ADD(cecs_snapshot_relation_target_record, &targets, &writer->arena, (&(cecs_snapshot_relation_target_record){
+                .source = source,
+                .target = (uint64_t)cecs_sparse_set_key_unchecked(&holders->target_to_holder, i),
+                .holder = (uint64_t)infos[i].holder,
+                .target_kind = (uint64_t)infos[i].target_kind
+            }));
+        }
+    }
+    cecs_snapshot_writer_add(writer, (cecs_snapshot_section){
+        .kind = cecs_snapshot_section_kind_relation_targets,
+        .size = targets.count,
+        .element_size = sizeof(cecs_snapshot_relation_target_record)
+    }, targets.values);
+
+    cecs_dynamic_array policies = cecs_dynamic_array_create();
+    it = cecs_snapshot_flatmap_iterator_first(&wr->cleanup_policies);
+    for (size_t visited = 0; !cecs_flatmap_iterator_done_occupied(&it, visited); ++visited, cecs_flatmap_iterator_next_occupied(&it)) {
+        CECS_DYNAMIC_ARRAY_ADD(cecs_snapshot_cleanup_policy_record, &policies, &writer->arena, (&(cecs_snapshot_cleanup_policy_record){
+            .component_id = (uint64_t)cecs_flatmap_iterator_current_hash(&it, sizeof(cecs_relation_cleanup_policy))->hash,
+            .policy = (uint64_t)*(cecs_relation_cleanup_policy *)cecs_flatmap_iterator_current_value(&it, sizeof(cecs_relation_cleanup_policy))
+        }));
+    }
+    cecs_snapshot_writer_add(writer, (cecs_snapshot_section){
+        .kind = cecs_snapshot_section_kind_relation_cleanup_policies,
+        .size = policies.count,
+        .element_size = sizeof(cecs_snapshot_cleanup_policy_record)
+    }, policies.values);
+
+    cecs_snapshot_writer_add(writer, (cecs_snapshot_section){
+        .kind = cecs_snapshot_section_kind_relation_recycled_holders,
+        .size = wr->recycled_holders.count,
+        .element_size = sizeof(cecs_target_holder_id)
+    }, wr->recycled_holders.values);
+
+    for (size_t i = 0; i < cecs_relation_pair_tables_count(&wr->pair_tables); ++i) {
+        cecs_relation_pair_table *table = cecs_relation_pair_tables_at(&wr->pair_tables, i);
+        const size_t record_size = cecs_snapshot_pair_record_size(table->component_size);
+        const size_t pair_count = cecs_flatmap_occupied_count(&table->pairs);
+        uint8_t *records = cecs_arena_alloc(&writer->arena, (pair_count + 1) * record_size);
+        memset(records, 0, (pair_count + 1) * record_size);
+
+        cecs_flatmap_iterator pair_it = cecs_snapshot_flatmap_iterator_first(&table->pairs);
+        for (
+            size_t visited = 0;
+            !cecs_flatmap_iterator_done_occupied(&pair_it, visited);
+            ++visited, cecs_flatmap_iterator_next_occupied(&pair_it)
+        ) {
+            cecs_relation_pair *pair = cecs_flatmap_iterator_current_value(&pair_it, table->pair_size);
+            cecs_snapshot_pair_record *record = (cecs_snapshot_pair_record *)(records + visited * record_size);
+            *record = (cecs_snapshot_pair_record){ .source = (uint64_t)cecs_relation_pair_source_id(pair), .target = (uint64_t)cecs_relation_pair_target_id(pair) };
+            if (table->component_size > 0) {
+                memcpy(record + 1, cecs_relation_pair_component(pair), table->component_size);
+            }
+        }
+        cecs_snapshot_writer_add(writer, (cecs_snapshot_section){
+            .kind = cecs_snapshot_section_kind_relation_pairs,
+            .id = (uint64_t)table->component_id,
+            .reference_id = (uint64_t)table->component_size,
+            .size = pair_count * record_size,
+            .element_size = record_size
+        }, records);
+    }
+}
+
+static bool cecs_snapshot_is_event_channel(const cecs_world_events *we, const cecs_resource_id id) {
+    for (size_t i = 0; i < cecs_world_events_event_channel_count(we); ++i) {
+        if (cecs_world_events_event_channel_id(we, i) == id) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void cecs_snapshot_writer_add_resources(cecs_snapshot_writer *writer, const cecs_world_resources *wr, const cecs_world_events *we) {
+    const cecs_exclusive_range resource_range = cecs_paged_sentinel_set_index_range(&wr->resource_handles);
+    for (cecs_ssize_t i = resource_range.start; i < resource_range.end; ++i) {
+        const cecs_resource_id id = (cecs_resource_id)i;
+        if (!cecs_world_resources_has_resource(wr, id) || cecs_snapshot_is_event_channel(we, id)) {
+            continue;
+        }
+        const size_t size = cecs_world_resources_get_resource_size(wr, id);
+        cecs_snapshot_writer_add(writer, (cecs_snapshot_section){
+            .kind = cecs_snapshot_section_kind_resource,
+            .id = (uint64_t)id,
+            .size = size,
+            .element_size = size
+        }, cecs_world_resources_get_resource(wr, id));
+    }
+}
+
+static FILE *cecs_snapshot_file_open(const char *path, const char *mode) {
+#if defined(_MSC_VER)
+    FILE *file;
+    return fopen_s(&file, path, mode) == 0 ? file : NULL;
+#else
+    return fopen(path, mode);
+#endif
+}
+
+static bool cecs_snapshot_file_pad_to(FILE *file, uint64_t *position, const uint64_t offset) {
+    static const uint8_t zeros[CECS_SNAPSHOT_SECTION_ALIGNMENT] = { 0 };
+    assert(offset >= *position && offset - *position <= CECS_SNAPSHOT_SECTION_ALIGNMENT && "error: snapshot padding out of order");
+    const size_t padding = (size_t)(offset - *position);
+    *position = offset;
+    return padding == 0 || fwrite(zeros, 1, padding, file) == padding;
+}
+
+static cecs_snapshot_status cecs_snapshot_writer_write(cecs_snapshot_writer *writer, const char *path) {
+    const size_t section_count = CECS_DYNAMIC_ARRAY_COUNT(cecs_snapshot_section, &writer->sections);
+    cecs_snapshot_section *sections = (cecs_snapshot_section *)writer->sections.values;
+    const void *const *payloads = (const void *const *)writer->payloads.values;
+
+    const uint64_t section_table_offset = cecs_snapshot_align(sizeof(cecs_snapshot_header));
+    uint64_t offset = section_table_offset + section_count * sizeof(cecs_snapshot_section);
+    for (size_t i = 0; i < section_count; ++i) {
+        offset = cecs_snapshot_align(offset);
+        sections[i].offset = offset;
+        offset += sections[i].size;
+    }
+    const cecs_snapshot_header header = {
+        .magic = CECS_SNAPSHOT_MAGIC,
+        .version = CECS_SNAPSHOT_VERSION,
+        .byte_order = CECS_SNAPSHOT_BYTE_ORDER,
+        .entity_id_size = sizeof(cecs_entity_id),
+        .component_id_size = sizeof(cecs_component_id),
+        .bit_word_size = sizeof(cecs_bit_word),
+        .bit_layer_count = CECS_BIT_LAYER_COUNT,
+        .section_count = section_count,
+        .section_table_offset = section_table_offset,
+        .file_size = offset
+    };
+
+    FILE *file = cecs_snapshot_file_open(path, "wb");
+    if (file == NULL) {
+        return cecs_snapshot_status_io_error;
+    }
+    uint64_t position = sizeof(cecs_snapshot_header);
+    bool written = fwrite(&header, sizeof(cecs_snapshot_header), 1, file) == 1
+        && cecs_snapshot_file_pad_to(file, &position, section_table_offset)
+        && (section_count == 0 || fwrite(sections, sizeof(cecs_snapshot_section), section_count, file) == section_count);
+    position += section_count * sizeof(cecs_snapshot_section);
+    for (size_t i = 0; written && i < section_count; ++i) {
+        written = cecs_snapshot_file_pad_to(file, &position, sections[i].offset)
+            && (sections[i].size == 0 || fwrite(payloads[i], 1, (size_t)sections[i].size, file) == sections[i].size);
+        position += sections[i].size;
+    }
+    written = (fclose(file) == 0) && written;
+    return written ? cecs_snapshot_status_ok : cecs_snapshot_status_io_error;
+}
+
+cecs_snapshot_status cecs_world_save_snapshot(cecs_world *w, const char *path, const cecs_snapshot_type types[], const size_t type_count) {
+    cecs_snapshot_writer writer = {
+        .arena = cecs_arena_create(),
+        .sections = cecs_dynamic_array_create(),
+        .payloads = cecs_dynamic_array_create()
+    };
+    cecs_snapshot_writer_add_types(&writer, types, type_count);
+    cecs_snapshot_writer_add_entities(&writer, &w->entities);
+    cecs_snapshot_writer_add_storages(&writer, &w->components);
+    cecs_snapshot_writer_add_relations(&writer, &w->relations);
+    cecs_snapshot_writer_add_resources(&writer, &w->resources, &w->events);
+
+    const cecs_snapshot_status status = cecs_snapshot_writer_write(&writer, path);
+    cecs_arena_free(&writer.arena);
+    return status;
+}
+
+
+static cecs_snapshot_status cecs_snapshot_validate_layout(const cecs_snapshot *s) {
+    if (s->size < sizeof(cecs_snapshot_header)) {
+        return cecs_snapshot_status_invalid_format;
+    }
+    const cecs_snapshot_header *header = s->header;
+    if (header->magic != CECS_SNAPSHOT_MAGIC) {
+        return cecs_snapshot_status_invalid_format;
+    } else if (header->version != CECS_SNAPSHOT_VERSION) {
+        return cecs_snapshot_status_version_mismatch;
+    } else if (
+        header->byte_order != CECS_SNAPSHOT_BYTE_ORDER
+        || header->entity_id_size != sizeof(cecs_entity_id)
+        || header->component_id_size != sizeof(cecs_component_id)
+        || header->bit_word_size != sizeof(cecs_bit_word)
+        || header->bit_layer_count != CECS_BIT_LAYER_COUNT
+    ) {
+        return cecs_snapshot_status_layout_mismatch;
+    } else if (
+        header->file_size != s->size
+        || header->section_table_offset % CECS_SNAPSHOT_SECTION_ALIGNMENT != 0
+        || header->section_table_offset > s->size
+        || header->section_count > (s->size - header->section_table_offset) / sizeof(cecs_snapshot_section)
+    ) {
+        return cecs_snapshot_status_invalid_format;
+    }
+
+    for (uint64_t i = 0; i < header->section_count; ++i) {
+        const cecs_snapshot_section *section = &s->sections[i];
+        if (
+            section->offset % CECS_SNAPSHOT_SECTION_ALIGNMENT != 0
+            || section->offset > s->size
+            || section->size > s->size - section->offset
+            || (section->element_size != 0 && section->size % section->element_size != 0)
+        ) {
+            return cecs_snapshot_status_invalid_format;
+        }
+    }
+    return cecs_snapshot_status_ok;
+}
+
+cecs_snapshot_status cecs_snapshot_open(const char *path, cecs_snapshot *out_snapshot) {
+    *out_snapshot = (cecs_snapshot){ 0 };
+#if defined(_WIN32)
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
+        return cecs_snapshot_status_io_error;
+    }
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart < (LONGLONG)sizeof(cecs_snapshot_header)) {
+        CloseHandle(file);
+        return file_size.QuadPart < (LONGLONG)sizeof(cecs_snapshot_header)
+            ? cecs_snapshot_status_invalid_format
+            : cecs_snapshot_status_io_error;
+    }
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    const void *data = mapping == NULL ? NULL : MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (data == NULL) {
+        if (mapping != NULL) {
+            CloseHandle(mapping);
+        }
+        CloseHandle(file);
+        return cecs_snapshot_status_io_error;
+    }
+    out_snapshot->file_handle = (intptr_t)file;
+    out_snapshot->mapping_handle = (intptr_t)mapping;
+    out_snapshot->size = (size_t)file_size.QuadPart;
+#else
+    const int file = open(path, O_RDONLY);
+    if (file < 0) {
+        return cecs_snapshot_status_io_error;
+    }
+    struct stat file_stat;
+    if (fstat(file, &file_stat) != 0 || file_stat.st_size < (off_t)sizeof(cecs_snapshot_header)) {
+        close(file);
+        return file_stat.st_size < (off_t)sizeof(cecs_snapshot_header)
+            ? cecs_snapshot_status_invalid_format
+            : cecs_snapshot_status_io_error;
+    }
+    const void *data = mmap(NULL, (size_t)file_stat.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+    if (data == MAP_FAILED) {
+        close(file);
+        return cecs_snapshot_status_io_error;
+    }
+    out_snapshot->file_handle = (intptr_t)file;
+    out_snapshot->mapping_handle = -1;
+    out_snapshot->size = (size_t)file_stat.st_size;
+#endif
+    out_snapshot->data = data;
+    out_snapshot->header = (const cecs_snapshot_header *)data;
+    out_snapshot->sections = (const cecs_snapshot_section *)(out_snapshot->data + out_snapshot->header->section_table_offset);
+
+    const cecs_snapshot_status status = cecs_snapshot_validate_layout(out_snapshot);
+    if (status != cecs_snapshot_status_ok) {
+        cecs_snapshot_close(out_snapshot);
+    }
+    return status;
+}
+
+void cecs_snapshot_close(cecs_snapshot *s) {
+    if (s->data == NULL) {
+        return;
+    }
+#if defined(_WIN32)
+    UnmapViewOfFile(s->data);
+    CloseHandle((HANDLE)s->mapping_handle);
+    CloseHandle((HANDLE)s->file_handle);
+#else
+    munmap((void *)s->data, s->size);
+    close((int)s->file_handle);
+#endif
+    *s = (cecs_snapshot){ 0 };
+}
+
+bool cecs_snapshot_find_section(
+    const cecs_snapshot *s,
+    const cecs_snapshot_section_kind kind,
+    const uint64_t id,
+    const uint32_t variant,
+    const cecs_snapshot_section **out_section
+) {
+    for (uint64_t i = 0; i < s->header->section_count; ++i) {
+        const cecs_snapshot_section *section = &s->sections[i];
+        if (section->kind == (uint32_t)kind && section->id == id && section->variant == variant) {
+            *out_section = section;
+            return true;
+        }
+    }
+    *out_section = NULL;
+    return false;
+}
+
+static bool cecs_snapshot_find_storage_section(const cecs_snapshot *s, const cecs_component_id component_id, size_t *out_index) {
+    for (uint64_t i = 0; i < s->header->section_count; ++i) {
+        if (s->sections[i].kind == cecs_snapshot_section_kind_storage && s->sections[i].id == (uint64_t)component_id) {
+            *out_index = (size_t)i;
+            return true;
+        }
+    }
+    *out_index = (size_t)s->header->section_count;
+    return false;
+}
+
+cecs_snapshot_status cecs_snapshot_validate_types(const cecs_snapshot *s, const cecs_snapshot_type types[], const size_t type_count) {
+    const cecs_snapshot_section *types_section;
+    if (!cecs_snapshot_find_section(s, cecs_snapshot_section_kind_types, 0, 0, &types_section)) {
+        return cecs_snapshot_status_invalid_format;
+    }
+    const cecs_snapshot_type_record *records = cecs_snapshot_section_data(s, types_section);
+    const size_t record_count = cecs_snapshot_section_count_of_size(types_section, sizeof(cecs_snapshot_type_record));
+    for (size_t i = 0; i < type_count; ++i) {
+        const uint64_t name_hash = cecs_snapshot_name_hash(types[i].name);
+        for (size_t j = 0; j < record_count; ++j) {
+            if (records[j].name_hash == name_hash && (records[j].id != (uint64_t)types[i].id || records[j].size != (uint64_t)types[i].size)) {
+                return cecs_snapshot_status_type_mismatch;
+            }
+        }
+
+        size_t storage_index;
+        if (
+            cecs_snapshot_find_storage_section(s, types[i].id, &storage_index)
+            && s->sections[storage_index].variant != cecs_snapshot_storage_kind_indirect
+            && s->sections[storage_index].element_size != (uint64_t)types[i].size
+        ) {
+            return cecs_snapshot_status_type_mismatch;
+        }
+    }
+    return cecs_snapshot_status_ok;
+}
+
+static cecs_hibitset cecs_snapshot_storage_bitset_view(const cecs_snapshot *s, const size_t storage_section_index) {
+    cecs_hibitset bitset = cecs_hibitset_empty();
+    const uint64_t component_id = s->sections[storage_section_index].id;
+    for (
+        uint64_t i = storage_section_index + 1;
+        i < s->header->section_count
+        && s->sections[i].kind == cecs_snapshot_section_kind_storage_bitset_layer
+        && s->sections[i].id == component_id;
+        ++i
+    ) {
+        const cecs_snapshot_section *section = &s->sections[i];
+        assert(section->variant < CECS_BIT_LAYER_COUNT && "error: snapshot bitset layer out of bounds");
+        bitset.bitsets[section->variant] = (cecs_bitset){
+            .bit_words = (cecs_dynamic_array){
+                .values = (uint8_t *)cecs_snapshot_section_data(s, section),
+                .count = (size_t)section->size,
+                .capacity = (size_t)section->size
+            },
+            .word_range = cecs_snapshot_range_to_exclusive(section->range)
+        };
+    }
+    return bitset;
+}
+
+bool cecs_snapshot_get_storage_view(const cecs_snapshot *s, const cecs_component_id component_id, cecs_snapshot_storage_view *out_view) {
+    size_t index;
+    if (!cecs_snapshot_find_storage_section(s, component_id, &index)) {
+        *out_view = (cecs_snapshot_storage_view){ 0 };
+        return false;
+    }
+    const cecs_snapshot_section *section = &s->sections[index];
+    *out_view = (cecs_snapshot_storage_view){
+        .component_id = component_id,
+        .component_size = (size_t)section->element_size,
+        .kind = (cecs_snapshot_storage_kind)section->variant,
+        .entity_bitset = cecs_snapshot_storage_bitset_view(s, index),
+        .components = section->size == 0 ? NULL : cecs_snapshot_section_data(s, section),
+        .index_range = cecs_snapshot_range_to_exclusive(section->range)
+    };
+    return true;
+}
+
+
+static void cecs_snapshot_load_entities(cecs_world_entities *we, const cecs_snapshot *s) {
+    const cecs_snapshot_section *ids;
+    const cecs_snapshot_section *generations;
+    const cecs_snapshot_section *free_ranges;
+    if (
+        !cecs_snapshot_find_section(s, cecs_snapshot_section_kind_entity_ids, 0, 0, &ids)
+        || !cecs_snapshot_find_section(s, cecs_snapshot_section_kind_entity_generations, 0, 0, &generations)
+        || !cecs_snapshot_find_section(s, cecs_snapshot_section_kind_free_entity_id_ranges, 0, 0, &free_ranges)
+    ) {
+        assert(false && "unreachable: validated snapshot is missing entity sections");
+        exit(EXIT_FAILURE);
+    }
+
+    const size_t free_range_count = cecs_snapshot_section_count_of_size(free_ranges, sizeof(cecs_snapshot_range));
+    const cecs_snapshot_range *saved_ranges = cecs_snapshot_section_data(s, free_ranges);
+    cecs_entity_id_range *ranges = calloc(free_range_count + 1, sizeof(cecs_entity_id_range));
+    for (size_t i = 0; i < free_range_count; ++i) {
+        ranges[i] = cecs_snapshot_range_to_exclusive(saved_ranges[i]);
+    }
+    cecs_world_entities_restore(
+        we,
+        cecs_snapshot_section_data(s, ids),
+        cecs_snapshot_section_count_of_size(ids, sizeof(cecs_entity_id)),
+        cecs_snapshot_section_data(s, generations),
+        cecs_snapshot_section_count_of_size(generations, sizeof(cecs_entity_generation)),
+        ranges,
+        free_range_count
+    );
+    free(ranges);
+}
+
+static void cecs_snapshot_load_storage(cecs_world_components *wc, const cecs_snapshot *s, const size_t section_index) {
+    const cecs_snapshot_section *section = &s->sections[section_index];
+    const cecs_component_id component_id = (cecs_component_id)section->id;
+    const cecs_exclusive_range index_range = cecs_snapshot_range_to_exclusive(section->range);
+    const uint8_t *data = cecs_snapshot_section_data(s, section);
+
+    cecs_component_storage_descriptor descriptor = {
+        .capacity = (size_t)cecs_exclusive_range_length(index_range),
+        .config = CECS_COMPONENT_CONFIG_DEFAULT,
+        .is_size_known = true
+    };
+    if (section->variant == cecs_snapshot_storage_kind_indirect) {
+        descriptor.capacity = 1;
+        descriptor.indirect_component_id =
+            CECS_OPTION_CREATE_SOME_STRUCT(cecs_indirect_component_id, (cecs_component_id)section->reference_id);
+    }
+    cecs_sized_component_storage *storage =
+        cecs_world_components_get_or_set_component_storage(wc, component_id, descriptor, (size_t)section->element_size);
+
+    switch (section->variant) {
+    case cecs_snapshot_storage_kind_sparse: {
+        if (section->size == 0) {
+            break;
+        }
+        cecs_sentinel_set *components = &CECS_UNION_GET_UNCHECKED(cecs_sparse_component_storage, storage->storage.storage).components;
+        assert(cecs_sentinel_set_is_empty(components) && "error: snapshot storages load into empty storages only");
+        memcpy(
+            cecs_sentinel_set_expand_to_include(
+                components, &wc->components_arena, cecs_inclusive_range_from_exclusive(index_range.range), (size_t)section->element_size, 0
+            ),
+            data,
+            (size_t)section->size
+        );
+        components->first_last_set = (cecs_inclusive_range){ .start = section->set_range.start, .end = section->set_range.end };
+        break;
+    }
+    case cecs_snapshot_storage_kind_unit:
+        break;
+    case cecs_snapshot_storage_kind_indirect: {
+        // NOTE: references point into the referenced storage, they are resolved one entity at a time
+        cecs_indirect_component_storage *indirect = &CECS_UNION_GET_UNCHECKED(cecs_indirect_component_storage, storage->storage.storage);
+        const cecs_entity_id *referenced_ids = (const cecs_entity_id *)data;
+        for (cecs_ssize_t i = index_range.start; i < index_range.end; ++i) {
+            const cecs_entity_id referenced_id = referenced_ids[i - index_range.start];
+            if (referenced_id != CECS_ENTITY_ID_MAX) {
+                cecs_indirect_component_storage_set(indirect, &wc->components_arena, (cecs_entity_id)i, &referenced_id, sizeof(cecs_entity_id));
+            }
+        }
+        break;
+    }
+    default: {
+        assert(false && "unreachable: invalid snapshot storage kind");
+        exit(EXIT_FAILURE);
+    }
+    }
+
+    const cecs_hibitset saved_bitset = cecs_snapshot_storage_bitset_view(s, section_index);
+    for (size_t layer = 0; layer < CECS_BIT_LAYER_COUNT; ++layer) {
+        const cecs_bitset *saved = &saved_bitset.bitsets[layer];
+        cecs_bitset *bitset = &storage->storage.entity_bitset.bitsets[layer];
+        cecs_dynamic_array_clear(&bitset->bit_words);
+        if (saved->bit_words.count > 0) {
+            CECS_DYNAMIC_ARRAY_ADD_RANGE(
+                cecs_bit_word,
+                &bitset->bit_words,
+                &wc->components_arena,
+                saved->bit_words.values,
+                CECS_DYNAMIC_ARRAY_COUNT(cecs_bit_word, &saved->bit_words)
+            );
+        }
+        bitset->word_range = saved->word_range;
+    }
+
+    cecs_hibitset_iterator it = cecs_hibitset_iterator_create_borrowed_at_first(&storage->storage.entity_bitset);
+    if (!cecs_hibitset_iterator_done(&it) && !cecs_hibitset_iterator_current_is_set(&it)) {
+        cecs_hibitset_iterator_next_set(&it);
+    }
+    for (; !cecs_hibitset_iterator_done(&it); cecs_hibitset_iterator_next_set(&it)) {
+        cecs_world_components_entity_signature_add(wc, (cecs_entity_id)cecs_hibitset_iterator_current(&it), component_id);
+    }
+    wc->checksum = cecs_world_components_checksum_add(wc->checksum, component_id);
+}
+
+static void cecs_snapshot_load_relations(cecs_world_relations *wr, const cecs_snapshot *s, const cecs_snapshot_section *section) {
+    switch (section->kind) {
+    case cecs_snapshot_section_kind_relation_targets: {
+        const cecs_snapshot_relation_target_record *records = cecs_snapshot_section_data(s, section);
+        for (size_t i = 0; i < cecs_snapshot_section_count_of_size(section, sizeof(cecs_snapshot_relation_target_record)); ++i) {
+            cecs_world_relations_add_target_holder(
+                wr,
+                (cecs_entity_id)records[i].source,
+                (cecs_relation_target){ .tag_id = (cecs_tag_id)records[i].target },
+                (cecs_relation_target_kind)records[i].target_kind,
+                (cecs_target_holder_id)records[i].holder
+            );
+        }
+        break;
+    }
+    case cecs_snapshot_section_kind_relation_cleanup_policies: {
+        const cecs_snapshot_cleanup_policy_record *records = cecs_snapshot_section_data(s, section);
+        for (size_t i = 0; i < cecs_snapshot_section_count_of_size(section, sizeof(cecs_snapshot_cleanup_policy_record)); ++i) {
+            cecs_world_relations_set_cleanup_policy(
+                wr, (cecs_component_id)records[i].component_id, (cecs_relation_cleanup_policy)records[i].policy
+            );
+        }
+        break;
+    }
+    case cecs_snapshot_section_kind_relation_recycled_holders:
+        cecs_world_relations_recycle_holders(
+            wr, cecs_snapshot_section_data(s, section), cecs_snapshot_section_count_of_size(section, sizeof(cecs_target_holder_id))
+        );
+        break;
+    case cecs_snapshot_section_kind_relation_pairs: {
+        cecs_relation_pair_table *table = cecs_relation_pair_tables_get_or_add(
+            &wr->pair_tables, &wr->associations_arena, (cecs_component_id)section->id, (size_t)section->reference_id
+        );
+        const uint8_t *records = cecs_snapshot_section_data(s, section);
+        for (size_t i = 0; i < cecs_snapshot_section_count_of_size(section, (size_t)section->element_size); ++i) {
+            const cecs_snapshot_pair_record *record = (const cecs_snapshot_pair_record *)(records + i * section->element_size);
+            cecs_relation_pair_table_set(
+                table, &wr->associations_arena, (cecs_entity_id)record->source, (cecs_entity_id)record->target, record + 1, &(bool){ false }
+            );
+        }
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+cecs_snapshot_status cecs_world_load_snapshot(cecs_world *w, const cecs_snapshot *s, const cecs_snapshot_type types[], const size_t type_count) {
+    assert(cecs_world_entity_count(w) == 0 && "error: snapshots load into empty worlds only");
+    cecs_snapshot_status status = cecs_snapshot_validate_types(s, types, type_count);
+    if (status != cecs_snapshot_status_ok) {
+        return status;
+    }
+
+    // NOTE: storages the world already has must agree with the saved sizes before anything is loaded
+    const size_t section_count = (size_t)s->header->section_count;
+    for (size_t i = 0; i < section_count; ++i) {
+        const cecs_snapshot_section *section = &s->sections[i];
+        cecs_optional_component_storage existing;
+        if (
+            section->kind == cecs_snapshot_section_kind_storage
+            && CECS_OPTION_IS_SOME(
+                cecs_optional_component_storage,
+                (existing = cecs_world_components_get_component_storage(&w->components, (cecs_component_id)section->id))
+            )
+            && CECS_OPTION_GET_UNCHECKED(cecs_optional_component_storage, existing)->component_size != (size_t)section->element_size
+        ) {
+            return cecs_snapshot_status_type_mismatch;
+        }
+    }
+
+    cecs_snapshot_load_entities(&w->entities, s);
+    // NOTE: indirect storages need their referenced storages loaded first
+    for (size_t i = 0; i < section_count; ++i) {
+        if (s->sections[i].kind == cecs_snapshot_section_kind_storage && s->sections[i].variant != cecs_snapshot_storage_kind_indirect) {
+            cecs_snapshot_load_storage(&w->components, s, i);
+        }
+    }
+    for (size_t i = 0; i < section_count; ++i) {
+        const cecs_snapshot_section *section = &s->sections[i];
+        if (section->kind == cecs_snapshot_section_kind_storage && section->variant == cecs_snapshot_storage_kind_indirect) {
+            cecs_snapshot_load_storage(&w->components, s, i);
+        } else if (section->kind == cecs_snapshot_section_kind_resource) {
+            cecs_world_resources_set_resource(
+                &w->resources, (cecs_resource_id)section->id, (void *)cecs_snapshot_section_data(s, section), (size_t)section->size
+            );
+        } else {
+            cecs_snapshot_load_relations(&w->relations, s, section);
+        }
+    }
+    return cecs_snapshot_status_ok;
+}
@@ -0,0 +1,188 @@
+#ifndef CECS_SNAPSHOT_H
+#define CECS_SNAPSHOT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <assert.h>
+#include "../containers/cecs_bitset.h"
+#include "../containers/cecs_range.h"
+#include "component/entity/cecs_entity.h"
+#include "component/cecs_component.h"
+#include "resource/cecs_resource.h"
+#include "cecs_world.h"
+
+#define CECS_SNAPSHOT_MAGIC ((uint64_t)0x50414E5353434543) // "CECSSNAP"
+#define CECS_SNAPSHOT_VERSION 3
+#define CECS_SNAPSHOT_BYTE_ORDER ((uint32_t)0x01020304)
+// NOTE: every section starts on its own cache line, mapped files are page aligned so section payloads are too
+#define CECS_SNAPSHOT_SECTION_ALIGNMENT 64
+
+typedef enum cecs_snapshot_status {
+    cecs_snapshot_status_ok,
+    cecs_snapshot_status_io_error,
+    cecs_snapshot_status_invalid_format,
+    cecs_snapshot_status_version_mismatch,
+    cecs_snapshot_status_layout_mismatch,
+    cecs_snapshot_status_type_mismatch,
+    cecs_snapshot_status_out_of_order,
+} cecs_snapshot_status;
+
+typedef enum cecs_snapshot_section_kind {
+    cecs_snapshot_section_kind_types,
+    cecs_snapshot_section_kind_entity_ids,
+    cecs_snapshot_section_kind_entity_generations,
+    cecs_snapshot_section_kind_free_entity_id_ranges,
+    cecs_snapshot_section_kind_storage,
+    cecs_snapshot_section_kind_storage_bitset_layer,
+    cecs_snapshot_section_kind_relation_targets,
+    cecs_snapshot_section_kind_relation_cleanup_policies,
+    cecs_snapshot_section_kind_relation_recycled_holders,
+    cecs_snapshot_section_kind_relation_pairs,
+    cecs_snapshot_section_kind_resource,
+} cecs_snapshot_section_kind;
+
+typedef enum cecs_snapshot_storage_kind {
+    cecs_snapshot_storage_kind_sparse,
+    cecs_snapshot_storage_kind_unit,
+    cecs_snapshot_storage_kind_indirect,
+} cecs_snapshot_storage_kind;
+
+typedef struct cecs_snapshot_range {
+    int64_t start;
+    int64_t end;
+} cecs_snapshot_range;
+
+typedef struct cecs_snapshot_header {
+    uint64_t magic;
+    uint32_t version;
+    uint32_t byte_order;
+    uint32_t entity_id_size;
+    uint32_t component_id_size;
+    uint32_t bit_word_size;
+    uint32_t bit_layer_count;
+    uint64_t section_count;
+    uint64_t section_table_offset;
+    uint64_t file_size;
+} cecs_snapshot_header;
+
+// NOTE: ranges hold the storage index range and first and last set indices, or a bitset layer word range,
+// variant is the storage kind or bitset layer, reference_id the referenced component of indirect storages
+typedef struct cecs_snapshot_section {
+    uint64_t offset;
+    uint64_t size;
+    uint64_t id;
+    uint64_t reference_id;
+    uint64_t element_size;
+    cecs_snapshot_range range;
+    cecs_snapshot_range set_range;
+    uint32_t kind;
+    uint32_t variant;
+} cecs_snapshot_section;
+
+// NOTE: component ids are handed out on first use, registering every snapshot type up front in the same order
+// keeps ids stable across runs; loading rejects snapshots whose types moved to another id or changed size
+typedef struct cecs_snapshot_type {
+    const char *name;
+    cecs_component_id id;
+    size_t size;
+} cecs_snapshot_type;
+#define CECS_SNAPSHOT_TYPE(type) ((cecs_snapshot_type){ .name = #type, .id = CECS_COMPONENT_ID(type), .size = sizeof(type) })
+#define CECS_SNAPSHOT_TAG_TYPE(type) ((cecs_snapshot_type){ .name = #type, .id = CECS_TAG_ID(type), .size = 0 })
+
+typedef struct cecs_snapshot_type_record {
+    uint64_t name_hash;
+    uint64_t id;
+    uint64_t size;
+} cecs_snapshot_type_record;
+
+typedef struct cecs_snapshot_relation_target_record {
+    uint64_t source;
+    uint64_t target;
+    uint64_t holder;
+    uint64_t target_kind;
+} cecs_snapshot_relation_target_record;
+
+typedef struct cecs_snapshot_cleanup_policy_record {
+    uint64_t component_id;
+    uint64_t policy;
+} cecs_snapshot_cleanup_policy_record;
+
+// NOTE: pair records are followed by the pair component and padded to 8 bytes, the section element size is the stride
+typedef struct cecs_snapshot_pair_record {
+    uint64_t source;
+    uint64_t target;
+} cecs_snapshot_pair_record;
+
+// NOTE: event channel resources and storage attachments hold pointers and are not written, resources are written as raw bytes
+cecs_snapshot_status cecs_world_save_snapshot(
+    cecs_world *w,
+    const char *path,
+    const cecs_snapshot_type types[],
+    size_t type_count
+);
+
+// NOTE: a read only mapping of a snapshot file, section payloads are used in place until the snapshot is closed
+typedef struct cecs_snapshot {
+    const uint8_t *data;
+    size_t size;
+    const cecs_snapshot_header *header;
+    const cecs_snapshot_section *sections;
+    intptr_t file_handle;
+    intptr_t mapping_handle;
+} cecs_snapshot;
+
+cecs_snapshot_status cecs_snapshot_open(const char *path, cecs_snapshot *out_snapshot);
+void cecs_snapshot_close(cecs_snapshot *s);
+
+static inline const void *cecs_snapshot_section_data(const cecs_snapshot *s, const cecs_snapshot_section *section) {
+    return s->data + section->offset;
+}
+static inline size_t cecs_snapshot_section_count_of_size(const cecs_snapshot_section *section, const size_t element_size) {
+    return element_size == 0 ? 0 : (size_t)section->size / element_size;
+}
+bool cecs_snapshot_find_section(
+    const cecs_snapshot *s,
+    cecs_snapshot_section_kind kind,
+    uint64_t id,
+    uint32_t variant,
+    const cecs_snapshot_section **out_section
+);
+
+cecs_snapshot_status cecs_snapshot_validate_types(const cecs_snapshot *s, const cecs_snapshot_type types[], size_t type_count);
+
+// NOTE: views borrow the mapped file, the bitset and the components must not be mutated
+typedef struct cecs_snapshot_storage_view {
+    cecs_component_id component_id;
+    size_t component_size;
+    cecs_snapshot_storage_kind kind;
+    cecs_hibitset entity_bitset;
+    const uint8_t *components;
+    cecs_exclusive_range index_range;
+} cecs_snapshot_storage_view;
+
+bool cecs_snapshot_get_storage_view(const cecs_snapshot *s, cecs_component_id component_id, cecs_snapshot_storage_view *out_view);
+
+static inline const void *cecs_snapshot_storage_view_get(const cecs_snapshot_storage_view *v, const cecs_entity_id entity_index) {
+    if (
+        v->kind != cecs_snapshot_storage_kind_sparse
+        || !cecs_exclusive_range_contains(v->index_range, (cecs_ssize_t)entity_index)
+        || !cecs_hibitset_is_set(&v->entity_bitset, (size_t)entity_index)
+    ) {
+        return NULL;
+    }
+    return v->components + ((size_t)((cecs_ssize_t)entity_index - v->index_range.start)) * v->component_size;
+}
+#define CECS_SNAPSHOT_STORAGE_VIEW_GET(type, view_ref, entity_index) \
+    ((const type *)cecs_snapshot_storage_view_get(view_ref, entity_index))
+
+// NOTE: loads into an empty world, component arrays and bitset layers are copied as whole blocks on purpose:
+// the file is mapped read-only and unmapped on close, while world storages live in the world's arenas and are written
+// and grown in place, so the world stays independent of the snapshot; read-only access without copies goes through storage views
+cecs_snapshot_status cecs_world_load_snapshot(
+    cecs_world *w,
+    const cecs_snapshot *s,
+    const cecs_snapshot_type types[],
+    size_t type_count
+);
+
+#endif
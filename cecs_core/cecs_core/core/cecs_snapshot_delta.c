@@ -0,0 +1,577 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "cecs_snapshot_delta.h"
+
+#define CECS_SNAPSHOT_DELTA_VARINT_MAX_SIZE 10
+
+static inline uint64_t cecs_snapshot_delta_zigzag(const int64_t value) {
+    return ((uint64_t)value << 1) ^ (uint64_t)(value >> 63);
+}
+
+static inline int64_t cecs_snapshot_delta_unzigzag(const uint64_t value) {
+    return (int64_t)(value >> 1) ^ -(int64_t)(value & 1);
+}
+
+static inline size_t cecs_snapshot_delta_component_size(const cecs_sized_component_storage *storage) {
+    if (CECS_UNION_IS(cecs_indirect_component_storage, cecs_component_storage_union, storage->storage.storage)) {
+        return CECS_UNION_GET_UNCHECKED(cecs_indirect_component_storage, storage->storage.storage).referenced_size;
+    } else {
+        return storage->component_size;
+    }
+}
+
+typedef struct cecs_snapshot_delta_writer {
+    cecs_dynamic_array *stream;
+    cecs_arena *stream_arena;
+    cecs_entity_id previous_index;
+} cecs_snapshot_delta_writer;
+
+static void cecs_snapshot_delta_writer_varint(cecs_snapshot_delta_writer *writer, uint64_t value) {
+    uint8_t bytes[CECS_SNAPSHOT_DELTA_VARINT_MAX_SIZE];
+    size_t byte_count = 0;
+    do {
+        const uint8_t low = (uint8_t)(value & 0x7F);
+        value >>= 7;
+        bytes[byte_count++] = low | (value != 0 ? 0x80 : 0);
+    } while (value != 0);
+    CECS_DYNAMIC_ARRAY_ADD_RANGE(uint8_t, writer->stream, writer->stream_arena, bytes, byte_count);
+}
+
+static void cecs_snapshot_delta_writer_entity(cecs_snapshot_delta_writer *writer, const cecs_entity_id entity) {
+    const cecs_entity_id index = cecs_entity_id_index(entity);
+    cecs_snapshot_delta_writer_varint(writer, cecs_snapshot_delta_zigzag((int64_t)index - (int64_t)writer->previous_index));
+    cecs_snapshot_delta_writer_varint(writer, (uint64_t)cecs_entity_id_generation(entity));
+    writer->previous_index = index;
+}
+
+static void cecs_snapshot_delta_writer_entities(cecs_snapshot_delta_writer *writer, const cecs_dynamic_array *entities) {
+    const size_t entity_count = CECS_DYNAMIC_ARRAY_COUNT(cecs_entity_id, entities);
+    cecs_snapshot_delta_writer_varint(writer, (uint64_t)entity_count);
+    writer->previous_index = 0;
+    for (size_t i = 0; i < entity_count; ++i) {
+        cecs_snapshot_delta_writer_entity(writer, *CECS_DYNAMIC_ARRAY_GET(cecs_entity_id, entities, i));
+    }
+}
+
+static void cecs_snapshot_delta_collect_removed(
+    const cecs_world_entities *we,
+    const cecs_dynamic_array *records,
+    const cecs_change_tick since_tick,
+    cecs_dynamic_array *out_entities,
+    cecs_arena *scratch_arena
+) {
+    // NOTE: records are in tick order, only the ones after since_tick are looked at
+    size_t first = CECS_DYNAMIC_ARRAY_COUNT(cecs_change_record, records);
+    while (first > 0 && CECS_DYNAMIC_ARRAY_GET(cecs_change_record, records, first - 1)->tick > since_tick) {
+        --first;
+    }
+    for (size_t i = first; i < CECS_DYNAMIC_ARRAY_COUNT(cecs_change_record, records); ++i) {
+        const cecs_entity_id entity = CECS_DYNAMIC_ARRAY_GET(cecs_change_record, records, i)->entity;
+        if (!cecs_world_enities_has_entity(we, entity)) {
+            CECS_DYNAMIC_ARRAY_ADD(cecs_entity_id, out_entities, scratch_arena, &entity);
+        }
+    }
+}
+
+static int cecs_snapshot_delta_compare_indices(const void *a, const void *b) {
+    const cecs_entity_id index_a = *(const cecs_entity_id *)a;
+    const cecs_entity_id index_b = *(const cecs_entity_id *)b;
+    return (index_a > index_b) - (index_a < index_b);
+}
+
+// NOTE: only the records after since_tick are looked at, each index is taken from the record of its latest stamp
+// and the indices are sorted, so entity lists stay delta coded in index order
+static void cecs_snapshot_delta_collect_stamped(
+    const cecs_dynamic_array *ticks,
+    const cecs_dynamic_array *stamped_indices,
+    const cecs_change_tick since_tick,
+    cecs_dynamic_array *out_indices,
+    cecs_arena *scratch_arena
+) {
+    cecs_dynamic_array_clear(out_indices);
+    size_t first = CECS_DYNAMIC_ARRAY_COUNT(cecs_change_record, stamped_indices);
+    while (first > 0 && CECS_DYNAMIC_ARRAY_GET(cecs_change_record, stamped_indices, first - 1)->tick > since_tick) {
+        --first;
+    }
+    for (size_t i = first; i < CECS_DYNAMIC_ARRAY_COUNT(cecs_change_record, stamped_indices); ++i) {
+        const cecs_change_record *record = CECS_DYNAMIC_ARRAY_GET(cecs_change_record, stamped_indices, i);
+        if (*CECS_DYNAMIC_ARRAY_GET(cecs_change_tick, ticks, record->entity) == record->tick) {
+            CECS_DYNAMIC_ARRAY_ADD(cecs_entity_id, out_indices, scratch_arena, &record->entity);
+        }
+    }
+
+    const size_t index_count = CECS_DYNAMIC_ARRAY_COUNT(cecs_entity_id, out_indices);
+    if (index_count > 1) {
+        qsort(out_indices->values, index_count, sizeof(cecs_entity_id), cecs_snapshot_delta_compare_indices);
+    }
+}
+
+static void cecs_snapshot_delta_write_component(
+    cecs_snapshot_delta_writer *writer,
+    cecs_world *w,
+    const cecs_component_changes *changes,
+    const cecs_change_tick since_tick,
+    cecs_dynamic_array *removed,
+    cecs_dynamic_array *set,
+    cecs_dynamic_array *stamped,
+    cecs_arena *scratch_arena
+) {
+    const cecs_component_id component_id = changes->component_id;
+    cecs_dynamic_array_clear(removed);
+    cecs_dynamic_array_clear(set);
+
+    if (since_tick != CECS_CHANGE_TICK_NONE) {
+        size_t first = CECS_DYNAMIC_ARRAY_COUNT(cecs_change_record, &changes->removals);
+        while (first > 0 && CECS_DYNAMIC_ARRAY_GET(cecs_change_record, &changes->removals, first - 1)->tick > since_tick) {
+            --first;
+        }
+        // NOTE: removals of removed entities come with the entity removal, components set again come with the sets
+        for (size_t i = first; i < CECS_DYNAMIC_ARRAY_COUNT(cecs_change_record, &changes->removals); ++i) {
+            const cecs_entity_id entity = CECS_DYNAMIC_ARRAY_GET(cecs_change_record, &changes->removals, i)->entity;
+            if (
+                cecs_world_enities_has_entity(&w->entities, entity)
+                && !cecs_world_components_has_component(&w->components, cecs_entity_id_index(entity), component_id)
+            ) {
+                CECS_DYNAMIC_ARRAY_ADD(cecs_entity_id, removed, scratch_arena, &entity);
+            }
+        }
+    }
+
+    cecs_optional_component_storage storage = cecs_world_components_get_component_storage(&w->components, component_id);
+    size_t component_size = 0;
+    if (CECS_OPTION_IS_SOME(cecs_optional_component_storage, storage)) {
+        component_size = cecs_snapshot_delta_component_size(CECS_OPTION_GET_UNCHECKED(cecs_optional_component_storage, storage));
+        if (since_tick == CECS_CHANGE_TICK_NONE) {
+            const size_t index_count = CECS_DYNAMIC_ARRAY_COUNT(cecs_entity_generation, &w->entities.generations);
+            for (cecs_entity_id e = 0; e < (cecs_entity_id)index_count; ++e) {
+                if (
+                    cecs_world_entities_has_entity_index(&w->entities, e)
+                    && cecs_world_components_has_component(&w->components, e, component_id)
+                ) {
+                    const cecs_entity_id entity = cecs_world_entities_get_id(&w->entities, e);
+                    CECS_DYNAMIC_ARRAY_ADD(cecs_entity_id, set, scratch_arena, &entity);
+                }
+            }
+        } else {
+            cecs_snapshot_delta_collect_stamped(&changes->changed_ticks, &changes->changed_indices, since_tick, stamped, scratch_arena);
+            for (size_t i = 0; i < CECS_DYNAMIC_ARRAY_COUNT(cecs_entity_id, stamped); ++i) {
+                const cecs_entity_id e = *CECS_DYNAMIC_ARRAY_GET(cecs_entity_id, stamped, i);
+                if (
+                    cecs_world_entities_has_entity_index(&w->entities, e)
+                    && cecs_world_components_has_component(&w->components, e, component_id)
+                ) {
+                    const cecs_entity_id entity = cecs_world_entities_get_id(&w->entities, e);
+                    CECS_DYNAMIC_ARRAY_ADD(cecs_entity_id, set, scratch_arena, &entity);
+                }
+            }
+        }
+    }
+
+    const size_t set_count = CECS_DYNAMIC_ARRAY_COUNT(cecs_entity_id, set);
+    if (CECS_DYNAMIC_ARRAY_COUNT(cecs_entity_id, removed) == 0 && set_count == 0) {
+        return;
+    }
+
+    cecs_snapshot_delta_writer_varint(writer, (uint64_t)component_id);
+    cecs_snapshot_delta_writer_varint(writer, (uint64_t)component_size);
+    cecs_snapshot_delta_writer_entities(writer, removed);
+    cecs_snapshot_delta_writer_entities(writer, set);
+    if (component_size > 0) {
+        uint8_t *components = CECS_DYNAMIC_ARRAY_APPEND_EMPTY(uint8_t, writer->stream, writer->stream_arena, set_count * component_size);
+        for (size_t i = 0; i < set_count; ++i) {
+            memcpy(
+                components + i * component_size,
+                cecs_world_components_get_component_expect(
+                    &w->components, cecs_entity_id_index(*CECS_DYNAMIC_ARRAY_GET(cecs_entity_id, set, i)), component_id
+                ),
+                component_size
+            );
+        }
+    }
+}
+
+size_t cecs_world_encode_delta(cecs_world *w, const cecs_change_tick since_tick, cecs_dynamic_array *stream, cecs_arena *stream_arena) {
+    assert(since_tick <= cecs_world_change_tick(w) && "error: deltas may not be encoded since a future tick");
+    cecs_snapshot_delta_writer writer = {
+        .stream = stream,
+        .stream_arena = stream_arena,
+        .previous_index = 0
+    };
+    const size_t start_count = stream->count;
+
+    const uint32_t magic = CECS_SNAPSHOT_DELTA_MAGIC;
+    const uint8_t magic_bytes[sizeof(uint32_t)] = {
+        (uint8_t)magic, (uint8_t)(magic >> 8), (uint8_t)(magic >> 16), (uint8_t)(magic >> 24)
+    };
+    CECS_DYNAMIC_ARRAY_ADD_RANGE(uint8_t, stream, stream_arena, magic_bytes, sizeof(magic_bytes));
+    cecs_snapshot_delta_writer_varint(&writer, CECS_SNAPSHOT_DELTA_VERSION);
+    cecs_snapshot_delta_writer_varint(&writer, (uint64_t)since_tick);
+    cecs_snapshot_delta_writer_varint(&writer, (uint64_t)cecs_world_change_tick(w));
+
+    cecs_arena scratch_arena = cecs_arena_create();
+    cecs_dynamic_array removed = cecs_dynamic_array_create();
+    cecs_dynamic_array added = cecs_dynamic_array_create();
+    cecs_dynamic_array stamped = cecs_dynamic_array_create();
+
+    if (since_tick != CECS_CHANGE_TICK_NONE) {
+        cecs_snapshot_delta_collect_removed(&w->entities, &w->changes.entity_removals, since_tick, &removed, &scratch_arena);
+    }
+    cecs_snapshot_delta_writer_entities(&writer, &removed);
+
+    if (since_tick == CECS_CHANGE_TICK_NONE) {
+        const size_t index_count = CECS_DYNAMIC_ARRAY_COUNT(cecs_entity_generation, &w->entities.generations);
+        for (cecs_entity_id e = 0; e < (cecs_entity_id)index_count; ++e) {
+            if (cecs_world_entities_has_entity_index(&w->entities, e)) {
+                const cecs_entity_id entity = cecs_world_entities_get_id(&w->entities, e);
+                CECS_DYNAMIC_ARRAY_ADD(cecs_entity_id, &added, &scratch_arena, &entity);
+            }
+        }
+    } else {
+        cecs_snapshot_delta_collect_stamped(&w->changes.added_ticks, &w->changes.added_indices, since_tick, &stamped, &scratch_arena);
+        for (size_t i = 0; i < CECS_DYNAMIC_ARRAY_COUNT(cecs_entity_id, &stamped); ++i) {
+            const cecs_entity_id e = *CECS_DYNAMIC_ARRAY_GET(cecs_entity_id, &stamped, i);
+            if (cecs_world_entities_has_entity_index(&w->entities, e)) {
+                const cecs_entity_id entity = cecs_world_entities_get_id(&w->entities, e);
+                CECS_DYNAMIC_ARRAY_ADD(cecs_entity_id, &added, &scratch_arena, &entity);
+            }
+        }
+    }
+    cecs_snapshot_delta_writer_entities(&writer, &added);
+
+    // NOTE: components are written to a second stream first, their count goes before them
+    cecs_dynamic_array component_stream = cecs_dynamic_array_create();
+    cecs_snapshot_delta_writer component_writer = {
+        .stream = &component_stream,
+        .stream_arena = &scratch_arena,
+        .previous_index = 0
+    };
+    size_t component_count = 0;
+    for (size_t i = 0; i < cecs_world_changes_component_count(&w->changes); ++i) {
+        const size_t written_count = component_stream.count;
+        cecs_snapshot_delta_write_component(
+            &component_writer, w, cecs_world_changes_at(&w->changes, i), since_tick, &removed, &added, &stamped, &scratch_arena
+        );
+        if (component_stream.count != written_count) {
+            ++component_count;
+        }
+    }
+    cecs_snapshot_delta_writer_varint(&writer, (uint64_t)component_count);
+    if (component_stream.count > 0) {
+        CECS_DYNAMIC_ARRAY_ADD_RANGE(uint8_t, stream, stream_arena, component_stream.values, component_stream.count);
+    }
+
+    cecs_arena_free(&scratch_arena);
+    return stream->count - start_count;
+}
+
+cecs_snapshot_delta_decoder cecs_snapshot_delta_decoder_create(void) {
+    return (cecs_snapshot_delta_decoder) {
+        .decoder_arena = cecs_arena_create(),
+        .remote_to_local = cecs_dynamic_array_create(),
+        .decoded_entities = cecs_dynamic_array_create(),
+        .entity_count = 0,
+        .tick = CECS_CHANGE_TICK_NONE
+    };
+}
+
+void cecs_snapshot_delta_decoder_free(cecs_snapshot_delta_decoder *d) {
+    cecs_arena_free(&d->decoder_arena);
+    d->remote_to_local = (cecs_dynamic_array){ 0 };
+    d->decoded_entities = (cecs_dynamic_array){ 0 };
+    d->entity_count = 0;
+    d->tick = CECS_CHANGE_TICK_NONE;
+}
+
+bool cecs_snapshot_delta_decoder_get_local(const cecs_snapshot_delta_decoder *d, const cecs_entity_id remote, cecs_entity_id *out_local) {
+    const cecs_entity_id index = cecs_entity_id_index(remote);
+    if (index >= CECS_DYNAMIC_ARRAY_COUNT(cecs_snapshot_delta_entity_mapping, &d->remote_to_local)) {
+        return false;
+    }
+
+    const cecs_snapshot_delta_entity_mapping *mapping =
+        CECS_DYNAMIC_ARRAY_GET(cecs_snapshot_delta_entity_mapping, &d->remote_to_local, index);
+    if (mapping->remote == remote) {
+        *out_local = mapping->local;
+        return true;
+    } else {
+        return false;
+    }
+}
+
+static bool cecs_snapshot_delta_decoder_unmap(cecs_snapshot_delta_decoder *d, const cecs_entity_id remote, cecs_entity_id *out_local) {
+    if (!cecs_snapshot_delta_decoder_get_local(d, remote, out_local)) {
+        return false;
+    }
+    CECS_DYNAMIC_ARRAY_GET_MUT(cecs_snapshot_delta_entity_mapping, &d->remote_to_local, cecs_entity_id_index(remote))->remote =
+        CECS_ENTITY_ID_MAX;
+    --d->entity_count;
+    return true;
+}
+
+// NOTE: unmapped slots hold CECS_ENTITY_ID_MAX, which no remote id matches
+static void cecs_snapshot_delta_decoder_map(cecs_snapshot_delta_decoder *d, const cecs_entity_id remote, const cecs_entity_id local) {
+    const size_t index = (size_t)cecs_entity_id_index(remote);
+    const size_t count = CECS_DYNAMIC_ARRAY_COUNT(cecs_snapshot_delta_entity_mapping, &d->remote_to_local);
+    if (index >= count) {
+        cecs_snapshot_delta_entity_mapping *appended = CECS_DYNAMIC_ARRAY_APPEND_EMPTY(
+            cecs_snapshot_delta_entity_mapping, &d->remote_to_local, &d->decoder_arena, index + 1 - count
+        );
+        for (size_t i = 0; i < index + 1 - count; ++i) {
+            appended[i] = (cecs_snapshot_delta_entity_mapping){ .remote = CECS_ENTITY_ID_MAX, .local = CECS_ENTITY_ID_MAX };
+        }
+    }
+
+    cecs_snapshot_delta_entity_mapping *mapping = CECS_DYNAMIC_ARRAY_GET_MUT(cecs_snapshot_delta_entity_mapping, &d->remote_to_local, index);
+    if (mapping->remote == CECS_ENTITY_ID_MAX) {
+        ++d->entity_count;
+    }
+    *mapping = (cecs_snapshot_delta_entity_mapping){ .remote = remote, .local = local };
+}
+
+typedef struct cecs_snapshot_delta_reader {
+    const uint8_t *data;
+    size_t size;
+    size_t offset;
+    cecs_entity_id previous_index;
+    bool failed;
+} cecs_snapshot_delta_reader;
+
+static uint64_t cecs_snapshot_delta_reader_varint(cecs_snapshot_delta_reader *reader) {
+    uint64_t value = 0;
+    for (size_t i = 0; i < CECS_SNAPSHOT_DELTA_VARINT_MAX_SIZE && reader->offset < reader->size; ++i) {
+        const uint8_t byte = reader->data[reader->offset++];
+        value |= (uint64_t)(byte & 0x7F) << (7 * i);
+        if (!(byte & 0x80)) {
+            return value;
+        }
+    }
+    reader->failed = true;
+    return 0;
+}
+
+static cecs_entity_id cecs_snapshot_delta_reader_entity(cecs_snapshot_delta_reader *reader) {
+    const int64_t index = (int64_t)reader->previous_index + cecs_snapshot_delta_unzigzag(cecs_snapshot_delta_reader_varint(reader));
+    const uint64_t generation = cecs_snapshot_delta_reader_varint(reader);
+    if (index < 0 || (uint64_t)index > CECS_ENTITY_ID_INDEX_MASK || generation > UINT32_MAX) {
+        reader->failed = true;
+        return 0;
+    }
+    reader->previous_index = (cecs_entity_id)index;
+    return cecs_entity_id_create((cecs_entity_id)index, (cecs_entity_generation)generation);
+}
+
+// NOTE: every entity takes at least two bytes, counts larger than the rest of the stream are rejected before looping
+static size_t cecs_snapshot_delta_reader_count(cecs_snapshot_delta_reader *reader, const size_t min_element_size) {
+    const uint64_t count = cecs_snapshot_delta_reader_varint(reader);
+    if (reader->failed || count > (reader->size - reader->offset) / min_element_size) {
+        reader->failed = true;
+        return 0;
+    }
+    reader->previous_index = 0;
+    return (size_t)count;
+}
+
+static const uint8_t *cecs_snapshot_delta_reader_bytes(cecs_snapshot_delta_reader *reader, const size_t size) {
+    if (size > reader->size - reader->offset) {
+        reader->failed = true;
+        return NULL;
+    }
+    const uint8_t *bytes = reader->data + reader->offset;
+    reader->offset += size;
+    return bytes;
+}
+
+static cecs_snapshot_status cecs_snapshot_delta_reader_header(cecs_snapshot_delta_reader *reader, cecs_snapshot_delta_header *out_header) {
+    const uint8_t *magic_bytes = cecs_snapshot_delta_reader_bytes(reader, sizeof(uint32_t));
+    if (reader->failed) {
+        return cecs_snapshot_status_invalid_format;
+    }
+    out_header->magic = (uint32_t)magic_bytes[0]
+        | ((uint32_t)magic_bytes[1] << 8)
+        | ((uint32_t)magic_bytes[2] << 16)
+        | ((uint32_t)magic_bytes[3] << 24);
+    if (out_header->magic != CECS_SNAPSHOT_DELTA_MAGIC) {
+        return cecs_snapshot_status_invalid_format;
+    }
+
+    const uint64_t version = cecs_snapshot_delta_reader_varint(reader);
+    const uint64_t since_tick = cecs_snapshot_delta_reader_varint(reader);
+    const uint64_t tick = cecs_snapshot_delta_reader_varint(reader);
+    if (reader->failed || since_tick > UINT32_MAX || tick > UINT32_MAX || since_tick > tick) {
+        return cecs_snapshot_status_invalid_format;
+    }
+    out_header->version = (uint32_t)version;
+    out_header->since_tick = (cecs_change_tick)since_tick;
+    out_header->tick = (cecs_change_tick)tick;
+    return version == CECS_SNAPSHOT_DELTA_VERSION ? cecs_snapshot_status_ok : cecs_snapshot_status_version_mismatch;
+}
+
+cecs_snapshot_status cecs_snapshot_delta_read_header(const void *stream, const size_t size, cecs_snapshot_delta_header *out_header) {
+    cecs_snapshot_delta_reader reader = { .data = stream, .size = size, .offset = 0, .previous_index = 0, .failed = false };
+    return cecs_snapshot_delta_reader_header(&reader, out_header);
+}
+
+static size_t cecs_snapshot_delta_reader_skip_entities(cecs_snapshot_delta_reader *reader) {
+    const size_t entity_count = cecs_snapshot_delta_reader_count(reader, 2);
+    for (size_t i = 0; i < entity_count && !reader->failed; ++i) {
+        cecs_snapshot_delta_reader_entity(reader);
+    }
+    return entity_count;
+}
+
+static cecs_snapshot_status cecs_snapshot_delta_validate(cecs_world *w, cecs_snapshot_delta_reader reader) {
+    cecs_snapshot_delta_reader_skip_entities(&reader);
+    cecs_snapshot_delta_reader_skip_entities(&reader);
+
+    const size_t component_count = cecs_snapshot_delta_reader_count(&reader, 4);
+    for (size_t i = 0; i < component_count && !reader.failed; ++i) {
+        const uint64_t component_id = cecs_snapshot_delta_reader_varint(&reader);
+        const uint64_t component_size = cecs_snapshot_delta_reader_varint(&reader);
+        cecs_snapshot_delta_reader_skip_entities(&reader);
+        const size_t set_count = cecs_snapshot_delta_reader_skip_entities(&reader);
+        if (reader.failed || (set_count > 0 && component_size > (reader.size - reader.offset) / set_count)) {
+            return cecs_snapshot_status_invalid_format;
+        }
+        cecs_snapshot_delta_reader_bytes(&reader, set_count * (size_t)component_size);
+
+        cecs_optional_component_storage storage =
+            cecs_world_components_get_component_storage(&w->components, (cecs_component_id)component_id);
+        if (
+            set_count > 0
+            && CECS_OPTION_IS_SOME(cecs_optional_component_storage, storage)
+            && cecs_snapshot_delta_component_size(CECS_OPTION_GET_UNCHECKED(cecs_optional_component_storage, storage)) != component_size
+        ) {
+            return cecs_snapshot_status_type_mismatch;
+        }
+    }
+
+    if (reader.failed || reader.offset != reader.size) {
+        return cecs_snapshot_status_invalid_format;
+    }
+    return cecs_snapshot_status_ok;
+}
+
+static bool cecs_snapshot_delta_decoder_get_alive_local(
+    const cecs_snapshot_delta_decoder *d,
+    const cecs_world *w,
+    const cecs_entity_id remote,
+    cecs_entity_id *out_local
+) {
+    return cecs_snapshot_delta_decoder_get_local(d, remote, out_local) && cecs_world_enities_has_entity(&w->entities, *out_local);
+}
+
+static void cecs_snapshot_delta_apply_component(cecs_world *w, cecs_snapshot_delta_decoder *d, cecs_snapshot_delta_reader *reader) {
+    const cecs_component_id component_id = (cecs_component_id)cecs_snapshot_delta_reader_varint(reader);
+    const size_t component_size = (size_t)cecs_snapshot_delta_reader_varint(reader);
+
+    const size_t removed_count = cecs_snapshot_delta_reader_count(reader, 2);
+    for (size_t i = 0; i < removed_count; ++i) {
+        cecs_entity_id local;
+        if (
+            cecs_snapshot_delta_decoder_get_alive_local(d, w, cecs_snapshot_delta_reader_entity(reader), &local)
+            && cecs_world_components_has_component(&w->components, cecs_entity_id_index(local), component_id)
+        ) {
+            if (component_size == 0) {
+                cecs_world_remove_tag(w, local, component_id);
+            } else {
+                cecs_world_remove_component(w, local, component_id, cecs_world_use_component_discard(w, component_size));
+            }
+        }
+    }
+
+    const size_t set_count = cecs_snapshot_delta_reader_count(reader, 2);
+    cecs_dynamic_array_clear(&d->decoded_entities);
+    cecs_entity_id *locals = CECS_DYNAMIC_ARRAY_APPEND_EMPTY(cecs_entity_id, &d->decoded_entities, &d->decoder_arena, set_count);
+    for (size_t i = 0; i < set_count; ++i) {
+        if (!cecs_snapshot_delta_decoder_get_alive_local(d, w, cecs_snapshot_delta_reader_entity(reader), &locals[i])) {
+            locals[i] = CECS_ENTITY_ID_MAX;
+        }
+    }
+    const uint8_t *components = cecs_snapshot_delta_reader_bytes(reader, set_count * component_size);
+
+    // NOTE: components of consecutive local entities are set as one array straight from the stream
+    size_t run_start = 0;
+    while (run_start < set_count) {
+        size_t run_end = run_start + 1;
+        if (locals[run_start] == CECS_ENTITY_ID_MAX) {
+            run_start = run_end;
+            continue;
+        }
+
+        const cecs_entity_id first_index = cecs_entity_id_index(locals[run_start]);
+        while (
+            run_end < set_count
+            && locals[run_end] != CECS_ENTITY_ID_MAX
+            && cecs_entity_id_index(locals[run_end]) == first_index + (run_end - run_start)
+        ) {
+            ++run_end;
+        }
+
+        const cecs_entity_id_range run = cecs_exclusive_range_index_count((cecs_ssize_t)first_index, (cecs_ssize_t)(run_end - run_start));
+        if (component_size == 0) {
+            cecs_world_add_tag_array(w, run, component_id);
+        } else {
+            cecs_world_set_component_array(w, run, component_id, (void *)(components + run_start * component_size), component_size);
+        }
+        run_start = run_end;
+    }
+}
+
+cecs_snapshot_status cecs_world_apply_delta(cecs_world *w, cecs_snapshot_delta_decoder *d, const void *stream, const size_t size) {
+    cecs_snapshot_delta_reader reader = { .data = stream, .size = size, .offset = 0, .previous_index = 0, .failed = false };
+    cecs_snapshot_delta_header header;
+    cecs_snapshot_status status = cecs_snapshot_delta_reader_header(&reader, &header);
+    if (status != cecs_snapshot_status_ok) {
+        return status;
+    }
+    if (header.since_tick > d->tick || header.tick < d->tick) {
+        return cecs_snapshot_status_out_of_order;
+    }
+    status = cecs_snapshot_delta_validate(w, reader);
+    if (status != cecs_snapshot_status_ok) {
+        return status;
+    }
+
+    const size_t removed_count = cecs_snapshot_delta_reader_count(&reader, 2);
+    for (size_t i = 0; i < removed_count; ++i) {
+        cecs_entity_id local;
+        if (
+            cecs_snapshot_delta_decoder_unmap(d, cecs_snapshot_delta_reader_entity(&reader), &local)
+            && cecs_world_enities_has_entity(&w->entities, local)
+        ) {
+            cecs_world_remove_entity(w, local);
+        }
+    }
+
+    // NOTE: entities sent again by overlapping deltas keep their local entity, new ones are added as one range
+    const size_t added_count = cecs_snapshot_delta_reader_count(&reader, 2);
+    cecs_dynamic_array_clear(&d->decoded_entities);
+    for (size_t i = 0; i < added_count; ++i) {
+        const cecs_entity_id remote = cecs_snapshot_delta_reader_entity(&reader);
+        cecs_entity_id local;
+        if (!cecs_snapshot_delta_decoder_get_alive_local(d, w, remote, &local)) {
+            CECS_DYNAMIC_ARRAY_ADD(cecs_entity_id, &d->decoded_entities, &d->decoder_arena, &remote);
+        }
+    }
+    const size_t new_count = CECS_DYNAMIC_ARRAY_COUNT(cecs_entity_id, &d->decoded_entities);
+    if (new_count > 0) {
+        const cecs_entity_id_range added = cecs_world_add_entity_range(w, new_count);
+        for (size_t i = 0; i < new_count; ++i) {
+            cecs_snapshot_delta_decoder_map(
+                d,
+                *CECS_DYNAMIC_ARRAY_GET(cecs_entity_id, &d->decoded_entities, i),
+                cecs_world_entities_get_id(&w->entities, (cecs_entity_id)added.start + i)
+            );
+        }
+    }
+
+    const size_t component_count = cecs_snapshot_delta_reader_count(&reader, 4);
+    for (size_t i = 0; i < component_count; ++i) {
+        cecs_snapshot_delta_apply_component(w, d, &reader);
+    }
+    assert(!reader.failed && reader.offset == reader.size && "fatal error: validated delta failed to apply");
+
+    d->tick = header.tick;
+    return cecs_snapshot_status_ok;
+}
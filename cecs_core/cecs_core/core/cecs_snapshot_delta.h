@@ -0,0 +1,69 @@
+#ifndef CECS_SNAPSHOT_DELTA_H
+#define CECS_SNAPSHOT_DELTA_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <assert.h>
+#include "../containers/cecs_arena.h"
+#include "../containers/cecs_dynamic_array.h"
+#include "component/entity/cecs_entity.h"
+#include "component/cecs_component.h"
+#include "cecs_change.h"
+#include "cecs_snapshot.h"
+#include "cecs_world.h"
+
+#define CECS_SNAPSHOT_DELTA_MAGIC ((uint32_t)0x544C4443) // "CDLT"
+#define CECS_SNAPSHOT_DELTA_VERSION 1
+
+// NOTE: deltas are byte streams of LEB128 varints after a 4 byte magic:
+//   version, since tick, tick,
+//   removed entity count, entities, added entity count, entities,
+//   component count, per component: id, size, removed entity count, entities, set entity count, entities,
+//   then the set components as raw bytes back to back.
+// Entities are written as the zigzagged index difference to the previous entity of the list and their generation,
+// lists walked in index order take about two bytes per entity
+typedef struct cecs_snapshot_delta_header {
+    uint32_t magic;
+    uint32_t version;
+    cecs_change_tick since_tick;
+    cecs_change_tick tick;
+} cecs_snapshot_delta_header;
+
+// NOTE: encodes the tracked components and entities changed after since_tick up to the current tick, appending to the stream.
+// A since tick of CECS_CHANGE_TICK_NONE encodes every alive entity and tracked component, for decoders starting out empty.
+// Encode once the tick's changes are done and advance the tick afterwards, later changes in the same tick would be missed
+size_t cecs_world_encode_delta(cecs_world *w, cecs_change_tick since_tick, cecs_dynamic_array *stream, cecs_arena *stream_arena);
+
+typedef struct cecs_snapshot_delta_entity_mapping {
+    cecs_entity_id remote;
+    cecs_entity_id local;
+} cecs_snapshot_delta_entity_mapping;
+
+// NOTE: decoded entities are added to the local world under new ids, the decoder maps the encoding world's ids onto them,
+// indexed by the remote entity index like the generations. Component bytes are copied as they are,
+// components holding entity ids or pointers are not remapped
+typedef struct cecs_snapshot_delta_decoder {
+    cecs_arena decoder_arena;
+    cecs_dynamic_array remote_to_local;
+    cecs_dynamic_array decoded_entities;
+    size_t entity_count;
+    cecs_change_tick tick;
+} cecs_snapshot_delta_decoder;
+
+cecs_snapshot_delta_decoder cecs_snapshot_delta_decoder_create(void);
+
+void cecs_snapshot_delta_decoder_free(cecs_snapshot_delta_decoder *d);
+
+static inline size_t cecs_snapshot_delta_decoder_entity_count(const cecs_snapshot_delta_decoder *d) {
+    return d->entity_count;
+}
+
+bool cecs_snapshot_delta_decoder_get_local(const cecs_snapshot_delta_decoder *d, cecs_entity_id remote, cecs_entity_id *out_local);
+
+cecs_snapshot_status cecs_snapshot_delta_read_header(const void *stream, size_t size, cecs_snapshot_delta_header *out_header);
+
+// NOTE: the whole stream is validated before anything is applied. Deltas must start at or before the decoder's tick
+// and not end before it, so deltas since the last acknowledged tick may overlap what was already applied
+cecs_snapshot_status cecs_world_apply_delta(cecs_world *w, cecs_snapshot_delta_decoder *d, const void *stream, size_t size);
+
+#endif
@@ -3,6 +3,83 @@
 
 #include "cecs_system.h"
 
+void cecs_world_system_borrow_resources(const cecs_world_system s, cecs_world *w) {
+    for (size_t i = 0; i < s.resource_group_count; ++i) {
+        const cecs_resource_access_group group = s.resource_groups[i];
+        for (size_t j = 0; j < group.resource_count; ++j) {
+            cecs_world_borrow_resource(w, group.resources[j], group.access);
+        }
+    }
+}
+
+void cecs_world_system_release_resources(const cecs_world_system s, cecs_world *w) {
+    for (size_t i = 0; i < s.resource_group_count; ++i) {
+        const cecs_resource_access_group group = s.resource_groups[i];
+        for (size_t j = 0; j < group.resource_count; ++j) {
+            cecs_world_release_resource(w, group.resources[j], group.access);
+        }
+    }
+}
+
+static bool cecs_world_system_resource_groups_conflict(const cecs_resource_access_group a, const cecs_resource_access_group b) {
+    if (a.access != cecs_resource_access_mutable && b.access != cecs_resource_access_mutable) {
+        return false;
+    }
+    for (size_t i = 0; i < a.resource_count; ++i) {
+        for (size_t j = 0; j < b.resource_count; ++j) {
+            if (a.resources[i] == b.resources[j]) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+bool cecs_world_system_resources_conflict(const cecs_world_system a, const cecs_world_system b) {
+    for (size_t i = 0; i < a.resource_group_count; ++i) {
+        for (size_t j = 0; j < b.resource_group_count; ++j) {
+            if (cecs_world_system_resource_groups_conflict(a.resource_groups[i], b.resource_groups[j])) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+static bool cecs_world_system_records_mutable_access(const cecs_world_system s, const cecs_world *w) {
+    for (size_t i = 0; i < s.descriptor.group_count; ++i) {
+        const cecs_component_iteration_group group = s.descriptor.groups[i];
+        if (group.access != cecs_component_access_mutable || group.search_mode == cecs_component_group_search_none) {
+            continue;
+        }
+        for (size_t j = 0; j < group.component_count; ++j) {
+            if (cecs_world_is_mutable_access_recorded(w, group.components[j])) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+// NOTE: iterating a mutable group counts as getting each of its components the entity has mutably
+static void cecs_world_system_mark_mutable_access(const cecs_world_system s, cecs_world *w, const cecs_entity_id entity) {
+    for (size_t i = 0; i < s.descriptor.group_count; ++i) {
+        const cecs_component_iteration_group group = s.descriptor.groups[i];
+        if (group.access != cecs_component_access_mutable || group.search_mode == cecs_component_group_search_none) {
+            continue;
+        }
+        for (size_t j = 0; j < group.component_count; ++j) {
+            const cecs_component_id component_id = group.components[j];
+            if (
+                cecs_world_is_mutable_access_recorded(w, component_id)
+                && cecs_world_components_has_component(&w->components, cecs_entity_id_index(entity), component_id)
+            ) {
+                cecs_world_mark_mutable_access(w, entity, component_id);
+            }
+        }
+    }
+}
+
 cecs_entity_count cecs_world_system_iter(
     const cecs_world_system s,
     cecs_world* w,
@@ -12,6 +89,8 @@ cecs_entity_count cecs_world_system_iter(
     cecs_system_predicate* const predicate
 ) {
     cecs_entity_count count = 0;
+    const bool records_mutable_access = cecs_world_system_records_mutable_access(s, w);
+    cecs_world_system_borrow_resources(s, w);
     cecs_component_iterator it = cecs_component_iterator_create(s.descriptor, &w->components, iteration_arena);
     for (
         cecs_component_iterator_begin_iter(&it, iteration_arena);
@@ -19,10 +98,14 @@ cecs_entity_count cecs_world_system_iter(
         cecs_component_iterator_next(&it)
     ) {
         ++count;
-        const cecs_entity_id entity = cecs_component_iterator_current(&it, handles);
+        const cecs_entity_id entity = cecs_world_entities_get_id(&w->entities, cecs_component_iterator_current(&it, handles));
         predicate(handles, entity, w, data);
+        if (records_mutable_access) {
+            cecs_world_system_mark_mutable_access(s, w, entity);
+        }
     }
     cecs_component_iterator_end_iter(&it);
+    cecs_world_system_release_resources(s, w);
     return count;
 }
 
@@ -43,6 +126,8 @@ cecs_entity_count cecs_world_system_iter_all(
     const cecs_system_predicates predicates
 ) {
     cecs_entity_count count = 0;
+    const bool records_mutable_access = cecs_world_system_records_mutable_access(s, w);
+    cecs_world_system_borrow_resources(s, w);
     cecs_component_iterator it = cecs_component_iterator_create(s.descriptor, &w->components, iteration_arena);
     for (
         cecs_component_iterator_begin_iter(&it, iteration_arena);
@@ -50,12 +135,16 @@ cecs_entity_count cecs_world_system_iter_all(
         cecs_component_iterator_next(&it)
     ) {
         ++count;
-        const cecs_entity_id entity = cecs_component_iterator_current(&it, handles);
+        const cecs_entity_id entity = cecs_world_entities_get_id(&w->entities, cecs_component_iterator_current(&it, handles));
         for (size_t i = 0; i < predicates.predicate_count; i++) {
             predicates.predicates[i](handles, entity, w, data);
         }
+        if (records_mutable_access) {
+            cecs_world_system_mark_mutable_access(s, w, entity);
+        }
     }
     cecs_component_iterator_end_iter(&it);
+    cecs_world_system_release_resources(s, w);
     return count;
 }
 
@@ -63,6 +152,8 @@ cecs_dynamic_world_system cecs_dynamic_world_system_create(void) {
     return (cecs_dynamic_world_system) {
         .components = cecs_dynamic_array_create(),
         .component_groups = cecs_dynamic_array_create(),
+        .resources = cecs_dynamic_array_create(),
+        .resource_groups = cecs_dynamic_array_create(),
     };
 }
 
@@ -70,6 +161,8 @@ cecs_dynamic_world_system cecs_dynamic_world_system_create_from(cecs_arena *a, c
     cecs_dynamic_world_system d = (cecs_dynamic_world_system) {
         .components = cecs_dynamic_array_create_with_capacity(a, group_count * sizeof(cecs_component_id)),
         .component_groups = cecs_dynamic_array_create_with_capacity(a, group_count * sizeof(cecs_component_iteration_group)),
+        .resources = cecs_dynamic_array_create(),
+        .resource_groups = cecs_dynamic_array_create(),
     };
     cecs_dynamic_world_system_add_range(&d, a, groups, group_count);
     return d;
@@ -149,13 +242,49 @@ cecs_component_iteration_group_range cecs_dynamic_world_system_set_or_extend_ran
     return (cecs_component_iteration_group_range) { 0, index + group_count };
 }
 
+cecs_dynamic_world_system *cecs_dynamic_world_system_add_resources(
+    cecs_dynamic_world_system *d,
+    cecs_arena *a,
+    const cecs_resource_access_group groups[const],
+    const size_t group_count
+) {
+    if (group_count == 0) {
+        return d;
+    }
+
+    cecs_dynamic_array_add_range(&d->resource_groups, a, groups, group_count, sizeof(cecs_resource_access_group));
+    for (size_t i = 0; i < group_count; ++i) {
+        if (groups[i].resource_count > 0) {
+            cecs_dynamic_array_add_range(&d->resources, a, groups[i].resources, groups[i].resource_count, sizeof(cecs_resource_id));
+        }
+    }
+
+    // NOTE: resource ids are kept in group order, groups are repointed as adding may move them
+    cecs_resource_id *resources = (cecs_resource_id *)d->resources.values;
+    cecs_resource_access_group *resource_groups = cecs_dynamic_array_first_mut(&d->resource_groups);
+    const size_t resource_group_count = CECS_DYNAMIC_ARRAY_COUNT(cecs_resource_access_group, &d->resource_groups);
+    for (size_t i = 0; i < resource_group_count; ++i) {
+        resource_groups[i].resources = resources;
+        resources += resource_groups[i].resource_count;
+    }
+    return d;
+}
+
+static cecs_world_system cecs_world_system_with_dynamic_resources(cecs_world_system s, cecs_dynamic_world_system *d) {
+    const size_t resource_group_count = CECS_DYNAMIC_ARRAY_COUNT(cecs_resource_access_group, &d->resource_groups);
+    if (resource_group_count == 0) {
+        return s;
+    }
+    return cecs_world_system_with_resources(s, cecs_dynamic_array_first_mut(&d->resource_groups), resource_group_count);
+}
+
 cecs_world_system cecs_world_system_from_dynamic(cecs_dynamic_world_system* d) {
     // TODO: watch group const disqualifier
-    return cecs_world_system_create((cecs_component_iterator_descriptor){
+    return cecs_world_system_with_dynamic_resources(cecs_world_system_create((cecs_component_iterator_descriptor){
         .entity_range = { 0, PTRDIFF_MAX },
         .groups = cecs_dynamic_array_first_mut(&d->component_groups),
         .group_count = cecs_dynamic_array_count_of_size(&d->component_groups, sizeof(cecs_component_iteration_group))
-    });
+    }), d);
 }
 
 cecs_world_system cecs_world_system_from_dynamic_range(cecs_dynamic_world_system* d, const cecs_component_iteration_group_range r) {
@@ -165,17 +294,22 @@ cecs_world_system cecs_world_system_from_dynamic_range(cecs_dynamic_world_system
         (size_t)r.end <= cecs_dynamic_array_count_of_size(&d->component_groups, sizeof(cecs_component_iteration_group))
         && "error: end index out of bounds"
     );
-    return cecs_world_system_create((cecs_component_iterator_descriptor){
+    return cecs_world_system_with_dynamic_resources(cecs_world_system_create((cecs_component_iterator_descriptor){
         .entity_range = { 0, PTRDIFF_MAX },
         .groups = cecs_dynamic_array_get_mut(&d->component_groups, r.start, sizeof(cecs_component_iteration_group)),
         .group_count = cecs_exclusive_range_length(r)
-    });
+    }), d);
 }
 
 cecs_dynamic_world_system cecs_dynamic_world_system_clone(const cecs_dynamic_world_system* d, cecs_arena* a) {
-    return cecs_dynamic_world_system_create_from(
+    cecs_dynamic_world_system clone = cecs_dynamic_world_system_create_from(
         a,
         cecs_dynamic_array_first(&d->component_groups),
         cecs_dynamic_array_count_of_size(&d->component_groups, sizeof(cecs_component_iteration_group))
     );
+    const size_t resource_group_count = CECS_DYNAMIC_ARRAY_COUNT(cecs_resource_access_group, &d->resource_groups);
+    if (resource_group_count > 0) {
+        cecs_dynamic_world_system_add_resources(&clone, a, cecs_dynamic_array_first(&d->resource_groups), resource_group_count);
+    }
+    return clone;
 }
@@ -6,15 +6,60 @@
 #include "component/cecs_component_iterator.h"
 #include "cecs_world.h"
 
+typedef struct cecs_resource_access_group {
+    cecs_resource_id *resources;
+    size_t resource_count;
+    cecs_resource_access_mode access;
+} cecs_resource_access_group;
+
+#define CECS_RESOURCE_ACCESS_GROUP(access_mode, ...) \
+    (cecs_resource_access_group){ \
+        .resources = CECS_RESOURCE_ID_ARRAY(__VA_ARGS__), \
+        .resource_count = (sizeof(CECS_RESOURCE_ID_ARRAY(__VA_ARGS__)) / sizeof(cecs_resource_id)), \
+        .access = access_mode \
+    }
+#define CECS_RESOURCE_ACCESS_GROUP_FROM_IDS(access_mode, ...) \
+    (cecs_resource_access_group){ \
+        .resources = (cecs_resource_id[]){ __VA_ARGS__ }, \
+        .resource_count = (sizeof((cecs_resource_id[]){ __VA_ARGS__ }) / sizeof(cecs_resource_id)), \
+        .access = access_mode \
+    }
+
 typedef struct cecs_world_system {
     cecs_component_iterator_descriptor descriptor;
+    cecs_resource_access_group *resource_groups;
+    size_t resource_group_count;
 } cecs_world_system;
 
 static inline cecs_world_system cecs_world_system_create(cecs_component_iterator_descriptor descriptor) {
     return (cecs_world_system){ 
-        .descriptor = descriptor
+        .descriptor = descriptor,
+        .resource_groups = NULL,
+        .resource_group_count = 0
     };
 }
+
+static inline cecs_world_system cecs_world_system_with_resources(
+    cecs_world_system s,
+    cecs_resource_access_group resource_groups[],
+    const size_t resource_group_count
+) {
+    s.resource_groups = resource_groups;
+    s.resource_group_count = resource_group_count;
+    return s;
+}
+#define CECS_WORLD_SYSTEM_WITH_RESOURCES(world_system0, ...) \
+    cecs_world_system_with_resources( \
+        world_system0, \
+        (cecs_resource_access_group[]){ __VA_ARGS__ }, \
+        (sizeof((cecs_resource_access_group[]){ __VA_ARGS__ }) / sizeof(cecs_resource_access_group)) \
+    )
+
+// NOTE: systems iterating borrow their declared resources for the whole iteration,
+// systems without conflicting resource access may be scheduled to run concurrently
+void cecs_world_system_borrow_resources(const cecs_world_system s, cecs_world *w);
+void cecs_world_system_release_resources(const cecs_world_system s, cecs_world *w);
+bool cecs_world_system_resources_conflict(const cecs_world_system a, const cecs_world_system b);
 #define CECS_WORLD_SYSTEM_CREATE_GROUPED(...) cecs_world_system_create(CECS_COMPONENT_ITERATOR_DESCRIPTOR_CREATE_GROUPPED(__VA_ARGS__))
 #define CECS_WORLD_SYSTEM_CREATE_GROUPED_FROM_IDS(...) cecs_world_system_create(CECS_COMPONENT_ITERATOR_DESCRIPTOR_CREATE_GROUPPED(__VA_ARGS__))
 
@@ -89,6 +134,8 @@ cecs_entity_count cecs_world_system_iter_all(
 typedef struct cecs_dynamic_world_system {
     cecs_dynamic_array components;
     cecs_dynamic_array component_groups;
+    cecs_dynamic_array resources;
+    cecs_dynamic_array resource_groups;
 } cecs_dynamic_world_system;
 
 cecs_dynamic_world_system cecs_dynamic_world_system_create(void);
@@ -109,6 +156,21 @@ cecs_component_iteration_group_range cecs_dynamic_world_system_set_or_extend_ran
     const size_t group_count
 );
 
+// NOTE: systems made from a dynamic system, ranges included, declare all of its resources
+cecs_dynamic_world_system *cecs_dynamic_world_system_add_resources(
+    cecs_dynamic_world_system *d,
+    cecs_arena *a,
+    const cecs_resource_access_group groups[const],
+    const size_t group_count
+);
+#define CECS_DYNAMIC_WORLD_SYSTEM_ADD_RESOURCES(dynamic_world_system_ref, arena_ref, ...) \
+    cecs_dynamic_world_system_add_resources( \
+        dynamic_world_system_ref, \
+        arena_ref, \
+        (cecs_resource_access_group[]){ __VA_ARGS__ }, \
+        (sizeof((cecs_resource_access_group[]){ __VA_ARGS__ }) / sizeof(cecs_resource_access_group)) \
+    )
+
 cecs_world_system cecs_world_system_from_dynamic(cecs_dynamic_world_system *d);
 cecs_world_system cecs_world_system_from_dynamic_range(cecs_dynamic_world_system *d, const cecs_component_iteration_group_range r);
 
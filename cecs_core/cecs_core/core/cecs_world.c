@@ -9,17 +9,218 @@ cecs_world cecs_world_create(size_t entity_capacity, size_t component_type_capac
 
     const size_t resource_default_size = sizeof(intptr_t) * 4;
     w.resources = cecs_world_resources_create(resource_capacity, resource_default_size);
+    w.events = cecs_world_events_create();
+    w.changes = cecs_world_changes_create();
     return w;
 }
 
+// NOTE: reads the flags from storage directly, the world getters raise events themselves
+static cecs_entity_flags cecs_world_stored_entity_flags(cecs_world *w, const cecs_entity_id index) {
+    cecs_optional_component flags = cecs_world_components_get_component(&w->components, index, CECS_COMPONENT_ID(cecs_entity_flags));
+    if (CECS_OPTION_IS_SOME(cecs_optional_component, flags)) {
+        return *(cecs_entity_flags *)CECS_OPTION_GET_UNCHECKED(cecs_optional_component, flags);
+    } else {
+        return cecs_entity_flags_default();
+    }
+}
+
+static void cecs_world_queue_set_event(cecs_world *w, const cecs_entity_id id, const cecs_component_id component_id, const bool is_tag) {
+    if (cecs_world_events_is_observed(&w->events, component_id, cecs_event_kind_add | cecs_event_kind_mutate)) {
+        if (!cecs_world_components_has_component(&w->components, cecs_entity_id_index(id), component_id)) {
+            cecs_world_events_push(&w->events, component_id, cecs_event_kind_add, id);
+        } else if (!is_tag) {
+            cecs_world_events_push(&w->events, component_id, cecs_event_kind_mutate, id);
+        }
+    }
+}
+
+static void cecs_world_queue_set_range_events(cecs_world *w, const cecs_entity_id_range range, const cecs_component_id component_id, const bool is_tag) {
+    if (cecs_world_events_is_observed(&w->events, component_id, cecs_event_kind_add | cecs_event_kind_mutate)) {
+        for (cecs_entity_id e = (cecs_entity_id)range.start; e < (cecs_entity_id)range.end; ++e) {
+            cecs_world_queue_set_event(w, cecs_world_entities_get_id(&w->entities, e), component_id, is_tag);
+        }
+    }
+}
+
+// NOTE: every removal path raises remove events only for entities flagged has_event_on_remove
+static bool cecs_world_observes_remove(cecs_world *w, const cecs_entity_id index, const cecs_component_id component_id) {
+    return cecs_world_events_is_observed(&w->events, component_id, cecs_event_kind_remove)
+        && cecs_world_stored_entity_flags(w, index).has_event_on_remove;
+}
+
+static void cecs_world_queue_remove_range_events(cecs_world *w, const cecs_entity_id_range range, const cecs_component_id component_id) {
+    if (cecs_world_events_is_observed(&w->events, component_id, cecs_event_kind_remove)) {
+        for (cecs_entity_id e = (cecs_entity_id)range.start; e < (cecs_entity_id)range.end; ++e) {
+            if (
+                cecs_world_components_has_component(&w->components, e, component_id)
+                && cecs_world_stored_entity_flags(w, e).has_event_on_remove
+            ) {
+                cecs_world_events_push(&w->events, component_id, cecs_event_kind_remove, cecs_world_entities_get_id(&w->entities, e));
+            }
+        }
+    }
+}
+
+static void cecs_world_queue_mutable_access_event(cecs_world *w, const cecs_entity_id id, const cecs_component_id component_id) {
+    if (
+        cecs_world_events_is_observed(&w->events, component_id, cecs_event_kind_mutate)
+        && cecs_world_stored_entity_flags(w, cecs_entity_id_index(id)).has_event_on_mutate
+    ) {
+        cecs_world_events_push(&w->events, component_id, cecs_event_kind_mutate, id);
+    }
+}
+
+static void cecs_world_queue_entity_remove_events(cecs_world *w, const cecs_entity_id id, const cecs_entity_flags flags) {
+    if (w->events.observer_count == 0 || !flags.has_event_on_remove) {
+        return;
+    }
+
+    const cecs_component_id *component_ids;
+    const size_t component_count = cecs_world_components_get_entity_signature(&w->components, cecs_entity_id_index(id), &component_ids);
+    for (size_t i = 0; i < component_count; ++i) {
+        cecs_world_events_push(&w->events, component_ids[i], cecs_event_kind_remove, id);
+    }
+}
+
+static void cecs_world_queue_entity_range_remove_events(cecs_world *w, const cecs_entity_id_range range) {
+    if (w->events.observer_count == 0) {
+        return;
+    }
+
+    for (cecs_entity_id e = (cecs_entity_id)range.start; e < (cecs_entity_id)range.end; ++e) {
+        if (cecs_world_entities_has_entity_index(&w->entities, e)) {
+            cecs_world_queue_entity_remove_events(w, cecs_world_entities_get_id(&w->entities, e), cecs_world_stored_entity_flags(w, e));
+        }
+    }
+}
+
+static void cecs_world_record_remove_range_changes(cecs_world *w, const cecs_entity_id_range range, const cecs_component_id component_id) {
+    cecs_component_changes *changes;
+    if (cecs_world_changes_is_tracking(&w->changes) && cecs_world_changes_get(&w->changes, component_id, &changes)) {
+        for (cecs_entity_id e = (cecs_entity_id)range.start; e < (cecs_entity_id)range.end; ++e) {
+            if (cecs_world_components_has_component(&w->components, e, component_id)) {
+                cecs_world_changes_component_removed(&w->changes, component_id, cecs_world_entities_get_id(&w->entities, e));
+            }
+        }
+    }
+}
+
+static void cecs_world_record_clear_changes(cecs_world *w, const cecs_entity_id id) {
+    if (!cecs_world_changes_is_tracking(&w->changes)) {
+        return;
+    }
+
+    const cecs_component_id *component_ids;
+    const size_t component_count = cecs_world_components_get_entity_signature(&w->components, cecs_entity_id_index(id), &component_ids);
+    for (size_t i = 0; i < component_count; ++i) {
+        cecs_world_changes_component_removed(&w->changes, component_ids[i], id);
+    }
+}
+
+static void cecs_world_record_entity_range_clear_changes(cecs_world *w, const cecs_entity_id_range range) {
+    if (!cecs_world_changes_is_tracking(&w->changes)) {
+        return;
+    }
+
+    for (cecs_entity_id e = (cecs_entity_id)range.start; e < (cecs_entity_id)range.end; ++e) {
+        if (cecs_world_entities_has_entity_index(&w->entities, e)) {
+            cecs_world_record_clear_changes(w, cecs_world_entities_get_id(&w->entities, e));
+        }
+    }
+}
+
+static void cecs_world_record_entity_range_remove_changes(cecs_world *w, const cecs_entity_id_range range) {
+    if (!cecs_world_changes_is_tracking(&w->changes)) {
+        return;
+    }
+
+    for (cecs_entity_id e = (cecs_entity_id)range.start; e < (cecs_entity_id)range.end; ++e) {
+        if (cecs_world_entities_has_entity_index(&w->entities, e)) {
+            cecs_world_changes_entity_removed(&w->changes, cecs_world_entities_get_id(&w->entities, e));
+        }
+    }
+}
+
+static bool cecs_world_try_materialize_shared_component(
+    cecs_world *w,
+    const cecs_entity_id entity_id,
+    const cecs_component_id component_id,
+    void **out_component
+) {
+    const cecs_entity_id index = cecs_entity_id_index(entity_id);
+    const cecs_component_id shared_id = cecs_world_shared_component_id(component_id);
+    if (!cecs_world_components_has_component(&w->components, index, shared_id)) {
+        *out_component = NULL;
+        return false;
+    }
+
+    const size_t size = cecs_world_components_get_component_storage_expect(&w->components, component_id)->component_size;
+    void *shared_component = cecs_world_use_component_discard(w, size);
+    cecs_world_components_remove_component(&w->components, index, shared_id, shared_component);
+    *out_component = cecs_world_components_set_component_expect(
+        &w->components,
+        index,
+        component_id,
+        shared_component,
+        size,
+        (cecs_component_storage_descriptor) {
+            .capacity = 1,
+            .is_size_known = true,
+            .indirect_component_id = { 0 }
+        }
+    );
+    return true;
+}
+
 void *cecs_world_get_component(cecs_world* w, const cecs_entity_id entity_id, const cecs_component_id component_id) {
-    return cecs_world_components_get_component_expect(&w->components, entity_id, component_id);
+    void *component;
+    const bool found = cecs_world_try_get_component(w, entity_id, component_id, &component);
+    assert(found && "error: entity does not have the component, neither its own nor shared from a prefab");
+    (void)found;
+    return component;
 }
 
 bool cecs_world_try_get_component(cecs_world* w, const cecs_entity_id entity_id, const cecs_component_id component_id, void** out_component) {
-    cecs_optional_component component = cecs_world_components_get_component(&w->components, entity_id, component_id);
+    cecs_optional_component component = cecs_world_components_get_component(&w->components, cecs_entity_id_index(entity_id), component_id);
     if (CECS_OPTION_IS_SOME(cecs_optional_component, component)) {
         *out_component = CECS_OPTION_GET(cecs_optional_component, component);
+    } else if (!cecs_world_try_materialize_shared_component(w, entity_id, component_id, out_component)) {
+        return false;
+    }
+    cecs_world_mark_mutable_access(w, entity_id, component_id);
+    return true;
+}
+
+void cecs_world_mark_mutable_access(cecs_world *w, const cecs_entity_id entity_id, const cecs_component_id component_id) {
+    cecs_world_queue_mutable_access_event(w, entity_id, component_id);
+    cecs_world_changes_component_changed(&w->changes, component_id, entity_id);
+}
+
+bool cecs_world_is_mutable_access_recorded(const cecs_world *w, const cecs_component_id component_id) {
+    cecs_component_changes *changes;
+    return cecs_world_events_is_observed(&w->events, component_id, cecs_event_kind_mutate)
+        || cecs_world_changes_get(&w->changes, component_id, &changes);
+}
+
+const void *cecs_world_read_component(cecs_world *w, const cecs_entity_id entity_id, const cecs_component_id component_id) {
+    const void *component;
+    const bool found = cecs_world_try_read_component(w, entity_id, component_id, &component);
+    assert(found && "error: entity does not have the component, neither its own nor shared from a prefab");
+    (void)found;
+    return component;
+}
+
+bool cecs_world_try_read_component(cecs_world *w, const cecs_entity_id entity_id, const cecs_component_id component_id, const void **out_component) {
+    const cecs_entity_id index = cecs_entity_id_index(entity_id);
+    cecs_optional_component component = cecs_world_components_get_component(&w->components, index, component_id);
+    if (CECS_OPTION_IS_SOME(cecs_optional_component, component)) {
+        *out_component = CECS_OPTION_GET_UNCHECKED(cecs_optional_component, component);
+        return true;
+    }
+
+    component = cecs_world_components_get_component(&w->components, index, cecs_world_shared_component_id(component_id));
+    if (CECS_OPTION_IS_SOME(cecs_optional_component, component)) {
+        *out_component = CECS_OPTION_GET_UNCHECKED(cecs_optional_component, component);
         return true;
     } else {
         *out_component = NULL;
@@ -28,6 +229,7 @@ bool cecs_world_try_get_component(cecs_world* w, const cecs_entity_id entity_id,
 }
 
 size_t cecs_world_get_component_array(cecs_world *w, const cecs_entity_id_range range, const cecs_component_id component_id, void **out_components) {
+    cecs_world_changes_component_range_changed(&w->changes, component_id, range);
     return cecs_world_components_get_component_array(
         &w->components,
         (cecs_entity_id)range.start,
@@ -39,12 +241,7 @@ size_t cecs_world_get_component_array(cecs_world *w, const cecs_entity_id_range
 
 cecs_entity_flags cecs_world_get_entity_flags(const cecs_world* w, const cecs_entity_id entity_id) {
     assert(cecs_world_enities_has_entity(&w->entities, entity_id) && "entity with given ID does not exist");
-    cecs_entity_flags *flags = NULL;
-    if (CECS_WORLD_TRY_GET_COMPONENT(cecs_entity_flags, (cecs_world *)w, entity_id, &flags)) {
-        return *flags;
-    } else {
-        return cecs_entity_flags_default();
-    }
+    return cecs_world_stored_entity_flags((cecs_world *)w, cecs_entity_id_index(entity_id));
 }
 
 void* cecs_world_set_component(cecs_world* w, cecs_entity_id id, cecs_component_id component_id, void* component, size_t size) {
@@ -54,9 +251,11 @@ void* cecs_world_set_component(cecs_world* w, cecs_entity_id id, cecs_component_
         && "entity with given ID is inmutable and its components may not be set"
     );
 
+    cecs_world_queue_set_event(w, id, component_id, false);
+    cecs_world_changes_component_changed(&w->changes, component_id, id);
     return cecs_world_components_set_component_expect(
         &w->components,
-        id,
+        cecs_entity_id_index(id),
         component_id,
         component,
         size,
@@ -70,13 +269,15 @@ void* cecs_world_set_component(cecs_world* w, cecs_entity_id id, cecs_component_
 
 void *cecs_world_set_component_array(cecs_world *w, cecs_entity_id_range range, cecs_component_id component_id, void *components, size_t size) {
     for (cecs_entity_id e = (cecs_entity_id)range.start; e < (cecs_entity_id)range.end; ++e) {
-        assert(cecs_world_enities_has_entity(&w->entities, e) && "error: entity with given ID does not exist");
+        assert(cecs_world_entities_has_entity_index(&w->entities, e) && "error: entity with given ID does not exist");
         assert(
-            !cecs_world_get_entity_flags(w, e).is_inmutable
+            !cecs_world_get_entity_flags(w, cecs_world_entities_get_id(&w->entities, e)).is_inmutable
             && "error: entity with given ID is inmutable and its components may not be set"
         );
     }
 
+    cecs_world_queue_set_range_events(w, range, component_id, false);
+    cecs_world_changes_component_range_changed(&w->changes, component_id, range);
     return cecs_world_components_set_component_array_unchecked(
         &w->components,
         (cecs_entity_id)range.start,
@@ -94,13 +295,15 @@ void *cecs_world_set_component_array(cecs_world *w, cecs_entity_id_range range,
 
 void *cecs_world_set_component_copy_array(cecs_world *w, cecs_entity_id_range range, cecs_component_id component_id, void *component_single_src, size_t size) {
     for (cecs_entity_id e = (cecs_entity_id)range.start; e < (cecs_entity_id)range.end; ++e) {
-        assert(cecs_world_enities_has_entity(&w->entities, e) && "error: entity with given ID does not exist");
+        assert(cecs_world_entities_has_entity_index(&w->entities, e) && "error: entity with given ID does not exist");
         assert(
-            !cecs_world_get_entity_flags(w, e).is_inmutable
+            !cecs_world_get_entity_flags(w, cecs_world_entities_get_id(&w->entities, e)).is_inmutable
             && "error: entity with given ID is inmutable and its components may not be set"
         );
     }
 
+    cecs_world_queue_set_range_events(w, range, component_id, false);
+    cecs_world_changes_component_range_changed(&w->changes, component_id, range);
     return cecs_world_components_set_component_copy_array_unchecked(
         &w->components,
         (cecs_entity_id)range.start,
@@ -123,18 +326,28 @@ bool cecs_world_remove_component(cecs_world* w, cecs_entity_id id, cecs_componen
         && "entity with given ID is inmutable and components may not be removed from it"
     );
 
-    return cecs_world_components_remove_component(&w->components, id, component_id, out_removed_component);
+    const bool observes_remove = cecs_world_observes_remove(w, cecs_entity_id_index(id), component_id);
+    if (!cecs_world_components_remove_component(&w->components, cecs_entity_id_index(id), component_id, out_removed_component)) {
+        return false;
+    }
+    if (observes_remove) {
+        cecs_world_events_push(&w->events, component_id, cecs_event_kind_remove, id);
+    }
+    cecs_world_changes_component_removed(&w->changes, component_id, id);
+    return true;
 }
 
 size_t cecs_world_remove_component_array(cecs_world *w, cecs_entity_id_range range, cecs_component_id component_id, void *out_removed_components) {
     for (cecs_entity_id e = (cecs_entity_id)range.start; e < (cecs_entity_id)range.end; ++e) {
-        assert(cecs_world_enities_has_entity(&w->entities, e) && "entity with given ID does not exist");
+        assert(cecs_world_entities_has_entity_index(&w->entities, e) && "entity with given ID does not exist");
         assert(
-            !cecs_world_get_entity_flags(w, e).is_inmutable
+            !cecs_world_get_entity_flags(w, cecs_world_entities_get_id(&w->entities, e)).is_inmutable
             && "entity with given ID is inmutable and components may not be removed from it"
         );
     }
 
+    cecs_world_queue_remove_range_events(w, range, component_id);
+    cecs_world_record_remove_range_changes(w, range, component_id);
     return cecs_world_components_remove_component_array(
         &w->components,
         (cecs_entity_id)range.start,
@@ -206,7 +419,7 @@ bool cecs_world_has_tag(const cecs_world* w, cecs_entity_id id, cecs_tag_id tag_
     if (!cecs_world_enities_has_entity(&w->entities, id))
         return false;
 
-    return cecs_world_components_has_component(&w->components, id, tag_id);
+    return cecs_world_components_has_component(&w->components, cecs_entity_id_index(id), tag_id);
 }
 
 cecs_tag_id cecs_world_add_tag(cecs_world* w, cecs_entity_id id, cecs_tag_id tag_id) {
@@ -216,9 +429,11 @@ cecs_tag_id cecs_world_add_tag(cecs_world* w, cecs_entity_id id, cecs_tag_id tag
         && "entity with given ID is inmutable and tags may not be added to it"
     );
 
+    cecs_world_queue_set_event(w, id, tag_id, true);
+    cecs_world_changes_component_changed(&w->changes, tag_id, id);
     cecs_world_components_set_component(
         &w->components,
-        id,
+        cecs_entity_id_index(id),
         tag_id,
         NULL,
         0,
@@ -233,13 +448,15 @@ cecs_tag_id cecs_world_add_tag(cecs_world* w, cecs_entity_id id, cecs_tag_id tag
 
 cecs_tag_id cecs_world_add_tag_array(cecs_world *w, cecs_entity_id_range range, cecs_tag_id tag_id) {
     for (cecs_entity_id e = (cecs_entity_id)range.start; e < (cecs_entity_id)range.end; ++e) {
-        assert(cecs_world_enities_has_entity(&w->entities, e) && "error: entity with given ID does not exist");
+        assert(cecs_world_entities_has_entity_index(&w->entities, e) && "error: entity with given ID does not exist");
         assert(
-            !cecs_world_get_entity_flags(w, e).is_inmutable
+            !cecs_world_get_entity_flags(w, cecs_world_entities_get_id(&w->entities, e)).is_inmutable
             && "error: entity with given ID is inmutable and tags may not be added to it"
         );
     }
 
+    cecs_world_queue_set_range_events(w, range, tag_id, true);
+    cecs_world_changes_component_range_changed(&w->changes, tag_id, range);
     cecs_world_components_set_component_copy_array_unchecked(
         &w->components,
         (cecs_entity_id)range.start,
@@ -263,19 +480,27 @@ cecs_tag_id cecs_world_remove_tag(cecs_world* w, cecs_entity_id id, cecs_tag_id
         && "entity with given ID is inmutable and tags may not be removed from it"
     );
 
-    cecs_world_components_remove_component(&w->components, id, tag_id, &(cecs_optional_component){0});
+    const bool observes_remove = cecs_world_observes_remove(w, cecs_entity_id_index(id), tag_id);
+    if (cecs_world_components_remove_component(&w->components, cecs_entity_id_index(id), tag_id, &(cecs_optional_component){0})) {
+        if (observes_remove) {
+            cecs_world_events_push(&w->events, tag_id, cecs_event_kind_remove, id);
+        }
+        cecs_world_changes_component_removed(&w->changes, tag_id, id);
+    }
     return tag_id;
 }
 
 size_t cecs_world_remove_tag_array(cecs_world *w, cecs_entity_id_range range, cecs_tag_id tag_id) {
     for (cecs_entity_id e = (cecs_entity_id)range.start; e < (cecs_entity_id)range.end; ++e) {
-        assert(cecs_world_enities_has_entity(&w->entities, e) && "error: entity with given ID does not exist");
+        assert(cecs_world_entities_has_entity_index(&w->entities, e) && "error: entity with given ID does not exist");
         assert(
-            !cecs_world_get_entity_flags(w, e).is_inmutable
+            !cecs_world_get_entity_flags(w, cecs_world_entities_get_id(&w->entities, e)).is_inmutable
             && "error: entity with given ID is inmutable and tags may not be removed from it"
         );
     }
 
+    cecs_world_queue_remove_range_events(w, range, tag_id);
+    cecs_world_record_remove_range_changes(w, range, tag_id);
     return cecs_world_components_remove_component_array(
         &w->components,
         (cecs_entity_id)range.start,
@@ -285,6 +510,10 @@ size_t cecs_world_remove_tag_array(cecs_world *w, cecs_entity_id_range range, ce
     );
 }
 
+size_t cecs_world_compact_components(cecs_world *w, size_t first_storage_index, size_t storage_count) {
+    return cecs_world_components_compact_storages(&w->components, first_storage_index, storage_count);
+}
+
 void *cecs_world_use_component_discard(cecs_world *w, size_t size)  {
     return cecs_discard_use(&w->components.discard, &w->components.components_arena, size);
 }
@@ -295,20 +524,32 @@ void *cecs_world_use_resource_discard(cecs_world *w, size_t size) {
 
 cecs_entity_id cecs_world_add_entity(cecs_world* w) {
     cecs_entity_id e = cecs_world_entities_add_entity(&w->entities);
+    cecs_world_changes_entity_added(&w->changes, e);
 #if CECS_WORLD_FLAG_ALL_ENTITIES
     cecs_world_set_entity_flags(w, e, cecs_entity_flags_default());
 #endif
     return e;
 }
 
+// NOTE: indirect storages copy out the referenced component on removal, not the stored entity id
+static size_t cecs_world_removed_component_size(const cecs_sized_component_storage *storage) {
+    if (CECS_UNION_IS(cecs_indirect_component_storage, cecs_component_storage_union, storage->storage.storage)) {
+        return CECS_UNION_GET_UNCHECKED(cecs_indirect_component_storage, storage->storage.storage).referenced_size;
+    } else {
+        return storage->component_size;
+    }
+}
+
 cecs_entity_id cecs_world_clear_entity(cecs_world* w, cecs_entity_id entity_id) {
     assert(
         !cecs_world_get_entity_flags(w, entity_id).is_inmutable
         && "entity with given ID is inmutable and cannot be cleared"
     );
 
+    cecs_world_queue_entity_remove_events(w, entity_id, cecs_world_stored_entity_flags(w, cecs_entity_id_index(entity_id)));
+    cecs_world_record_clear_changes(w, entity_id);
     for (
-        cecs_world_components_entity_iterator it = cecs_world_components_entity_iterator_create(&w->components, entity_id);
+        cecs_world_components_entity_iterator it = cecs_world_components_entity_iterator_create(&w->components, cecs_entity_id_index(entity_id));
         !cecs_world_components_entity_iterator_done(&it);
         cecs_world_components_entity_iterator_next(&it)
         ) {
@@ -316,11 +557,12 @@ cecs_entity_id cecs_world_clear_entity(cecs_world* w, cecs_entity_id entity_id)
         cecs_component_storage_remove(
             &storage.storage->storage,
             &w->components.components_arena,
-            entity_id,
-            cecs_world_use_component_discard(w, storage.storage->component_size),
+            cecs_entity_id_index(entity_id),
+            cecs_world_use_component_discard(w, cecs_world_removed_component_size(storage.storage)),
             storage.storage->component_size
         );
     }
+    cecs_world_components_entity_signature_clear(&w->components, cecs_entity_id_index(entity_id));
     return entity_id;
 }
 
@@ -331,20 +573,25 @@ cecs_entity_id cecs_world_copy_entity_onto(cecs_world* w, cecs_entity_id destina
     );
 
     for (
-        cecs_world_components_entity_iterator it = cecs_world_components_entity_iterator_create(&w->components, source);
+        cecs_world_components_entity_iterator it = cecs_world_components_entity_iterator_create(&w->components, cecs_entity_id_index(source));
         !cecs_world_components_entity_iterator_done(&it);
         cecs_world_components_entity_iterator_next(&it)
     ) {
         cecs_associated_component_storage storage = cecs_world_components_entity_iterator_current(&it);
+        cecs_world_queue_set_event(
+            w, destination, storage.component_id, cecs_component_storage_info(&storage.storage->storage).is_unit_type_storage
+        );
+        cecs_world_changes_component_changed(&w->changes, storage.component_id, destination);
+        cecs_world_components_entity_signature_add(&w->components, cecs_entity_id_index(destination), storage.component_id);
         cecs_component_storage_set(
             &storage.storage->storage,
             &w->components.components_arena,
-            destination,
+            cecs_entity_id_index(destination),
             cecs_component_storage_info(&storage.storage->storage).is_unit_type_storage
             ? NULL
             : CECS_OPTION_GET(cecs_optional_component, cecs_component_storage_get(
                 &storage.storage->storage,
-                source,
+                cecs_entity_id_index(source),
                 storage.storage->component_size
             )),
             storage.storage->component_size
@@ -365,55 +612,54 @@ cecs_entity_id cecs_world_add_entity_copy(cecs_world* w, cecs_entity_id source)
 
 cecs_entity_id_range cecs_world_add_entity_range(cecs_world *w, size_t count) {
     cecs_entity_id_range range = cecs_world_entities_add_entity_range(&w->entities, count);
+    cecs_world_changes_entity_range_added(&w->changes, range);
 #if CECS_WORLD_FLAG_ALL_ENTITIES
-    for (cecs_entity_id e = (cecs_entity_id)range.start; e < (cecs_entity_id)range.end; ++e) {
-        cecs_world_set_entity_flags(w, e, cecs_entity_flags_default());
+    if (count > 0) {
+        cecs_world_set_entity_flags_array(w, range, cecs_entity_flags_default());
     }
 #endif
     return range;
 }
 
-size_t cecs_world_clear_entity_range(cecs_world *w, cecs_entity_id_range range, cecs_entity_id representative) {
+// NOTE: only read inside assertions, release builds never walk the range per entity
+[[maybe_unused]]
+static cecs_entity_flags cecs_world_entity_range_any_flags(cecs_world *w, cecs_entity_id_range range) {
+    cecs_entity_flags any_flags = CECS_ENTITY_FLAGS_DEFAULT;
+    for (cecs_entity_id e = (cecs_entity_id)range.start; e < (cecs_entity_id)range.end; ++e) {
+        cecs_optional_component flags = cecs_world_components_get_component(&w->components, e, CECS_COMPONENT_ID(cecs_entity_flags));
+        if (CECS_OPTION_IS_SOME(cecs_optional_component, flags)) {
+            const cecs_entity_flags entity_flags = *(cecs_entity_flags *)CECS_OPTION_GET_UNCHECKED(cecs_optional_component, flags);
+            any_flags.is_prefab |= entity_flags.is_prefab;
+            any_flags.is_inmutable |= entity_flags.is_inmutable;
+            any_flags.is_permanent |= entity_flags.is_permanent;
+            any_flags.has_event_on_remove |= entity_flags.has_event_on_remove;
+            any_flags.has_event_on_mutate |= entity_flags.has_event_on_mutate;
+        }
+    }
+    return any_flags;
+}
+
+size_t cecs_world_clear_entity_range(cecs_world *w, cecs_entity_id_range range) {
     assert(
-        !cecs_world_get_entity_flags(w, representative).is_inmutable
-        && "error: entity with given ID is inmutable and cannot be cleared"
+        !cecs_world_entity_range_any_flags(w, range).is_inmutable
+        && "error: entity range contains an inmutable entity and cannot be cleared"
     );
-
-    size_t count = 0;
-    for (
-        cecs_world_components_entity_iterator it = cecs_world_components_entity_iterator_create(&w->components, representative);
-        !cecs_world_components_entity_iterator_done(&it);
-        cecs_world_components_entity_iterator_next(&it)
-    ) {
-        cecs_associated_component_storage storage = cecs_world_components_entity_iterator_current(&it);
-        cecs_component_storage_remove_array(
-            &storage.storage->storage,
-            &w->components.components_arena,
-            range.start,
-            cecs_world_use_component_discard(w, storage.storage->component_size),
-            cecs_exclusive_range_length(range),
-            storage.storage->component_size
-        );
-        ++count;
-    }
-    return count;
+    cecs_world_queue_entity_range_remove_events(w, range);
+    cecs_world_record_entity_range_clear_changes(w, range);
+    return cecs_world_components_clear_entity_range(&w->components, range);
 }
 
+static void cecs_world_detach_entity_range(cecs_world *w, const cecs_entity_id_range range);
+
 cecs_entity_id_range cecs_world_remove_entity_range(cecs_world *w, cecs_entity_id_range range) {
-    for (cecs_entity_id e = (cecs_entity_id)range.start; e < (cecs_entity_id)range.end; ++e) {
-        assert(
-            !cecs_world_get_entity_flags(w, e).is_permanent
-            && "entity with given ID is permanent and cannot be removed"
-        );
-    }
-    
-    CECS_WORLD_SET_COMPONENT_COPY_ARRAY(
-        cecs_entity_flags,
-        w,
-        range,
-        &CECS_ENTITY_FLAGS_DEFAULT
+    assert(
+        !cecs_world_entity_range_any_flags(w, range).is_permanent
+        && "error: entity range contains a permanent entity and cannot be removed"
     );
-    cecs_world_clear_entity_range(w, range, range.start);
+    cecs_world_detach_entity_range(w, range);
+    cecs_world_queue_entity_range_remove_events(w, range);
+    cecs_world_record_entity_range_remove_changes(w, range);
+    cecs_world_components_clear_entity_range(&w->components, range);
     return cecs_world_entities_remove_entity_range(&w->entities, range);
 }
 
@@ -432,7 +678,7 @@ size_t cecs_world_copy_entity_range_onto(cecs_world *w, cecs_entity_id_range des
 
     size_t component_types_count = 0;
     for (
-        cecs_world_components_entity_iterator it = cecs_world_components_entity_iterator_create(&w->components, representative);
+        cecs_world_components_entity_iterator it = cecs_world_components_entity_iterator_create(&w->components, cecs_entity_id_index(representative));
         !cecs_world_components_entity_iterator_done(&it);
         cecs_world_components_entity_iterator_next(&it)
     ) {
@@ -471,6 +717,8 @@ size_t cecs_world_copy_entity_range_onto(cecs_world *w, cecs_entity_id_range des
             exit(EXIT_FAILURE);
         }
 
+        cecs_world_components_entity_signature_add_range(&w->components, destination, storage.component_id);
+        cecs_world_changes_component_range_changed(&w->changes, storage.component_id, destination);
         cecs_component_storage_set_array(
             &storage.storage->storage,
             &w->components.components_arena,
@@ -526,10 +774,9 @@ size_t cecs_world_copy_entity_range(
     cecs_world *w,
     cecs_entity_id_range destination,
     cecs_entity_id_range source,
-    cecs_entity_id clear_representative,
     cecs_entity_id copy_representative
 ) {
-    cecs_world_clear_entity_range(w, destination, clear_representative);
+    cecs_world_clear_entity_range(w, destination);
     return cecs_world_copy_entity_range_onto(w, destination, source, copy_representative);
 }
 
@@ -541,20 +788,22 @@ void* cecs_world_copy_entity_onto_and_grab(cecs_world* w, cecs_entity_id destina
 
     void* grabbed = NULL;
     for (
-        cecs_world_components_entity_iterator it = cecs_world_components_entity_iterator_create(&w->components, source);
+        cecs_world_components_entity_iterator it = cecs_world_components_entity_iterator_create(&w->components, cecs_entity_id_index(source));
         !cecs_world_components_entity_iterator_done(&it);
         cecs_world_components_entity_iterator_next(&it)
         ) {
         cecs_associated_component_storage storage = cecs_world_components_entity_iterator_current(&it);
+        cecs_world_components_entity_signature_add(&w->components, cecs_entity_id_index(destination), storage.component_id);
+        cecs_world_changes_component_changed(&w->changes, storage.component_id, destination);
         cecs_optional_component copied_component = cecs_component_storage_set(
             &storage.storage->storage,
             &w->components.components_arena,
-            destination,
+            cecs_entity_id_index(destination),
             cecs_component_storage_info(&storage.storage->storage).is_unit_type_storage
             ? NULL
             : CECS_OPTION_GET(cecs_optional_component, cecs_component_storage_get(
                 &storage.storage->storage,
-                source,
+                cecs_entity_id_index(source),
                 storage.storage->component_size
             )),
             storage.storage->component_size
@@ -573,23 +822,207 @@ void* cecs_world_copy_entity_and_grab(cecs_world* w, cecs_entity_id destination,
     return cecs_world_copy_entity_onto_and_grab(w, destination, source, grab_component_id);
 }
 
-static cecs_target_holder_id cecs_world_get_or_add_relation_target(cecs_world *w, cecs_entity_id source, cecs_relation_target target, bool *out_created_new) {
+static void cecs_world_add_relation_wildcards(cecs_world *w, const cecs_entity_id source, const cecs_relation_id_descriptor added) {
+    cecs_world_add_tag(w, source, cecs_relation_id_create_any_target(added.component_id));
+#if CECS_WORLD_ANY_COMPONENT_WILDCARDS
+    cecs_world_add_tag(w, source, cecs_relation_id_create_any_component(added.target.tag_id));
+#endif
+}
+
+static bool cecs_world_has_pair_targets(const cecs_world *w, const cecs_entity_id source_index, const cecs_component_id component_id) {
+    cecs_relation_pair_table *table;
+    return cecs_relation_pair_tables_get(&w->relations.pair_tables, component_id, &table)
+        && cecs_relation_pair_table_get_links(table, source_index).target_count > 0;
+}
+
+// NOTE: holders keep one component or tag per relation of their source to the target, the source relation id confirms it
+static bool cecs_world_has_recorded_relation(
+    const cecs_world *w,
+    const cecs_entity_id source_index,
+    const cecs_component_id component_id,
+    const cecs_relation_target target
+) {
+    return cecs_world_components_has_component(
+        &w->components, source_index, cecs_relation_id_create((cecs_relation_id_descriptor){ component_id, target })
+    );
+}
+
+static bool cecs_world_has_relation_component(cecs_world *w, const cecs_entity_id source_index, const cecs_component_id component_id) {
+    cecs_relation_targets_iterator targets;
+    if (!cecs_world_relations_get_targets(&w->relations, source_index, &targets)) {
+        return false;
+    }
+    for (; !cecs_sparse_set_iterator_done(&targets, sizeof(cecs_target_holder_info)); cecs_sparse_set_iterator_next(&targets)) {
+        const cecs_relation_target target = { (cecs_tag_id)cecs_sparse_set_iterator_current_key(&targets) };
+        if (cecs_world_has_recorded_relation(w, source_index, component_id, target)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool cecs_world_has_relation_to(
+    const cecs_world *w,
+    const cecs_entity_id source_index,
+    const cecs_relation_target target,
+    const cecs_target_holder_id holder
+) {
+    const cecs_component_id *component_ids;
+    const size_t component_count = cecs_world_components_get_entity_signature(&w->components, cecs_entity_id_index(holder), &component_ids);
+    for (size_t i = 0; i < component_count; ++i) {
+        if (cecs_world_has_recorded_relation(w, source_index, component_ids[i], target)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void cecs_world_remove_wildcard(cecs_world *w, const cecs_entity_id source, const cecs_relation_id wildcard) {
+    if (cecs_world_has_tag(w, source, wildcard)) {
+        cecs_world_remove_tag(w, source, wildcard);
+    }
+}
+
+static void cecs_world_remove_pair_wildcard(cecs_world *w, const cecs_entity_id source, const cecs_component_id component_id) {
+    const cecs_entity_id source_index = cecs_entity_id_index(source);
+    if (!cecs_world_has_pair_targets(w, source_index, component_id) && !cecs_world_has_relation_component(w, source_index, component_id)) {
+        cecs_world_remove_wildcard(w, source, cecs_relation_id_create_any_target(component_id));
+    }
+}
+
+// NOTE: wildcard tags stay while any other relation of the source still matches them
+static void cecs_world_remove_relation_wildcards(cecs_world *w, const cecs_entity_id source, const cecs_relation_id_descriptor removed) {
+    cecs_world_remove_pair_wildcard(w, source, removed.component_id);
+
+#if CECS_WORLD_ANY_COMPONENT_WILDCARDS
+    cecs_target_holder_id holder;
+    if (
+        !cecs_world_relations_get_target(&w->relations, cecs_entity_id_index(source), removed.target, &holder)
+        || !cecs_world_has_relation_to(w, cecs_entity_id_index(source), removed.target, holder)
+    ) {
+        cecs_world_remove_wildcard(w, source, cecs_relation_id_create_any_component(removed.target.tag_id));
+    }
+#endif
+}
+
+static cecs_relation_cleanup_policy cecs_world_relation_cleanup_policy_to(
+    const cecs_world *w,
+    const cecs_entity_id source_index,
+    const cecs_relation_target target,
+    const cecs_target_holder_id holder
+) {
+    // NOTE: the strictest policy among the source's relations to the target wins
+    cecs_relation_cleanup_policy policy = cecs_relation_cleanup_policy_remove_relation;
+    const cecs_component_id *component_ids;
+    const size_t component_count = cecs_world_components_get_entity_signature(&w->components, cecs_entity_id_index(holder), &component_ids);
+    for (size_t i = 0; i < component_count; ++i) {
+        if (cecs_world_has_recorded_relation(w, source_index, component_ids[i], target)) {
+            const cecs_relation_cleanup_policy relation_policy =
+                cecs_world_relations_get_cleanup_policy(&w->relations, component_ids[i]);
+            policy = max(policy, relation_policy);
+        }
+    }
+    return policy;
+}
+
+static void cecs_world_remove_component_discarded(cecs_world *w, const cecs_entity_id id, const cecs_component_id component_id) {
+    cecs_world_remove_component(
+        w,
+        id,
+        component_id,
+        cecs_world_use_component_discard(
+            w, cecs_world_removed_component_size(cecs_world_components_get_component_storage_expect(&w->components, component_id))
+        )
+    );
+}
+
+static void cecs_world_remove_relations_to(
+    cecs_world *w,
+    const cecs_entity_id source,
+    const cecs_relation_target target,
+    const cecs_target_holder_id holder,
+    cecs_arena *cleanup_arena
+) {
+    const cecs_entity_id source_index = cecs_entity_id_index(source);
+    const cecs_component_id *holder_component_ids;
+    const size_t holder_component_count =
+        cecs_world_components_get_entity_signature(&w->components, cecs_entity_id_index(holder), &holder_component_ids);
+    cecs_dynamic_array relation_components = cecs_dynamic_array_create();
+    for (size_t i = 0; i < holder_component_count; ++i) {
+        if (cecs_world_has_recorded_relation(w, source_index, holder_component_ids[i], target)) {
+            CECS_DYNAMIC_ARRAY_ADD(cecs_component_id, &relation_components, cleanup_arena, &holder_component_ids[i]);
+        }
+    }
+
+    // NOTE: the holder keeps its components until it is released, only the source relation ids and wildcards go here
+    for (size_t i = 0; i < CECS_DYNAMIC_ARRAY_COUNT(cecs_component_id, &relation_components); ++i) {
+        const cecs_component_id component_id = *CECS_DYNAMIC_ARRAY_GET(cecs_component_id, &relation_components, i);
+        cecs_world_remove_component_discarded(
+            w, source, cecs_relation_id_create((cecs_relation_id_descriptor){ component_id, target })
+        );
+#if CECS_WORLD_UNIQUE_RELATION_COMPONENTS
+        cecs_world_remove_component_discarded(w, source, component_id);
+#endif
+        cecs_world_remove_relation_wildcards(w, source, (cecs_relation_id_descriptor){ component_id, target });
+    }
+}
+
+static void cecs_world_release_relation_holders(cecs_world *w, const cecs_target_holder_id *holders, const size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        cecs_world_clear_entity(w, holders[i]);
+    }
+    cecs_world_relations_recycle_holders(&w->relations, holders, count);
+}
+
+static void cecs_world_release_relation_target_if_unused(cecs_world *w, const cecs_entity_id source, const cecs_tag_id target_id) {
+    const cecs_entity_id source_index = cecs_entity_id_index(source);
+    const cecs_relation_target target = { cecs_entity_id_index(target_id) };
+    cecs_target_holder_id holder;
+    if (
+        cecs_world_relations_get_target(&w->relations, source_index, target, &holder)
+        && !cecs_world_has_relation_to(w, source_index, target, holder)
+        && cecs_world_relations_remove_target(&w->relations, source_index, target, &holder)
+    ) {
+        cecs_world_release_relation_holders(w, &holder, 1);
+    }
+}
+
+static cecs_target_holder_id cecs_world_get_or_add_relation_target(
+    cecs_world *w,
+    cecs_entity_id source,
+    cecs_relation_target target,
+    cecs_relation_target_kind target_kind,
+    bool *out_created_new
+) {
+    assert(target.tag_id != CECS_RELATION_TARGET_WILDCARD && "error: relation target is reserved for wildcard relation ids");
     *out_created_new = false;
     cecs_target_holder_id holder;
-    if (!cecs_world_relations_get_target(&w->relations, source, target, &holder)) {
-        holder = cecs_world_add_entity(w);
-        bool added = cecs_world_relations_add_target_holder(&w->relations, source, target, holder);
+    if (!cecs_world_relations_get_target(&w->relations, cecs_entity_id_index(source), target, &holder)) {
+        if (!cecs_world_relations_take_recycled_holder(&w->relations, &holder)) {
+            holder = cecs_world_add_entity(w);
+        }
+        bool added = cecs_world_relations_add_target_holder(&w->relations, cecs_entity_id_index(source), target, target_kind, holder);
         assert(added && "fatal error: failed to add relation target holder");
         *out_created_new = true;
     }
     return holder;
 }
 
-void* cecs_world_set_component_relation(cecs_world* w, cecs_entity_id id, cecs_component_id component_id, void* component, size_t size, cecs_tag_id tag_id) {
+static void *cecs_world_set_component_relation_of_kind(
+    cecs_world *w,
+    cecs_entity_id id,
+    cecs_component_id component_id,
+    void *component,
+    size_t size,
+    cecs_tag_id tag_id,
+    cecs_relation_target_kind target_kind
+) {
     assert(cecs_world_enities_has_entity(&w->entities, id) && "entity with given ID does not exist");
     
     bool created_new;
-    cecs_target_holder_id holder = cecs_world_get_or_add_relation_target(w, id, (cecs_relation_target) {tag_id}, &created_new);
+    cecs_target_holder_id holder = cecs_world_get_or_add_relation_target(
+        w, id, (cecs_relation_target) {cecs_entity_id_index(tag_id)}, target_kind, &created_new
+    );
     
     if (created_new) {
         cecs_world_set_component(
@@ -599,7 +1032,6 @@ void* cecs_world_set_component_relation(cecs_world* w, cecs_entity_id id, cecs_c
             &(cecs_relation_entity_reference){id},
             sizeof(cecs_relation_entity_reference)
         );
-        *cecs_world_get_or_set_default_entity_flags(w, id) = (cecs_entity_flags){ .is_permanent = true };
     }
 
     void* component_source =
@@ -624,9 +1056,9 @@ void* cecs_world_set_component_relation(cecs_world* w, cecs_entity_id id, cecs_c
     );
     void *indirect_component = cecs_world_components_set_component_expect(
         &w->components,
-        id,
-        cecs_relation_id_create(cecs_relation_id_descriptor_create_tag(component_id, tag_id)),
-        &holder,
+        cecs_entity_id_index(id),
+        cecs_relation_id_create(cecs_relation_id_descriptor_create_tag(component_id, cecs_entity_id_index(tag_id))),
+        &(cecs_entity_id){cecs_entity_id_index(holder)},
         sizeof(cecs_entity_id),
         (cecs_component_storage_descriptor) {
             .capacity = 1,
@@ -636,25 +1068,45 @@ void* cecs_world_set_component_relation(cecs_world* w, cecs_entity_id id, cecs_c
         }
     );
     assert(indirect_component == holder_component && "error: stored indirect component does not match holder component");
+    cecs_world_add_relation_wildcards(w, id, cecs_relation_id_descriptor_create_tag(component_id, cecs_entity_id_index(tag_id)));
     return indirect_component;
 }
 
+void* cecs_world_set_component_relation(cecs_world* w, cecs_entity_id id, cecs_component_id component_id, void* component, size_t size, cecs_tag_id tag_id) {
+    return cecs_world_set_component_relation_of_kind(w, id, component_id, component, size, tag_id, cecs_relation_target_kind_entity);
+}
+
+void *cecs_world_set_component_relation_to_tag(
+    cecs_world *w,
+    cecs_entity_id id,
+    cecs_component_id component_id,
+    void *component,
+    size_t size,
+    cecs_tag_id target_tag_id
+) {
+    return cecs_world_set_component_relation_of_kind(w, id, component_id, component, size, target_tag_id, cecs_relation_target_kind_tag);
+}
+
 void* cecs_world_get_component_relation(cecs_world* w, const cecs_entity_id id, const cecs_component_id component_id, const cecs_tag_id tag_id) {
     assert(cecs_world_enities_has_entity(&w->entities, id) && "entity with given ID does not exist");
-    return cecs_world_get_component(w, id, cecs_relation_id_create(cecs_relation_id_descriptor_create_tag(component_id, tag_id)));
+    return cecs_world_get_component(
+        w, id, cecs_relation_id_create(cecs_relation_id_descriptor_create_tag(component_id, cecs_entity_id_index(tag_id)))
+    );
 }
 
 bool cecs_world_remove_component_relation(cecs_world* w, cecs_entity_id id, cecs_component_id component_id, void* out_removed_component, cecs_tag_id tag_id) {
     assert(cecs_world_enities_has_entity(&w->entities, id) && "entity with given ID does not exist");
     cecs_target_holder_id holder;
-    if (!cecs_world_relations_get_target(&w->relations, id, (cecs_relation_target) { tag_id }, &holder)) {
+    if (!cecs_world_relations_get_target(
+        &w->relations, cecs_entity_id_index(id), (cecs_relation_target) { cecs_entity_id_index(tag_id) }, &holder
+    )) {
         return false;
     }
 
-    return cecs_world_remove_component(
+    const bool removed = cecs_world_remove_component(
         w,
         id,
-        cecs_relation_id_create(cecs_relation_id_descriptor_create_tag(component_id, tag_id)),
+        cecs_relation_id_create(cecs_relation_id_descriptor_create_tag(component_id, cecs_entity_id_index(tag_id))),
         out_removed_component
     )
 #if CECS_WORLD_UNIQUE_RELATION_COMPONENTS
@@ -666,14 +1118,24 @@ bool cecs_world_remove_component_relation(cecs_world* w, cecs_entity_id id, cecs
             component_id,
             out_removed_component
         );
+    cecs_world_remove_relation_wildcards(w, id, cecs_relation_id_descriptor_create_tag(component_id, cecs_entity_id_index(tag_id)));
+    cecs_world_release_relation_target_if_unused(w, id, tag_id);
+    return removed;
 }
 
-cecs_tag_id cecs_world_add_tag_relation(cecs_world* w, cecs_entity_id id, cecs_tag_id tag, cecs_tag_id target_tag_id) {
+static cecs_tag_id cecs_world_add_tag_relation_of_kind(
+    cecs_world *w,
+    cecs_entity_id id,
+    cecs_tag_id tag,
+    cecs_tag_id target_tag_id,
+    cecs_relation_target_kind target_kind
+) {
     assert(cecs_world_enities_has_entity(&w->entities, id) && "entity with given ID does not exist");
     
     bool created_new;
-    cecs_target_holder_id holder =
-        cecs_world_get_or_add_relation_target(w, id, (cecs_relation_target){ target_tag_id }, &created_new);
+    cecs_target_holder_id holder = cecs_world_get_or_add_relation_target(
+        w, id, (cecs_relation_target){ cecs_entity_id_index(target_tag_id) }, target_kind, &created_new
+    );
     if (created_new) {
         cecs_world_set_component(
             w,
@@ -682,7 +1144,6 @@ cecs_tag_id cecs_world_add_tag_relation(cecs_world* w, cecs_entity_id id, cecs_t
             &(cecs_relation_entity_reference){id},
             sizeof(cecs_relation_entity_reference)
         );
-        *cecs_world_get_or_set_default_entity_flags(w, id) = (cecs_entity_flags){ .is_permanent = true };
     }
 
     cecs_tag_id tag_source =
@@ -705,24 +1166,35 @@ cecs_tag_id cecs_world_add_tag_relation(cecs_world* w, cecs_entity_id id, cecs_t
         w,
         id,
         cecs_relation_id_create(
-            cecs_relation_id_descriptor_create_tag(tag, target_tag_id)
+            cecs_relation_id_descriptor_create_tag(tag, cecs_entity_id_index(target_tag_id))
         )
     );
+    cecs_world_add_relation_wildcards(w, id, cecs_relation_id_descriptor_create_tag(tag, cecs_entity_id_index(target_tag_id)));
 
     return tag_id;
 }
 
+cecs_tag_id cecs_world_add_tag_relation(cecs_world* w, cecs_entity_id id, cecs_tag_id tag, cecs_tag_id target_tag_id) {
+    return cecs_world_add_tag_relation_of_kind(w, id, tag, target_tag_id, cecs_relation_target_kind_entity);
+}
+
+cecs_tag_id cecs_world_add_tag_relation_to_tag(cecs_world *w, cecs_entity_id id, cecs_tag_id tag, cecs_tag_id target_tag_id) {
+    return cecs_world_add_tag_relation_of_kind(w, id, tag, target_tag_id, cecs_relation_target_kind_tag);
+}
+
 bool cecs_world_remove_tag_relation(cecs_world* w, cecs_entity_id id, cecs_tag_id tag, cecs_tag_id target_tag_id) {
     assert(cecs_world_enities_has_entity(&w->entities, id) && "entity with given ID does not exist");
     cecs_target_holder_id holder;
-    if (!cecs_world_relations_get_target(&w->relations, id, (cecs_relation_target) { target_tag_id }, &holder)) {
+    if (!cecs_world_relations_get_target(
+        &w->relations, cecs_entity_id_index(id), (cecs_relation_target) { cecs_entity_id_index(target_tag_id) }, &holder
+    )) {
         return false;
     }
 
-    return cecs_world_remove_tag(
+    const bool removed = cecs_world_remove_tag(
         w,
         id,
-        cecs_relation_id_create(cecs_relation_id_descriptor_create_tag(tag, target_tag_id))
+        cecs_relation_id_create(cecs_relation_id_descriptor_create_tag(tag, cecs_entity_id_index(target_tag_id)))
     )
 #if CECS_WORLD_UNIQUE_RELATION_COMPONENTS
         && cecs_world_remove_tag(w, id, tag)
@@ -732,18 +1204,156 @@ bool cecs_world_remove_tag_relation(cecs_world* w, cecs_entity_id id, cecs_tag_i
             holder,
             tag
         );
+    cecs_world_remove_relation_wildcards(w, id, cecs_relation_id_descriptor_create_tag(tag, cecs_entity_id_index(target_tag_id)));
+    cecs_world_release_relation_target_if_unused(w, id, target_tag_id);
+    return removed;
+}
+
+void *cecs_world_set_pair(
+    cecs_world *w,
+    cecs_entity_id source,
+    cecs_component_id component_id,
+    const void *component,
+    size_t size,
+    cecs_entity_id target
+) {
+    assert(cecs_world_enities_has_entity(&w->entities, source) && "entity with given ID does not exist");
+    assert(cecs_world_enities_has_entity(&w->entities, target) && "error: relation pair target does not exist");
+    assert(
+        cecs_entity_id_index(target) != CECS_RELATION_TARGET_WILDCARD
+        && "error: relation target is reserved for wildcard relation ids"
+    );
+
+    cecs_relation_pair_table *table = cecs_relation_pair_tables_get_or_add(
+        &w->relations.pair_tables, &w->relations.associations_arena, component_id, size
+    );
+    bool added;
+    void *pair_component = cecs_relation_pair_table_set(table, &w->relations.associations_arena, source, target, component, &added);
+    if (added && cecs_relation_pair_table_get_links(table, source).target_count == 1) {
+        cecs_world_add_tag(w, source, cecs_relation_id_create_any_target(component_id));
+    }
+    return pair_component;
+}
+
+bool cecs_world_try_get_pair(
+    const cecs_world *w,
+    cecs_entity_id source,
+    cecs_component_id component_id,
+    cecs_entity_id target,
+    void **out_component
+) {
+    cecs_relation_pair_table *table;
+    cecs_relation_pair *pair;
+    if (
+        cecs_relation_pair_tables_get(&w->relations.pair_tables, component_id, &table)
+        && cecs_relation_pair_table_get(table, source, target, &pair)
+    ) {
+        *out_component = cecs_relation_pair_component(pair);
+        return true;
+    } else {
+        *out_component = NULL;
+        return false;
+    }
+}
+
+bool cecs_world_remove_pair(
+    cecs_world *w,
+    cecs_entity_id source,
+    cecs_component_id component_id,
+    cecs_entity_id target,
+    void *out_removed_component
+) {
+    cecs_relation_pair_table *table;
+    if (
+        !cecs_relation_pair_tables_get(&w->relations.pair_tables, component_id, &table)
+        || !cecs_relation_pair_table_remove(table, &w->relations.associations_arena, source, target, out_removed_component)
+    ) {
+        return false;
+    }
+    cecs_world_remove_pair_wildcard(w, source, component_id);
+    return true;
+}
+
+cecs_relation_pair_iterator cecs_world_get_pair_targets(const cecs_world *w, cecs_entity_id source, cecs_component_id component_id) {
+    cecs_relation_pair_table *table;
+    if (cecs_relation_pair_tables_get(&w->relations.pair_tables, component_id, &table)) {
+        return cecs_relation_pair_iterator_create_targets(table, source);
+    } else {
+        return (cecs_relation_pair_iterator){ .current = CECS_RELATION_PAIR_INDEX_NONE };
+    }
+}
+
+cecs_relation_pair_iterator cecs_world_get_pair_sources(const cecs_world *w, cecs_entity_id target, cecs_component_id component_id) {
+    cecs_relation_pair_table *table;
+    if (cecs_relation_pair_tables_get(&w->relations.pair_tables, component_id, &table)) {
+        return cecs_relation_pair_iterator_create_sources(table, target);
+    } else {
+        return (cecs_relation_pair_iterator){ .current = CECS_RELATION_PAIR_INDEX_NONE };
+    }
 }
 
 cecs_relation_targets_iterator cecs_world_get_associated_ids(cecs_world* w, cecs_entity_id id) {
     assert(cecs_world_enities_has_entity(&w->entities, id) && "entity with given ID does not exist");
 
     cecs_relation_targets_iterator it;
-    bool has_relations = cecs_world_relations_get_targets(&w->relations, id, &it);
+    bool has_relations = cecs_world_relations_get_targets(&w->relations, cecs_entity_id_index(id), &it);
     assert(has_relations && "error: entity with given ID has no associated entities");
 
     return it;
 }
 
+bool cecs_world_get_relation_sources(cecs_world *w, cecs_tag_id target_id, cecs_relation_sources_iterator *out_iterator) {
+    return cecs_world_relations_get_sources(&w->relations, (cecs_relation_target){ cecs_entity_id_index(target_id) }, out_iterator);
+}
+
+size_t cecs_world_get_relation_source_count(const cecs_world *w, cecs_tag_id target_id) {
+    return cecs_world_relations_source_count(&w->relations, (cecs_relation_target){ cecs_entity_id_index(target_id) });
+}
+
+cecs_observer *cecs_world_add_observer(
+    cecs_world *w,
+    cecs_component_id component_id,
+    cecs_event_kind_flags kinds,
+    cecs_observer_predicate *predicate,
+    void *user_data
+) {
+    return cecs_world_events_add_observer(&w->events, component_id, (cecs_observer){
+        .predicate = predicate,
+        .user_data = user_data,
+        .kinds = kinds
+    });
+}
+
+size_t cecs_world_remove_observers(cecs_world *w, cecs_component_id component_id, cecs_observer_predicate *predicate) {
+    return cecs_world_events_remove_observers(&w->events, component_id, predicate);
+}
+
+void cecs_world_set_remove_hook(cecs_world *w, cecs_component_id component_id, cecs_remove_hook *hook) {
+    cecs_world_events_set_remove_hook(&w->events, component_id, hook);
+}
+
+void cecs_world_emit_mutated(cecs_world *w, cecs_entity_id id, cecs_component_id component_id) {
+    assert(cecs_world_enities_has_entity(&w->entities, id) && "entity with given ID does not exist");
+    cecs_world_events_push(&w->events, component_id, cecs_event_kind_mutate, id);
+    cecs_world_changes_component_changed(&w->changes, component_id, id);
+}
+
+size_t cecs_world_dispatch_events(cecs_world *w) {
+    return cecs_world_events_dispatch(&w->events, w);
+}
+
+cecs_component_changes *cecs_world_track_changes(cecs_world *w, cecs_component_id component_id) {
+    return cecs_world_changes_track_component(&w->changes, component_id);
+}
+
+cecs_change_tick cecs_world_advance_change_tick(cecs_world *w) {
+    return cecs_world_changes_advance_tick(&w->changes);
+}
+
+size_t cecs_world_trim_changes(cecs_world *w, cecs_change_tick tick) {
+    return cecs_world_changes_trim(&w->changes, tick);
+}
+
 cecs_resource_handle cecs_world_set_resource(cecs_world* w, cecs_resource_id id, void* resource, size_t size) {
     return cecs_world_resources_set_resource(&w->resources, id, resource, size);
 }
@@ -760,22 +1370,270 @@ bool cecs_world_remove_resource_out(cecs_world* w, cecs_resource_id id, cecs_res
     return cecs_world_resources_remove_resource_out(&w->resources, id, out_resource, size);
 }
 
-cecs_entity_id cecs_world_remove_entity(cecs_world* w, cecs_entity_id entity_id) {
+cecs_resource_handle cecs_world_borrow_resource(cecs_world *w, cecs_resource_id id, cecs_resource_access_mode access) {
+    return cecs_world_resources_borrow_resource(&w->resources, id, access);
+}
+
+void cecs_world_release_resource(cecs_world *w, cecs_resource_id id, cecs_resource_access_mode access) {
+    cecs_world_resources_release_resource(&w->resources, id, access);
+}
+
+cecs_event_channel *cecs_world_add_event_channel(cecs_world *w, cecs_resource_id channel_id, size_t event_size) {
+    cecs_world_events_add_event_channel_id(&w->events, channel_id);
+    if (cecs_world_resources_has_resource(&w->resources, channel_id)) {
+        cecs_event_channel *channel = cecs_world_resources_get_resource(&w->resources, channel_id);
+        assert(channel->event_size == event_size && "error: event channel already exists with a different event size");
+        return channel;
+    }
+    cecs_event_channel channel = cecs_event_channel_create(event_size);
+    return cecs_world_resources_set_resource(&w->resources, channel_id, &channel, sizeof(cecs_event_channel));
+}
+
+cecs_event_channel *cecs_world_get_event_channel(const cecs_world *w, cecs_resource_id channel_id) {
+    return cecs_world_resources_get_resource(&w->resources, channel_id);
+}
+
+void *cecs_world_write_event(cecs_world *w, cecs_resource_id channel_id, const void *event, size_t size) {
+    return cecs_event_channel_write(cecs_world_get_event_channel(w, channel_id), &w->resources.resources_arena, event, size);
+}
+
+size_t cecs_world_read_events(const cecs_world *w, cecs_resource_id channel_id, const void **out_events, size_t size) {
+    return cecs_event_channel_read(cecs_world_get_event_channel(w, channel_id), out_events, size);
+}
+
+void cecs_world_swap_event_channels(cecs_world *w) {
+    for (size_t i = 0; i < cecs_world_events_event_channel_count(&w->events); ++i) {
+        const cecs_resource_id channel_id = cecs_world_events_event_channel_id(&w->events, i);
+        if (cecs_world_resources_has_resource(&w->resources, channel_id)) {
+            cecs_event_channel_swap(cecs_world_get_event_channel(w, channel_id));
+        }
+    }
+}
+
+static void cecs_world_run_remove_hooks(cecs_world *w, const cecs_entity_id entity_id) {
+    for (size_t i = 0; i < cecs_world_events_remove_hook_count(&w->events); ++i) {
+        // NOTE: hooks may set other hooks, the hook is copied out before it runs
+        const cecs_component_remove_hook hook = *cecs_world_events_remove_hook_at(&w->events, i);
+        if (cecs_world_components_has_component(&w->components, cecs_entity_id_index(entity_id), hook.component_id)) {
+            hook.hook(w, entity_id);
+        }
+    }
+}
+
+static cecs_entity_id cecs_world_remove_unrelated_entity(cecs_world *w, cecs_entity_id entity_id) {
     assert(
         !cecs_world_get_entity_flags(w, entity_id).is_permanent
         && "entity with given ID is permanent and cannot be removed"
     );
 
+    cecs_world_run_remove_hooks(w, entity_id);
+
+    // NOTE: flags are reset before clearing, the remove events are queued while the entity is still flagged
+    cecs_world_queue_entity_remove_events(w, entity_id, cecs_world_stored_entity_flags(w, cecs_entity_id_index(entity_id)));
+    cecs_world_changes_entity_removed(&w->changes, entity_id);
     cecs_world_set_entity_flags(w, entity_id, cecs_entity_flags_default());
     cecs_world_clear_entity(w, entity_id);
     return cecs_world_entities_remove_entity(&w->entities, entity_id);
 }
 
+static void cecs_world_detach_relations(
+    cecs_world *w,
+    const cecs_entity_id entity_id,
+    cecs_arena *cleanup_arena,
+    cecs_dynamic_array *removed_entities,
+    cecs_dynamic_array *released_holders
+) {
+    const cecs_entity_id index = cecs_entity_id_index(entity_id);
+    cecs_dynamic_array associated = cecs_dynamic_array_create();
+
+    cecs_relation_targets_iterator targets;
+    if (cecs_world_relations_get_targets(&w->relations, index, &targets)) {
+        for (; !cecs_sparse_set_iterator_done(&targets, sizeof(cecs_target_holder_info)); cecs_sparse_set_iterator_next(&targets)) {
+            const cecs_entity_id target_index = (cecs_entity_id)cecs_sparse_set_iterator_current_key(&targets);
+            CECS_DYNAMIC_ARRAY_ADD(cecs_entity_id, &associated, cleanup_arena, &target_index);
+        }
+        for (size_t i = 0; i < CECS_DYNAMIC_ARRAY_COUNT(cecs_entity_id, &associated); ++i) {
+            cecs_target_holder_id holder;
+            if (cecs_world_relations_remove_target(
+                &w->relations, index, (cecs_relation_target){ *CECS_DYNAMIC_ARRAY_GET(cecs_entity_id, &associated, i) }, &holder
+            )) {
+                CECS_DYNAMIC_ARRAY_ADD(cecs_target_holder_id, released_holders, cleanup_arena, &holder);
+            }
+        }
+        cecs_dynamic_array_clear(&associated);
+    }
+
+    cecs_relation_sources_iterator sources;
+    const cecs_relation_target target = { index };
+    if (cecs_world_relations_get_sources(&w->relations, target, &sources)) {
+        for (; !cecs_sparse_set_iterator_done(&sources, sizeof(cecs_target_holder_info)); cecs_sparse_set_iterator_next(&sources)) {
+            const cecs_entity_id source_index = (cecs_entity_id)cecs_sparse_set_iterator_current_key(&sources);
+            CECS_DYNAMIC_ARRAY_ADD(cecs_entity_id, &associated, cleanup_arena, &source_index);
+        }
+        for (size_t i = 0; i < CECS_DYNAMIC_ARRAY_COUNT(cecs_entity_id, &associated); ++i) {
+            const cecs_entity_id source_index = *CECS_DYNAMIC_ARRAY_GET(cecs_entity_id, &associated, i);
+            cecs_target_holder_id holder;
+            if (!cecs_world_relations_get_target(&w->relations, source_index, target, &holder)) {
+                continue;
+            }
+
+            switch (cecs_world_relation_cleanup_policy_to(w, source_index, target, holder)) {
+            case cecs_relation_cleanup_policy_remove_relation: {
+                cecs_world_remove_relations_to(
+                    w, cecs_world_entities_get_id(&w->entities, source_index), target, holder, cleanup_arena
+                );
+                if (cecs_world_relations_remove_target(&w->relations, source_index, target, &holder)) {
+                    CECS_DYNAMIC_ARRAY_ADD(cecs_target_holder_id, released_holders, cleanup_arena, &holder);
+                }
+                break;
+            }
+            case cecs_relation_cleanup_policy_orphan:
+                cecs_world_relations_orphan_source(&w->relations, source_index, target);
+                break;
+            case cecs_relation_cleanup_policy_delete_sources: {
+                const cecs_entity_id source = cecs_world_entities_get_id(&w->entities, source_index);
+                CECS_DYNAMIC_ARRAY_ADD(cecs_entity_id, removed_entities, cleanup_arena, &source);
+                break;
+            }
+            default: {
+                assert(false && "unreachable: invalid relation cleanup policy");
+                exit(EXIT_FAILURE);
+                break;
+            }
+            }
+        }
+    }
+}
+
+static void cecs_world_detach_pairs(
+    cecs_world *w,
+    const cecs_entity_id entity_id,
+    cecs_arena *cleanup_arena,
+    cecs_dynamic_array *removed_entities
+) {
+    const cecs_entity_id index = cecs_entity_id_index(entity_id);
+    cecs_dynamic_array associated = cecs_dynamic_array_create();
+    for (size_t i = 0; i < cecs_relation_pair_tables_count(&w->relations.pair_tables); ++i) {
+        cecs_relation_pair_table *table = cecs_relation_pair_tables_at(&w->relations.pair_tables, i);
+        const cecs_relation_pair_links links = cecs_relation_pair_table_get_links(table, index);
+        if (links.target_count == 0 && links.source_count == 0) {
+            continue;
+        }
+
+        cecs_dynamic_array_clear(&associated);
+        for (
+            cecs_relation_pair_iterator it = cecs_relation_pair_iterator_create_targets(table, index);
+            !cecs_relation_pair_iterator_done(&it);
+            cecs_relation_pair_iterator_next(&it)
+        ) {
+            const cecs_entity_id target = cecs_relation_pair_target_id(cecs_relation_pair_iterator_current(&it));
+            CECS_DYNAMIC_ARRAY_ADD(cecs_entity_id, &associated, cleanup_arena, &target);
+        }
+        for (size_t j = 0; j < CECS_DYNAMIC_ARRAY_COUNT(cecs_entity_id, &associated); ++j) {
+            const cecs_entity_id target = *CECS_DYNAMIC_ARRAY_GET(cecs_entity_id, &associated, j);
+            cecs_relation_pair_table_remove(table, &w->relations.associations_arena, entity_id, target, NULL);
+        }
+
+        cecs_dynamic_array_clear(&associated);
+        for (
+            cecs_relation_pair_iterator it = cecs_relation_pair_iterator_create_sources(table, index);
+            !cecs_relation_pair_iterator_done(&it);
+            cecs_relation_pair_iterator_next(&it)
+        ) {
+            const cecs_entity_id source = cecs_relation_pair_source_id(cecs_relation_pair_iterator_current(&it));
+            CECS_DYNAMIC_ARRAY_ADD(cecs_entity_id, &associated, cleanup_arena, &source);
+        }
+        // NOTE: pairs have no holder to orphan, they are removed unless their sources are removed with the target
+        const bool delete_sources =
+            cecs_world_relations_get_cleanup_policy(&w->relations, table->component_id) == cecs_relation_cleanup_policy_delete_sources;
+        for (size_t j = 0; j < CECS_DYNAMIC_ARRAY_COUNT(cecs_entity_id, &associated); ++j) {
+            const cecs_entity_id source = *CECS_DYNAMIC_ARRAY_GET(cecs_entity_id, &associated, j);
+            cecs_relation_pair_table_remove(table, &w->relations.associations_arena, source, entity_id, NULL);
+            if (delete_sources) {
+                CECS_DYNAMIC_ARRAY_ADD(cecs_entity_id, removed_entities, cleanup_arena, &source);
+            } else {
+                cecs_world_remove_pair_wildcard(w, source, table->component_id);
+            }
+        }
+    }
+}
+
+// NOTE: detaching queues the sources removed with their targets, entities inside the kept range are removed by the caller
+static void cecs_world_remove_detached_entities(
+    cecs_world *w,
+    cecs_arena *cleanup_arena,
+    cecs_dynamic_array *removed_entities,
+    cecs_dynamic_array *released_holders,
+    const cecs_entity_id_range kept_range
+) {
+    for (size_t i = 0; i < CECS_DYNAMIC_ARRAY_COUNT(cecs_entity_id, removed_entities); ++i) {
+        const cecs_entity_id removed = *CECS_DYNAMIC_ARRAY_GET(cecs_entity_id, removed_entities, i);
+        const cecs_entity_id removed_index = cecs_entity_id_index(removed);
+        const bool is_kept = removed_index >= (cecs_entity_id)kept_range.start && removed_index < (cecs_entity_id)kept_range.end;
+        if (!is_kept && cecs_world_enities_has_entity(&w->entities, removed)) {
+            cecs_world_detach_relations(w, removed, cleanup_arena, removed_entities, released_holders);
+            cecs_world_detach_pairs(w, removed, cleanup_arena, removed_entities);
+            cecs_world_remove_unrelated_entity(w, removed);
+        }
+    }
+
+    // NOTE: holders are cleared together once every removal is done and kept for the next relations instead of being freed
+    const size_t released_count = CECS_DYNAMIC_ARRAY_COUNT(cecs_target_holder_id, released_holders);
+    if (released_count > 0) {
+        cecs_world_release_relation_holders(
+            w, CECS_DYNAMIC_ARRAY_GET(cecs_target_holder_id, released_holders, 0), released_count
+        );
+    }
+}
+
+cecs_entity_id cecs_world_remove_entity(cecs_world* w, cecs_entity_id entity_id) {
+    if (!cecs_world_relations_has_associations(&w->relations, cecs_entity_id_index(entity_id))) {
+        return cecs_world_remove_unrelated_entity(w, entity_id);
+    }
+
+    cecs_arena cleanup_arena = cecs_arena_create();
+    cecs_dynamic_array removed_entities = cecs_dynamic_array_create();
+    cecs_dynamic_array released_holders = cecs_dynamic_array_create();
+    CECS_DYNAMIC_ARRAY_ADD(cecs_entity_id, &removed_entities, &cleanup_arena, &entity_id);
+    cecs_world_remove_detached_entities(w, &cleanup_arena, &removed_entities, &released_holders, (cecs_entity_id_range){ 0 });
+    cecs_arena_free(&cleanup_arena);
+    return entity_id;
+}
+
+// NOTE: the range itself stays until the caller clears it, only entities outside of it are removed with their targets
+static void cecs_world_detach_entity_range(cecs_world *w, const cecs_entity_id_range range) {
+    if (cecs_world_events_remove_hook_count(&w->events) > 0) {
+        for (cecs_entity_id e = (cecs_entity_id)range.start; e < (cecs_entity_id)range.end; ++e) {
+            cecs_world_run_remove_hooks(w, cecs_world_entities_get_id(&w->entities, e));
+        }
+    }
+    if (cecs_world_relations_is_empty(&w->relations)) {
+        return;
+    }
+
+    cecs_arena cleanup_arena = cecs_arena_create();
+    cecs_dynamic_array removed_entities = cecs_dynamic_array_create();
+    cecs_dynamic_array released_holders = cecs_dynamic_array_create();
+    for (cecs_entity_id e = (cecs_entity_id)range.start; e < (cecs_entity_id)range.end; ++e) {
+        if (cecs_world_relations_has_associations(&w->relations, e)) {
+            const cecs_entity_id detached = cecs_world_entities_get_id(&w->entities, e);
+            cecs_world_detach_relations(w, detached, &cleanup_arena, &removed_entities, &released_holders);
+            cecs_world_detach_pairs(w, detached, &cleanup_arena, &removed_entities);
+        }
+    }
+    cecs_world_remove_detached_entities(w, &cleanup_arena, &removed_entities, &released_holders, range);
+    cecs_arena_free(&cleanup_arena);
+}
+
 void cecs_world_free(cecs_world* w) {
     cecs_world_entities_free(&w->entities);
     cecs_world_components_free(&w->components);
     cecs_world_relations_free(&w->relations);
     cecs_world_resources_free(&w->resources);
+    cecs_world_events_free(&w->events);
+    cecs_world_changes_free(&w->changes);
+    w->changes = (cecs_world_changes){ 0 };
+    w->events = (cecs_world_events){ 0 };
     w->resources = (cecs_world_resources){ 0 };
     w->relations = (cecs_world_relations){ 0 };
     w->components = (cecs_world_components){ 0 };
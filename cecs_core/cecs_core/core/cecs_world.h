@@ -9,16 +9,23 @@
 #include "component/entity/cecs_game_component.h"
 #include "component/cecs_component.h"
 #include "resource/cecs_resource.h"
+#include "resource/cecs_event_channel.h"
 #include "cecs_relation.h"
+#include "cecs_event.h"
+#include "cecs_change.h"
 
 #define CECS_WORLD_UNIQUE_RELATION_COMPONENTS true
 #define CECS_WORLD_FLAG_ALL_ENTITIES true
+// NOTE: *(T) costs one tag storage per distinct relation target and is kept for holder relations only, never for pairs
+#define CECS_WORLD_ANY_COMPONENT_WILDCARDS true
 
 typedef struct cecs_world {
     cecs_world_entities entities;
     cecs_world_components components;
     cecs_world_relations relations;
     cecs_world_resources resources;
+    cecs_world_events events;
+    cecs_world_changes changes;
 } cecs_world;
 
 cecs_world cecs_world_create(size_t entity_capacity, size_t component_type_capacity, size_t resource_capacity);
@@ -37,6 +44,27 @@ bool cecs_world_try_get_component(cecs_world *w, const cecs_entity_id entity_id,
 #define CECS_WORLD_TRY_GET_COMPONENT(type, world_ref, entity_id0, out_component_ref) \
     (cecs_world_try_get_component(world_ref, entity_id0, CECS_COMPONENT_ID(type), ((void **)out_component_ref)))
 
+// NOTE: components shared from a prefab live under their shared id, in an indirect storage referencing the prefab's component;
+// getting the component mutably copies it onto the entity first, reading it does not
+static inline cecs_component_id cecs_world_shared_component_id(const cecs_component_id component_id) {
+    return cecs_relation_id_create(cecs_relation_id_descriptor_create_tag(component_id, CECS_TAG_ID(cecs_is_prefab)));
+}
+#define CECS_WORLD_SHARED_COMPONENT_ID(type) cecs_world_shared_component_id(CECS_COMPONENT_ID(type))
+
+// NOTE: reads raise no mutation events nor change ticks, use them wherever the component is not written
+const void *cecs_world_read_component(cecs_world *w, const cecs_entity_id entity_id, const cecs_component_id component_id);
+#define CECS_WORLD_READ_COMPONENT(type, world_ref, entity_id0) \
+    ((const type *)cecs_world_read_component(world_ref, entity_id0, CECS_COMPONENT_ID(type)))
+
+bool cecs_world_try_read_component(cecs_world *w, const cecs_entity_id entity_id, const cecs_component_id component_id, const void **out_component);
+#define CECS_WORLD_TRY_READ_COMPONENT(type, world_ref, entity_id0, out_component_ref) \
+    (cecs_world_try_read_component(world_ref, entity_id0, CECS_COMPONENT_ID(type), ((const void **)out_component_ref)))
+
+// NOTE: what getting a component mutably records: the mutate event of entities flagged has_event_on_mutate and the change tick;
+// systems mark the components of their mutable groups, only when the component is observed or tracked at all
+void cecs_world_mark_mutable_access(cecs_world *w, const cecs_entity_id entity_id, const cecs_component_id component_id);
+bool cecs_world_is_mutable_access_recorded(const cecs_world *w, const cecs_component_id component_id);
+
 size_t cecs_world_get_component_array(cecs_world *w, const cecs_entity_id_range range, const cecs_component_id component_id, void **out_components);
 #define CECS_WORLD_GET_COMPONENT_ARRAY(type, world_ref, entity_id_range, out_components_ref) \
     (cecs_world_get_component_array(world_ref, entity_id_range, CECS_COMPONENT_ID(type), ((void **)out_components_ref)))
@@ -67,6 +95,9 @@ static inline cecs_entity_flags *cecs_world_set_entity_flags(cecs_world *w, cecs
     assert(cecs_world_enities_has_entity(&w->entities, id) && "entity with given ID does not exist");
     return CECS_WORLD_SET_COMPONENT(cecs_entity_flags, w, id, &flags);
 }
+static inline cecs_entity_flags *cecs_world_set_entity_flags_array(cecs_world *w, cecs_entity_id_range range, cecs_entity_flags flags) {
+    return CECS_WORLD_SET_COMPONENT_COPY_ARRAY(cecs_entity_flags, w, range, &flags);
+}
 
 void *cecs_world_set_component_storage_attachments(cecs_world *w, cecs_component_id component_id, void *attachments, size_t size);
 #define CECS_WORLD_SET_COMPONENT_STORAGE_ATTACHMENTS(type, attachment_type, world_ref, attachments_ref) \
@@ -107,22 +138,35 @@ size_t cecs_world_remove_tag_array(cecs_world *w, cecs_entity_id_range range, ce
 #define CECS_WORLD_REMOVE_TAG_ARRAY(type, world_ref, entity_id_range) \
     cecs_world_remove_tag_array(world_ref, entity_id_range, CECS_TAG_ID(type))
 
+// NOTE: compacts up to storage_count component storages starting at first_storage_index, returns where the next call should resume
+size_t cecs_world_compact_components(cecs_world *w, size_t first_storage_index, size_t storage_count);
+
 void *cecs_world_use_component_discard(cecs_world *w, size_t size);
 void *cecs_world_use_resource_discard(cecs_world *w, size_t size);
 
 cecs_entity_id cecs_world_add_entity(cecs_world *w);
 cecs_entity_id cecs_world_clear_entity(cecs_world *w, cecs_entity_id entity_id);
 
-// TODO: ensure relation are accounted for
+// NOTE: removes the entity's relations too, sources related to it follow the cleanup policy of each relation
 cecs_entity_id cecs_world_remove_entity(cecs_world *w, cecs_entity_id entity_id);
 
+static inline void cecs_world_set_relation_cleanup_policy(
+    cecs_world *w,
+    const cecs_component_id relation_component_id,
+    const cecs_relation_cleanup_policy policy
+) {
+    cecs_world_relations_set_cleanup_policy(&w->relations, relation_component_id, policy);
+}
+#define CECS_WORLD_SET_RELATION_CLEANUP_POLICY(type, world_ref, policy) \
+    cecs_world_set_relation_cleanup_policy(world_ref, CECS_COMPONENT_ID(type), policy)
+
 cecs_entity_id cecs_world_copy_entity_onto(cecs_world *w, cecs_entity_id destination, cecs_entity_id source);
 cecs_entity_id cecs_world_copy_entity(cecs_world *w, cecs_entity_id destination, cecs_entity_id source);
 
 cecs_entity_id cecs_world_add_entity_copy(cecs_world *w, cecs_entity_id source);
 
 cecs_entity_id_range cecs_world_add_entity_range(cecs_world *w, size_t count);
-size_t cecs_world_clear_entity_range(cecs_world *w, cecs_entity_id_range range, cecs_entity_id representative);
+size_t cecs_world_clear_entity_range(cecs_world *w, cecs_entity_id_range range);
 
 cecs_entity_id_range cecs_world_remove_entity_range(cecs_world *w, cecs_entity_id_range range);
 
@@ -132,7 +176,6 @@ size_t cecs_world_copy_entity_range(
     cecs_world *w,
     cecs_entity_id_range destination,
     cecs_entity_id_range source,
-    cecs_entity_id clear_representative,
     cecs_entity_id copy_representative
 );
 
@@ -144,10 +187,22 @@ void *cecs_world_copy_entity_and_grab(cecs_world *w, cecs_entity_id destination,
 #define CECS_WORLD_COPY_ENTITY_AND_GRAB(type, world_ref, destination, source) \
     ((type *)cecs_world_copy_entity_and_grab(world_ref, destination, source, CECS_COMPONENT_ID(type)))
 
+// NOTE: relations target entities and are cleaned up when their target is removed, the _to_tag variants target plain tags such as scenes
 void *cecs_world_set_component_relation(cecs_world *w, cecs_entity_id id, cecs_component_id component_id, void *component, size_t size, cecs_tag_id tag_id);
 #define CECS_WORLD_SET_COMPONENT_RELATION(component_type, world_ref, entity_id0, component_ref, target_id) \
     ((component_type *)cecs_world_set_component_relation(world_ref, entity_id0, CECS_COMPONENT_ID(component_type), component_ref, sizeof(component_type), target_id))
 
+void *cecs_world_set_component_relation_to_tag(
+    cecs_world *w,
+    cecs_entity_id id,
+    cecs_component_id component_id,
+    void *component,
+    size_t size,
+    cecs_tag_id target_tag_id
+);
+#define CECS_WORLD_SET_COMPONENT_RELATION_TO_TAG(component_type, world_ref, entity_id0, component_ref, target_id) \
+    ((component_type *)cecs_world_set_component_relation_to_tag(world_ref, entity_id0, CECS_COMPONENT_ID(component_type), component_ref, sizeof(component_type), target_id))
+
 void *cecs_world_get_component_relation(cecs_world *w, const cecs_entity_id id, const cecs_component_id component_id, const cecs_tag_id tag_id);
 #define CECS_WORLD_GET_COMPONENT_RELATION(component_type, world_ref, entity_id0, target_id) \
     ((component_type *)cecs_world_get_component_relation(world_ref, entity_id0, CECS_COMPONENT_ID(component_type), target_id))
@@ -160,11 +215,111 @@ cecs_tag_id cecs_world_add_tag_relation(cecs_world *w, cecs_entity_id id, cecs_t
 #define CECS_WORLD_ADD_TAG_RELATION(tag_type, world_ref, entity_id0, target_id) \
     cecs_world_add_tag_relation(world_ref, entity_id0, CECS_TAG_ID(tag_type), target_id)
 
+cecs_tag_id cecs_world_add_tag_relation_to_tag(cecs_world *w, cecs_entity_id id, cecs_tag_id tag, cecs_tag_id target_tag_id);
+#define CECS_WORLD_ADD_TAG_RELATION_TO_TAG(tag_type, world_ref, entity_id0, target_id) \
+    cecs_world_add_tag_relation_to_tag(world_ref, entity_id0, CECS_TAG_ID(tag_type), target_id)
+
 bool cecs_world_remove_tag_relation(cecs_world *w, cecs_entity_id id, cecs_tag_id tag, cecs_tag_id target_tag_id);
 #define CECS_WORLD_REMOVE_TAG_RELATION(tag_type, world_ref, entity_id0, target_id) \
     cecs_world_remove_tag_relation(world_ref, entity_id0, CECS_TAG_ID(tag_type), target_id)
 
 cecs_relation_targets_iterator cecs_world_get_associated_ids(cecs_world *w, cecs_entity_id id);
+// NOTE: sources related to the target entity by any relation, filter by relation id to answer a single relation
+bool cecs_world_get_relation_sources(cecs_world *w, cecs_tag_id target_id, cecs_relation_sources_iterator *out_iterator);
+size_t cecs_world_get_relation_source_count(const cecs_world *w, cecs_tag_id target_id);
+
+// NOTE: compact pairs keep relation data in one table per relation keyed by (source, target), no holder entities or pair ids.
+// Sources get the R(*) wildcard tag but never *(T), query a pair target through cecs_world_get_pair_sources instead.
+// Pointers to pair components are invalidated by later pair changes of the same relation
+void *cecs_world_set_pair(
+    cecs_world *w,
+    cecs_entity_id source,
+    cecs_component_id component_id,
+    const void *component,
+    size_t size,
+    cecs_entity_id target
+);
+#define CECS_WORLD_SET_PAIR(component_type, world_ref, source_id, component_ref, target_id) \
+    ((component_type *)cecs_world_set_pair(world_ref, source_id, CECS_COMPONENT_ID(component_type), component_ref, sizeof(component_type), target_id))
+#define CECS_WORLD_ADD_TAG_PAIR(tag_type, world_ref, source_id, target_id) \
+    cecs_world_set_pair(world_ref, source_id, CECS_TAG_ID(tag_type), NULL, 0, target_id)
+
+bool cecs_world_try_get_pair(
+    const cecs_world *w,
+    cecs_entity_id source,
+    cecs_component_id component_id,
+    cecs_entity_id target,
+    void **out_component
+);
+#define CECS_WORLD_TRY_GET_PAIR(component_type, world_ref, source_id, target_id, out_component_ref) \
+    cecs_world_try_get_pair(world_ref, source_id, CECS_COMPONENT_ID(component_type), target_id, ((void **)out_component_ref))
+#define CECS_WORLD_HAS_TAG_PAIR(tag_type, world_ref, source_id, target_id) \
+    cecs_world_try_get_pair(world_ref, source_id, CECS_TAG_ID(tag_type), target_id, &(void *){ NULL })
+
+bool cecs_world_remove_pair(
+    cecs_world *w,
+    cecs_entity_id source,
+    cecs_component_id component_id,
+    cecs_entity_id target,
+    void *out_removed_component
+);
+#define CECS_WORLD_REMOVE_PAIR(component_type, world_ref, source_id, target_id, out_removed_component_ref) \
+    cecs_world_remove_pair(world_ref, source_id, CECS_COMPONENT_ID(component_type), target_id, out_removed_component_ref)
+#define CECS_WORLD_REMOVE_TAG_PAIR(tag_type, world_ref, source_id, target_id) \
+    cecs_world_remove_pair(world_ref, source_id, CECS_TAG_ID(tag_type), target_id, NULL)
+
+cecs_relation_pair_iterator cecs_world_get_pair_targets(const cecs_world *w, cecs_entity_id source, cecs_component_id component_id);
+cecs_relation_pair_iterator cecs_world_get_pair_sources(const cecs_world *w, cecs_entity_id target, cecs_component_id component_id);
+
+// NOTE: component changes of observed components are queued per component and event kind, observers only run on dispatch.
+// Setting a component the entity has and mutable access, system iteration over mutable groups included, raise mutate events,
+// the latter only for entities flagged has_event_on_mutate; every removal, of a component, a tag, a range or the entity itself,
+// raises remove events only for entities flagged has_event_on_remove
+cecs_observer *cecs_world_add_observer(
+    cecs_world *w,
+    cecs_component_id component_id,
+    cecs_event_kind_flags kinds,
+    cecs_observer_predicate *predicate,
+    void *user_data
+);
+#define CECS_WORLD_ADD_OBSERVER(type, world_ref, kinds, predicate, user_data) \
+    cecs_world_add_observer(world_ref, CECS_COMPONENT_ID(type), kinds, ((cecs_observer_predicate *)predicate), user_data)
+#define CECS_WORLD_ADD_TAG_OBSERVER(type, world_ref, kinds, predicate, user_data) \
+    cecs_world_add_observer(world_ref, CECS_TAG_ID(type), kinds, ((cecs_observer_predicate *)predicate), user_data)
+
+size_t cecs_world_remove_observers(cecs_world *w, cecs_component_id component_id, cecs_observer_predicate *predicate);
+#define CECS_WORLD_REMOVE_OBSERVERS(type, world_ref, predicate) \
+    cecs_world_remove_observers(world_ref, CECS_COMPONENT_ID(type), ((cecs_observer_predicate *)predicate))
+
+// NOTE: remove hooks run while entity removal still leaves the entity and the component in place, ranges included;
+// they hold function pointers and are not written to snapshots
+void cecs_world_set_remove_hook(cecs_world *w, cecs_component_id component_id, cecs_remove_hook *hook);
+#define CECS_WORLD_SET_REMOVE_HOOK(type, world_ref, hook) \
+    cecs_world_set_remove_hook(world_ref, CECS_COMPONENT_ID(type), hook)
+
+// NOTE: for components written through pointers kept past their access, raises the mutate event and stamps the change tick
+void cecs_world_emit_mutated(cecs_world *w, cecs_entity_id id, cecs_component_id component_id);
+#define CECS_WORLD_EMIT_MUTATED(type, world_ref, entity_id0) \
+    cecs_world_emit_mutated(world_ref, entity_id0, CECS_COMPONENT_ID(type))
+
+// NOTE: runs the observers of every event queued since the previous dispatch, meant to run once per frame or stage
+size_t cecs_world_dispatch_events(cecs_world *w);
+
+// NOTE: tracked components stamp the current change tick when set or accessed mutably and record their removals, entity additions
+// and removals are recorded while any component is tracked; components tracked after being set only show up in full deltas
+cecs_component_changes *cecs_world_track_changes(cecs_world *w, cecs_component_id component_id);
+#define CECS_WORLD_TRACK_CHANGES(type, world_ref) \
+    cecs_world_track_changes(world_ref, CECS_COMPONENT_ID(type))
+#define CECS_WORLD_TRACK_TAG_CHANGES(type, world_ref) \
+    cecs_world_track_changes(world_ref, CECS_TAG_ID(type))
+
+static inline cecs_change_tick cecs_world_change_tick(const cecs_world *w) {
+    return w->changes.tick;
+}
+cecs_change_tick cecs_world_advance_change_tick(cecs_world *w);
+
+// NOTE: removals up to the tick are dropped, deltas may no longer be encoded since earlier ticks
+size_t cecs_world_trim_changes(cecs_world *w, cecs_change_tick tick);
 
 cecs_resource_handle cecs_world_set_resource(cecs_world *w, cecs_resource_id id, void *resource, size_t size);
 #define CECS_WORLD_SET_RESOURCE(type, world_ref, resource_ref) \
@@ -178,6 +333,35 @@ bool cecs_world_remove_resource(cecs_world *w, cecs_resource_id id);
 #define CECS_WORLD_REMOVE_RESOURCE(type, world_ref) \
     cecs_world_remove_resource(world_ref, CECS_RESOURCE_ID(type))
 
+// NOTE: borrowing tracks resource access like component iteration tracks storages, get_resource stays unchecked;
+// borrowed resources may neither be set nor removed
+cecs_resource_handle cecs_world_borrow_resource(cecs_world *w, cecs_resource_id id, cecs_resource_access_mode access);
+#define CECS_WORLD_BORROW_RESOURCE(type, world_ref, access) \
+    ((type *)cecs_world_borrow_resource(world_ref, CECS_RESOURCE_ID(type), access))
+
+void cecs_world_release_resource(cecs_world *w, cecs_resource_id id, cecs_resource_access_mode access);
+#define CECS_WORLD_RELEASE_RESOURCE(type, world_ref, access) \
+    cecs_world_release_resource(world_ref, CECS_RESOURCE_ID(type), access)
+
+// NOTE: event channels are resources, their buffers live in the resources arena and are swapped together once per frame
+cecs_event_channel *cecs_world_add_event_channel(cecs_world *w, cecs_resource_id channel_id, size_t event_size);
+#define CECS_WORLD_ADD_EVENT_CHANNEL(type, world_ref) \
+    cecs_world_add_event_channel(world_ref, CECS_EVENT_CHANNEL_ID(type), sizeof(type))
+
+cecs_event_channel *cecs_world_get_event_channel(const cecs_world *w, cecs_resource_id channel_id);
+#define CECS_WORLD_GET_EVENT_CHANNEL(type, world_ref) \
+    cecs_world_get_event_channel(world_ref, CECS_EVENT_CHANNEL_ID(type))
+
+void *cecs_world_write_event(cecs_world *w, cecs_resource_id channel_id, const void *event, size_t size);
+#define CECS_WORLD_WRITE_EVENT(type, world_ref, event_ref) \
+    ((type *)cecs_world_write_event(world_ref, CECS_EVENT_CHANNEL_ID(type), event_ref, sizeof(type)))
+
+size_t cecs_world_read_events(const cecs_world *w, cecs_resource_id channel_id, const void **out_events, size_t size);
+#define CECS_WORLD_READ_EVENTS(type, world_ref, out_events_ref) \
+    cecs_world_read_events(world_ref, CECS_EVENT_CHANNEL_ID(type), ((const void **)out_events_ref), sizeof(type))
+
+void cecs_world_swap_event_channels(cecs_world *w);
+
 bool cecs_world_remove_resource_out(cecs_world *w, cecs_resource_id id, cecs_resource_handle out_resource, size_t size);
 #define CECS_WORLD_REMOVE_RESOURCE_OUT(type, world_ref, out_resource_ref) \
     cecs_world_remove_resource_out(world_ref, CECS_RESOURCE_ID(type), out_resource_ref, sizeof(type))
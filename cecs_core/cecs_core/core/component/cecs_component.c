@@ -1,6 +1,7 @@
 #include <assert.h>
 #include <memory.h>
 #include <stddef.h>
+#include <stdint.h>
 
 #include "cecs_component.h"
 
@@ -18,6 +19,7 @@ cecs_world_components cecs_world_components_create(size_t component_type_capacit
         .components_arena = cecs_arena_create(),
         .component_storages = cecs_paged_sparse_set_create(),
         .component_storages_attachments = cecs_paged_sparse_set_create(),
+        .entity_signatures = cecs_paged_sparse_set_create(),
         .checksum = 0,
         .discard = cecs_discard_create()
     };
@@ -25,6 +27,7 @@ cecs_world_components cecs_world_components_create(size_t component_type_capacit
 void cecs_world_components_free(cecs_world_components* wc) {
     wc->component_storages = (cecs_paged_sparse_set){ 0 };
     wc->component_storages_attachments = (cecs_paged_sparse_set){ 0 };
+    wc->entity_signatures = (cecs_paged_sparse_set){ 0 };
     cecs_arena_free(&wc->components_arena);
     cecs_arena_free(&wc->storages_arena);
     wc->discard = (cecs_component_discard){ 0 };
@@ -47,7 +50,135 @@ bool cecs_world_components_has_storage(const cecs_world_components* wc, cecs_com
     return cecs_paged_sparse_set_contains(&wc->component_storages, (size_t)component_id);
 }
 
-static cecs_sized_component_storage *cecs_world_components_get_or_set_component_storage(
+size_t cecs_world_components_get_entity_signature(
+    const cecs_world_components *wc,
+    cecs_entity_id entity_id,
+    const cecs_component_id **out_component_ids
+) {
+    const cecs_entity_signature *entity_signature =
+        CECS_PAGED_SPARSE_SET_FIND(cecs_entity_signature, &wc->entity_signatures, (size_t)entity_id);
+    if (entity_signature == NULL) {
+        *out_component_ids = NULL;
+        return 0;
+    }
+
+    *out_component_ids = (const cecs_component_id *)entity_signature->component_ids.values;
+    return CECS_DYNAMIC_ARRAY_COUNT(cecs_component_id, &entity_signature->component_ids);
+}
+
+static cecs_entity_signature *cecs_world_components_get_or_set_entity_signature(cecs_world_components *wc, cecs_entity_id entity_id) {
+    cecs_optional_element signature = CECS_PAGED_SPARSE_SET_GET(cecs_entity_signature, &wc->entity_signatures, (size_t)entity_id);
+    if (CECS_OPTION_IS_SOME(cecs_optional_element, signature)) {
+        return CECS_OPTION_GET_UNCHECKED(cecs_optional_element, signature);
+    } else {
+        return CECS_PAGED_SPARSE_SET_SET(
+            cecs_entity_signature,
+            &wc->entity_signatures,
+            &wc->storages_arena,
+            (size_t)entity_id,
+            &(cecs_entity_signature){ .component_ids = cecs_dynamic_array_create() }
+        );
+    }
+}
+
+static bool cecs_entity_signature_find(const cecs_entity_signature *signature, cecs_component_id component_id, size_t *out_index) {
+    const cecs_component_id *component_ids = (const cecs_component_id *)signature->component_ids.values;
+    const size_t count = CECS_DYNAMIC_ARRAY_COUNT(cecs_component_id, &signature->component_ids);
+    for (size_t i = 0; i < count; ++i) {
+        if (component_ids[i] == component_id) {
+            *out_index = i;
+            return true;
+        }
+    }
+    *out_index = count;
+    return false;
+}
+
+void cecs_world_components_entity_signature_add(cecs_world_components *wc, cecs_entity_id entity_id, cecs_component_id component_id) {
+    cecs_entity_signature *signature = cecs_world_components_get_or_set_entity_signature(wc, entity_id);
+    size_t index;
+    if (!cecs_entity_signature_find(signature, component_id, &index)) {
+        CECS_DYNAMIC_ARRAY_ADD(cecs_component_id, &signature->component_ids, &wc->components_arena, &component_id);
+    }
+}
+
+void cecs_world_components_entity_signature_add_range(
+    cecs_world_components *wc,
+    cecs_entity_id_range range,
+    cecs_component_id component_id
+) {
+    for (cecs_entity_id e = (cecs_entity_id)range.start; e < (cecs_entity_id)range.end; ++e) {
+        cecs_world_components_entity_signature_add(wc, e, component_id);
+    }
+}
+
+bool cecs_world_components_entity_signature_remove(cecs_world_components *wc, cecs_entity_id entity_id, cecs_component_id component_id) {
+    cecs_optional_element signature = CECS_PAGED_SPARSE_SET_GET(cecs_entity_signature, &wc->entity_signatures, (size_t)entity_id);
+    if (CECS_OPTION_IS_NONE(cecs_optional_element, signature)) {
+        return false;
+    }
+
+    cecs_entity_signature *entity_signature = CECS_OPTION_GET_UNCHECKED(cecs_optional_element, signature);
+    size_t index;
+    if (!cecs_entity_signature_find(entity_signature, component_id, &index)) {
+        return false;
+    }
+    CECS_DYNAMIC_ARRAY_REMOVE_SWAP_LAST(cecs_component_id, &entity_signature->component_ids, &wc->components_arena, index);
+    return true;
+}
+
+void cecs_world_components_entity_signature_remove_range(
+    cecs_world_components *wc,
+    cecs_entity_id_range range,
+    cecs_component_id component_id
+) {
+    for (cecs_entity_id e = (cecs_entity_id)range.start; e < (cecs_entity_id)range.end; ++e) {
+        cecs_world_components_entity_signature_remove(wc, e, component_id);
+    }
+}
+
+void cecs_world_components_entity_signature_clear(cecs_world_components *wc, cecs_entity_id entity_id) {
+    cecs_optional_element signature = CECS_PAGED_SPARSE_SET_GET(cecs_entity_signature, &wc->entity_signatures, (size_t)entity_id);
+    if (CECS_OPTION_IS_SOME(cecs_optional_element, signature)) {
+        cecs_dynamic_array_clear(&((cecs_entity_signature *)CECS_OPTION_GET_UNCHECKED(cecs_optional_element, signature))->component_ids);
+    }
+}
+
+void cecs_world_components_entity_signature_clear_range(cecs_world_components *wc, cecs_entity_id_range range) {
+    for (cecs_entity_id e = (cecs_entity_id)range.start; e < (cecs_entity_id)range.end; ++e) {
+        cecs_world_components_entity_signature_clear(wc, e);
+    }
+}
+
+cecs_memory_usage cecs_world_components_entity_signatures_memory_usage(const cecs_world_components *wc) {
+    cecs_memory_usage usage = cecs_paged_sparse_set_memory_usage(&wc->entity_signatures, sizeof(cecs_entity_signature));
+    const cecs_entity_signature *signatures = cecs_paged_sparse_set_values(&wc->entity_signatures);
+    for (size_t i = 0; i < cecs_paged_sparse_set_count_of_size(&wc->entity_signatures, sizeof(cecs_entity_signature)); ++i) {
+        usage = cecs_memory_usage_add(usage, cecs_dynamic_array_memory_usage(&signatures[i].component_ids));
+    }
+    return usage;
+}
+
+// NOTE: indirect storages point into the storages' dense values, which move whenever those grow
+static void cecs_world_components_rebase_indirect_storages(cecs_world_components *wc, const uintptr_t previous_storages) {
+    cecs_sized_component_storage *storages = cecs_paged_sparse_set_values_mut(&wc->component_storages);
+    if ((uintptr_t)storages == previous_storages) {
+        return;
+    }
+
+    const size_t storage_count = cecs_paged_sparse_set_count_of_size(&wc->component_storages, sizeof(cecs_sized_component_storage));
+    for (size_t i = 0; i < storage_count; ++i) {
+        if (CECS_UNION_IS(cecs_indirect_component_storage, cecs_component_storage_union, storages[i].storage.storage)) {
+            cecs_indirect_component_storage *indirect =
+                &CECS_UNION_GET_UNCHECKED(cecs_indirect_component_storage, storages[i].storage.storage);
+            const size_t referenced_index =
+                ((uintptr_t)indirect->referenced_storage - previous_storages) / sizeof(cecs_sized_component_storage);
+            indirect->referenced_storage = &storages[referenced_index].storage;
+        }
+    }
+}
+
+cecs_sized_component_storage *cecs_world_components_get_or_set_component_storage(
     cecs_world_components *wc,
     const cecs_component_id component_id,
     const cecs_component_storage_descriptor storage_descriptor,
@@ -63,13 +194,16 @@ static cecs_sized_component_storage *cecs_world_components_get_or_set_component_
         return storage;
     } else {
         cecs_sized_component_storage new_storage = cecs_component_storage_descriptor_build(storage_descriptor, wc, size);
-        return CECS_PAGED_SPARSE_SET_SET(
+        const uintptr_t previous_storages = (uintptr_t)cecs_paged_sparse_set_values_mut(&wc->component_storages);
+        cecs_sized_component_storage *storage = CECS_PAGED_SPARSE_SET_SET(
             cecs_sized_component_storage,
             &wc->component_storages,
             &wc->storages_arena,
             (size_t)component_id,
             &new_storage
         );
+        cecs_world_components_rebase_indirect_storages(wc, previous_storages);
+        return storage;
     }
 }
 
@@ -147,6 +281,7 @@ cecs_optional_component cecs_world_components_set_component(
         size
     );
 
+    cecs_world_components_entity_signature_add(wc, entity_id, component_id);
     return cecs_component_storage_set(
         &storage->storage,
         &wc->components_arena,
@@ -175,6 +310,9 @@ cecs_optional_component_array cecs_world_components_set_component_array(
         size
     );
 
+    cecs_world_components_entity_signature_add_range(
+        wc, cecs_exclusive_range_index_count((cecs_ssize_t)entity_id, (cecs_ssize_t)count), component_id
+    );
     return cecs_component_storage_set_array(
         &storage->storage,
         &wc->components_arena,
@@ -204,6 +342,9 @@ cecs_optional_component_array cecs_world_components_set_component_copy_array(
         size
     );
 
+    cecs_world_components_entity_signature_add_range(
+        wc, cecs_exclusive_range_index_count((cecs_ssize_t)entity_id, (cecs_ssize_t)count), component_id
+    );
     return cecs_component_storage_set_copy_array(
         &storage->storage,
         &wc->components_arena,
@@ -273,6 +414,7 @@ bool cecs_world_components_remove_component(cecs_world_components* wc, cecs_enti
         return false;
     } else {
         cecs_sized_component_storage *sized_storage = CECS_OPTION_GET_UNCHECKED(cecs_optional_component_storage, storage);
+        cecs_world_components_entity_signature_remove(wc, entity_id, component_id);
         return cecs_component_storage_remove(
             &sized_storage->storage,
             &wc->components_arena,
@@ -298,6 +440,9 @@ size_t cecs_world_components_remove_component_array(
         return 0;
     } else {
         cecs_sized_component_storage *sized_storage = CECS_OPTION_GET_UNCHECKED(cecs_optional_component_storage, storage);
+        cecs_world_components_entity_signature_remove_range(
+            wc, cecs_exclusive_range_index_count((cecs_ssize_t)entity_id, (cecs_ssize_t)count), component_id
+        );
         return cecs_component_storage_remove_array(
             &sized_storage->storage,
             &wc->components_arena,
@@ -309,6 +454,39 @@ size_t cecs_world_components_remove_component_array(
     }
 }
 
+size_t cecs_world_components_compact_storages(cecs_world_components *wc, size_t first_storage_index, size_t storage_count) {
+    const size_t total_storage_count = cecs_world_components_get_component_storage_count(wc);
+    if (first_storage_index >= total_storage_count) {
+        first_storage_index = 0;
+    }
+
+    const size_t end_storage_index = min(first_storage_index + storage_count, total_storage_count);
+    cecs_sized_component_storage *storages = cecs_paged_sparse_set_values_mut(&wc->component_storages);
+    for (size_t i = first_storage_index; i < end_storage_index; i++) {
+        cecs_component_storage_compact(&storages[i].storage, &wc->components_arena, storages[i].component_size);
+    }
+    return end_storage_index == total_storage_count ? 0 : end_storage_index;
+}
+
+size_t cecs_world_components_clear_entity_range(cecs_world_components *wc, cecs_entity_id_range range) {
+    assert(
+        range.start >= 0 && range.end >= range.start
+        && "error: entity_id_range must be non-negative and not reversed"
+    );
+    const size_t count = (size_t)cecs_exclusive_range_length(range);
+    const size_t storage_count = cecs_world_components_get_component_storage_count(wc);
+    cecs_sized_component_storage *storages = cecs_paged_sparse_set_values_mut(&wc->component_storages);
+
+    size_t cleared_storage_count = 0;
+    for (size_t i = 0; i < storage_count; i++) {
+        if (cecs_component_storage_clear_range(&storages[i].storage, &wc->components_arena, (cecs_entity_id)range.start, count)) {
+            ++cleared_storage_count;
+        }
+    }
+    cecs_world_components_entity_signature_clear_range(wc, range);
+    return cleared_storage_count;
+}
+
 const cecs_component_storage_attachments *cecs_world_components_set_component_storage_attachments(
     cecs_world_components *wc,
     cecs_component_id component_id,
@@ -478,40 +656,30 @@ cecs_associated_component_storage cecs_world_components_iterator_current(cecs_wo
     };
 }
 
-cecs_world_components_entity_iterator cecs_world_components_entity_iterator_create(const cecs_world_components* components, cecs_entity_id entity_id) {
+cecs_world_components_entity_iterator cecs_world_components_entity_iterator_create(cecs_world_components* components, cecs_entity_id entity_id) {
+    const cecs_component_id *component_ids;
+    const size_t component_count = cecs_world_components_get_entity_signature(components, entity_id, &component_ids);
     return (cecs_world_components_entity_iterator) {
-        .it = cecs_world_components_iterator_create(components),
-            .entity_id = entity_id
+        .components = components,
+        .component_ids = component_ids,
+        .component_count = component_count,
+        .current_index = 0
     };
 }
 
 bool cecs_world_components_entity_iterator_done(const cecs_world_components_entity_iterator* it) {
-    return cecs_world_components_iterator_done(&it->it);
-}
-
-static inline bool cecs_world_components_iterator_current_contains_entity(const cecs_world_components_entity_iterator* it) {
-    assert(!cecs_world_components_iterator_done(&it->it) && "error: iterator is done");
-
-    const cecs_component_storage *current = &((cecs_sized_component_storage *)(
-        cecs_paged_sparse_set_values(&it->it.components->component_storages)
-    ))[it->it.storage_raw_index].storage;
-    return cecs_component_storage_has(
-        current,
-        it->entity_id
-    );
+    return it->current_index >= it->component_count;
 }
 
 size_t cecs_world_components_entity_iterator_next(cecs_world_components_entity_iterator* it) {
-    do {
-        cecs_world_components_iterator_next(&it->it);
-    } while (
-        !cecs_world_components_iterator_done(&it->it)
-        && !cecs_world_components_iterator_current_contains_entity(it)
-    );
-
-    return it->it.storage_raw_index;
+    return ++it->current_index;
 }
 
 cecs_associated_component_storage cecs_world_components_entity_iterator_current(cecs_world_components_entity_iterator* it) {
-    return cecs_world_components_iterator_current(&it->it);
+    assert(!cecs_world_components_entity_iterator_done(it) && "error: iterator is done");
+    const cecs_component_id component_id = it->component_ids[it->current_index];
+    return (cecs_associated_component_storage) {
+        .storage = cecs_world_components_get_component_storage_expect(it->components, component_id),
+        .component_id = component_id
+    };
 }
@@ -40,9 +40,14 @@ typedef struct cecs_sized_component_storage {
     size_t component_size;
 } cecs_sized_component_storage;
 
+typedef struct cecs_entity_signature {
+    cecs_dynamic_array component_ids;
+} cecs_entity_signature;
+
 typedef struct cecs_world_components {
     cecs_paged_sparse_set component_storages;
     cecs_paged_sparse_set component_storages_attachments;
+    cecs_paged_sparse_set entity_signatures;
     cecs_arena storages_arena;
     cecs_arena components_arena;
     cecs_component_discard discard;
@@ -63,6 +68,27 @@ cecs_sized_component_storage *cecs_world_components_get_component_storage_expect
 
 bool cecs_world_components_has_storage(const cecs_world_components *wc, cecs_component_id component_id);
 
+size_t cecs_world_components_get_entity_signature(
+    const cecs_world_components *wc,
+    cecs_entity_id entity_id,
+    const cecs_component_id **out_component_ids
+);
+void cecs_world_components_entity_signature_add(cecs_world_components *wc, cecs_entity_id entity_id, cecs_component_id component_id);
+void cecs_world_components_entity_signature_add_range(
+    cecs_world_components *wc,
+    cecs_entity_id_range range,
+    cecs_component_id component_id
+);
+bool cecs_world_components_entity_signature_remove(cecs_world_components *wc, cecs_entity_id entity_id, cecs_component_id component_id);
+void cecs_world_components_entity_signature_remove_range(
+    cecs_world_components *wc,
+    cecs_entity_id_range range,
+    cecs_component_id component_id
+);
+void cecs_world_components_entity_signature_clear(cecs_world_components *wc, cecs_entity_id entity_id);
+void cecs_world_components_entity_signature_clear_range(cecs_world_components *wc, cecs_entity_id_range range);
+cecs_memory_usage cecs_world_components_entity_signatures_memory_usage(const cecs_world_components *wc);
+
 typedef cecs_component_id cecs_indirect_component_id;
 typedef struct cecs_component_storage_descriptor {
     CECS_OPTION_STRUCT(cecs_component_id, cecs_indirect_component_id) indirect_component_id;
@@ -77,6 +103,13 @@ cecs_sized_component_storage cecs_component_storage_descriptor_build(
     size_t component_size
 );
 
+cecs_sized_component_storage *cecs_world_components_get_or_set_component_storage(
+    cecs_world_components *wc,
+    const cecs_component_id component_id,
+    const cecs_component_storage_descriptor storage_descriptor,
+    const size_t size
+);
+
 cecs_optional_component cecs_world_components_set_component(
     cecs_world_components *wc,
     cecs_entity_id entity_id,
@@ -135,6 +168,7 @@ static inline void *cecs_world_components_set_component_array_unchecked(
     );
 }
 
+// NOTE: tag storages hold no component array, setting tags returns NULL
 static inline void *cecs_world_components_set_component_copy_array_unchecked(
     cecs_world_components *wc,
     cecs_entity_id entity_id,
@@ -144,10 +178,12 @@ static inline void *cecs_world_components_set_component_copy_array_unchecked(
     size_t size,
     cecs_component_storage_descriptor additional_storage_descriptor
 ) {
-    return CECS_OPTION_GET(
-        cecs_optional_component_array,
-        cecs_world_components_set_component_copy_array(wc, entity_id, component_id, component_single_src, count, size, additional_storage_descriptor)
-    );
+    cecs_optional_component_array components =
+        cecs_world_components_set_component_copy_array(wc, entity_id, component_id, component_single_src, count, size, additional_storage_descriptor);
+    if (size == 0) {
+        return NULL;
+    }
+    return CECS_OPTION_GET(cecs_optional_component_array, components);
 }
 
 bool cecs_world_components_has_component(const cecs_world_components *wc, cecs_entity_id entity_id, cecs_component_id component_id);
@@ -188,6 +224,10 @@ size_t cecs_world_components_remove_component_array(
     size_t count
 );
 
+size_t cecs_world_components_compact_storages(cecs_world_components *wc, size_t first_storage_index, size_t storage_count);
+// NOTE: clears every storage over the range at once, returns how many storages had components in it
+size_t cecs_world_components_clear_entity_range(cecs_world_components *wc, cecs_entity_id_range range);
+
 const cecs_component_storage_attachments *cecs_world_components_set_component_storage_attachments(
     cecs_world_components *wc,
     cecs_component_id component_id,
@@ -230,12 +270,15 @@ size_t cecs_world_components_iterator_next(cecs_world_components_iterator *it);
 cecs_associated_component_storage cecs_world_components_iterator_current(cecs_world_components_iterator *it);
 
 
+// NOTE: yields mutable storages, so it borrows the components mutably
 typedef struct cecs_world_components_entity_iterator {
-    cecs_world_components_iterator it;
-    const cecs_entity_id entity_id;
+    cecs_world_components *const components;
+    const cecs_component_id *component_ids;
+    size_t component_count;
+    size_t current_index;
 } cecs_world_components_entity_iterator;
 
-cecs_world_components_entity_iterator cecs_world_components_entity_iterator_create(const cecs_world_components *components, cecs_entity_id entity_id);
+cecs_world_components_entity_iterator cecs_world_components_entity_iterator_create(cecs_world_components *components, cecs_entity_id entity_id);
 bool cecs_world_components_entity_iterator_done(const cecs_world_components_entity_iterator *it);
 size_t cecs_world_components_entity_iterator_next(cecs_world_components_entity_iterator *it);
 cecs_associated_component_storage cecs_world_components_entity_iterator_current(cecs_world_components_entity_iterator *it);
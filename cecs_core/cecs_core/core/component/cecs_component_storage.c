@@ -359,6 +359,85 @@ const cecs_dynamic_array *cecs_component_storage_components(const cecs_component
     }
 }
 
+cecs_memory_usage cecs_component_storage_memory_usage(const cecs_component_storage *self, const size_t entity_count, const size_t size) {
+    CECS_UNION_MATCH(self->storage) {
+        case CECS_UNION_VARIANT(cecs_sparse_component_storage, cecs_component_storage_union):
+            return cecs_sentinel_set_memory_usage(
+                &CECS_UNION_GET_UNCHECKED(cecs_sparse_component_storage, self->storage).components,
+                entity_count,
+                size
+            );
+        case CECS_UNION_VARIANT(cecs_unit_component_storage, cecs_component_storage_union):
+            return (cecs_memory_usage){ 0 };
+        case CECS_UNION_VARIANT(cecs_indirect_component_storage, cecs_component_storage_union): {
+            const cecs_indirect_component_storage *storage = &CECS_UNION_GET_UNCHECKED(cecs_indirect_component_storage, self->storage);
+            return cecs_memory_usage_add(
+                cecs_sentinel_set_memory_usage(&storage->component_indices, entity_count, sizeof(cecs_entity_id)),
+                cecs_sentinel_set_memory_usage(&storage->component_references, entity_count, sizeof(void *))
+            );
+        }
+        default:
+        {
+            assert(false && "unreachable: invalid component storage variant");
+            exit(EXIT_FAILURE);
+            return (cecs_memory_usage){ 0 };
+        }
+    }
+}
+
+static cecs_inclusive_range cecs_component_storage_first_last_entity(const cecs_component_storage *self) {
+    cecs_hibitset_iterator first = cecs_hibitset_iterator_create_borrowed_at_first(&self->entity_bitset);
+    if (!cecs_hibitset_iterator_done(&first) && !cecs_hibitset_iterator_current_is_set(&first)) {
+        cecs_hibitset_iterator_next_set(&first);
+    }
+    if (cecs_hibitset_iterator_done(&first)) {
+        return (cecs_inclusive_range){ PTRDIFF_MAX, 0 };
+    }
+
+    cecs_hibitset_iterator last = cecs_hibitset_iterator_create_borrowed_at_last(&self->entity_bitset);
+    if (!cecs_hibitset_iterator_current_is_set(&last)) {
+        cecs_hibitset_iterator_previous_set(&last);
+    }
+    return (cecs_inclusive_range){
+        .start = (cecs_ssize_t)cecs_hibitset_iterator_current(&first),
+        .end = (cecs_ssize_t)cecs_hibitset_iterator_current(&last)
+    };
+}
+
+size_t cecs_component_storage_compact(cecs_component_storage *self, cecs_arena *a, const size_t size) {
+    size_t released_count = 0;
+    CECS_UNION_MATCH(self->storage) {
+        case CECS_UNION_VARIANT(cecs_sparse_component_storage, cecs_component_storage_union): {
+            cecs_sentinel_set *components = &CECS_UNION_GET_UNCHECKED(cecs_sparse_component_storage, self->storage).components;
+            const size_t previous_count = (size_t)cecs_exclusive_range_length(components->index_range);
+            cecs_sentinel_set_shrink_to(components, a, cecs_component_storage_first_last_entity(self), size);
+            released_count = previous_count - (size_t)cecs_exclusive_range_length(components->index_range);
+            break;
+        }
+        case CECS_UNION_VARIANT(cecs_unit_component_storage, cecs_component_storage_union):
+            return 0;
+        case CECS_UNION_VARIANT(cecs_indirect_component_storage, cecs_component_storage_union): {
+            cecs_indirect_component_storage *storage = &CECS_UNION_GET_UNCHECKED(cecs_indirect_component_storage, self->storage);
+            released_count = cecs_sentinel_set_compact(
+                &storage->component_indices, a, sizeof(cecs_entity_id), cecs_indirect_component_storage_invalid_id_pattern
+            ) + cecs_sentinel_set_compact(&storage->component_references, a, sizeof(void *), 0);
+            break;
+        }
+        default:
+        {
+            assert(false && "unreachable: invalid component storage variant");
+            exit(EXIT_FAILURE);
+            return 0;
+        }
+    }
+
+    if (released_count > 0) {
+        // NOTE: compaction moves the remaining components, indirect storages must resolve their references again
+        self->status |= cecs_component_storage_status_dirty;
+    }
+    return released_count;
+}
+
 extern inline cecs_component_storage_functions cecs_component_storage_get_functions(const cecs_component_storage *self);
 extern inline cecs_component_storage_array_functions cecs_component_storage_get_array_functions(const cecs_component_storage *self);
 
@@ -425,21 +504,44 @@ void *cecs_component_storage_get_or_null(cecs_component_storage* self, const cec
     return CECS_OPTION_GET_OR_NULL(cecs_optional_component, component);
 }
 
+typedef struct cecs_component_storage_layout {
+    const void *components;
+    cecs_ssize_t first_index;
+} cecs_component_storage_layout;
+
+static cecs_component_storage_layout cecs_component_storage_layout_of(const cecs_component_storage *self) {
+    if (CECS_UNION_IS(cecs_sparse_component_storage, cecs_component_storage_union, self->storage)) {
+        const cecs_sentinel_set *components = &CECS_UNION_GET_UNCHECKED(cecs_sparse_component_storage, self->storage).components;
+        return (cecs_component_storage_layout){ .components = components->values.values, .first_index = components->index_range.start };
+    } else {
+        return (cecs_component_storage_layout){ .components = NULL, .first_index = 0 };
+    }
+}
+
+static void cecs_component_storage_mark_if_moved(cecs_component_storage *self, const cecs_component_storage_layout previous) {
+    const cecs_component_storage_layout current = cecs_component_storage_layout_of(self);
+    if (previous.components != NULL
+        && (previous.components != current.components || previous.first_index != current.first_index)) {
+        // NOTE: components moved while growing, indirect storages referencing them must resolve their references again
+        self->status |= cecs_component_storage_status_dirty;
+    }
+}
+
 cecs_optional_component cecs_component_storage_set(cecs_component_storage* self, cecs_arena* a,  const cecs_entity_id id, const void* component, const size_t size) {
     cecs_hibitset_set(&self->entity_bitset, a, (size_t)id);
 
     cecs_component_storage_functions storage_functions = cecs_component_storage_get_functions(self);
     if (cecs_component_storage_function_type_from_info(storage_functions.info(&self->storage))) {
-        return CECS_OPTION_CREATE_SOME_STRUCT(
-            cecs_optional_component,
-            storage_functions.set(&self->storage, a, id, component, size)
-        );
+        const cecs_component_storage_layout previous = cecs_component_storage_layout_of(self);
+        void *set_component = storage_functions.set(&self->storage, a, id, component, size);
+        cecs_component_storage_mark_if_moved(self, previous);
+        return CECS_OPTION_CREATE_SOME_STRUCT(cecs_optional_component, set_component);
     } else {
         return CECS_OPTION_CREATE_NONE_STRUCT(cecs_optional_component);
     }
 }
 
-cecs_optional_component_array cecs_component_storage_set_array(
+static cecs_optional_component_array cecs_component_storage_dispatch_set_array(
     cecs_component_storage *self,
     cecs_arena *a,
     const cecs_entity_id id,
@@ -484,7 +586,7 @@ cecs_optional_component_array cecs_component_storage_set_array(
     }
 }
 
-cecs_optional_component_array cecs_component_storage_set_copy_array(
+static cecs_optional_component_array cecs_component_storage_dispatch_set_copy_array(
     cecs_component_storage *self,
     cecs_arena *a,
     const cecs_entity_id id,
@@ -529,6 +631,34 @@ cecs_optional_component_array cecs_component_storage_set_copy_array(
     }
 }
 
+cecs_optional_component_array cecs_component_storage_set_array(
+    cecs_component_storage *self,
+    cecs_arena *a,
+    const cecs_entity_id id,
+    const void *components,
+    const size_t count,
+    const size_t size
+) {
+    const cecs_component_storage_layout previous = cecs_component_storage_layout_of(self);
+    cecs_optional_component_array set_components = cecs_component_storage_dispatch_set_array(self, a, id, components, count, size);
+    cecs_component_storage_mark_if_moved(self, previous);
+    return set_components;
+}
+
+cecs_optional_component_array cecs_component_storage_set_copy_array(
+    cecs_component_storage *self,
+    cecs_arena *a,
+    const cecs_entity_id id,
+    const void *component_single_src,
+    const size_t count,
+    const size_t size
+) {
+    const cecs_component_storage_layout previous = cecs_component_storage_layout_of(self);
+    cecs_optional_component_array set_components = cecs_component_storage_dispatch_set_copy_array(self, a, id, component_single_src, count, size);
+    cecs_component_storage_mark_if_moved(self, previous);
+    return set_components;
+}
+
 bool cecs_component_storage_remove(cecs_component_storage *self, cecs_arena *a, cecs_entity_id id, void *out_removed_component, size_t size) {
     bool was_set = cecs_hibitset_is_set(&self->entity_bitset, (size_t)id);
     cecs_hibitset_unset(&self->entity_bitset, a, (size_t)id);
@@ -577,3 +707,53 @@ size_t cecs_component_storage_remove_array(cecs_component_storage *self, cecs_ar
     }
     }
 }
+
+static bool cecs_component_storage_has_entity_in(const cecs_component_storage *self, const cecs_inclusive_range range) {
+    const cecs_exclusive_range bit_range = cecs_hibitset_bit_range(&self->entity_bitset);
+    const cecs_ssize_t start = cecs_ssize_t_max(range.start, bit_range.start);
+    if (start > range.end || start >= bit_range.end) {
+        return false;
+    }
+
+    cecs_hibitset_iterator it = cecs_hibitset_iterator_create_borrowed_at(&self->entity_bitset, (size_t)start);
+    if (!cecs_hibitset_iterator_current_is_set(&it)) {
+        cecs_hibitset_iterator_next_set(&it);
+    }
+    return !cecs_hibitset_iterator_done(&it) && (cecs_ssize_t)cecs_hibitset_iterator_current(&it) <= range.end;
+}
+
+bool cecs_component_storage_clear_range(cecs_component_storage *self, cecs_arena *a, const cecs_entity_id id, const size_t count) {
+    if (count == 0) {
+        return false;
+    }
+    const cecs_inclusive_range range = { .start = (cecs_ssize_t)id, .end = (cecs_ssize_t)(id + count - 1) };
+    if (!cecs_component_storage_has_entity_in(self, range)) {
+        return false;
+    }
+    // NOTE: unsetting outside the bitset's words would grow it over the whole range
+    const cecs_exclusive_range bit_range = cecs_hibitset_bit_range(&self->entity_bitset);
+    const cecs_ssize_t unset_start = cecs_ssize_t_max(range.start, bit_range.start);
+    const cecs_ssize_t unset_end = cecs_ssize_t_min(range.end + 1, bit_range.end);
+    cecs_hibitset_unset_range(&self->entity_bitset, a, (size_t)unset_start, (size_t)(unset_end - unset_start));
+
+    CECS_UNION_MATCH(self->storage) {
+        case CECS_UNION_VARIANT(cecs_sparse_component_storage, cecs_component_storage_union):
+        case CECS_UNION_VARIANT(cecs_unit_component_storage, cecs_component_storage_union):
+            // NOTE: the bitset alone tracks presence, sparse components left behind are released by compaction
+            return true;
+        case CECS_UNION_VARIANT(cecs_indirect_component_storage, cecs_component_storage_union): {
+            cecs_indirect_component_storage *storage = &CECS_UNION_GET_UNCHECKED(cecs_indirect_component_storage, self->storage);
+            cecs_sentinel_set_remove_range(
+                &storage->component_indices, a, range, sizeof(cecs_entity_id), cecs_indirect_component_storage_invalid_id_pattern
+            );
+            cecs_sentinel_set_remove_range(&storage->component_references, a, range, sizeof(void *), 0);
+            return true;
+        }
+        default:
+        {
+            assert(false && "unreachable: invalid component storage variant");
+            exit(EXIT_FAILURE);
+            return false;
+        }
+    }
+}
@@ -144,6 +144,9 @@ cecs_component_storage_function_type cecs_component_storage_function_type_from_i
 bool cecs_component_storage_has(const cecs_component_storage *self, cecs_entity_id id);
 const cecs_dynamic_array *cecs_component_storage_components(const cecs_component_storage *self);
 
+cecs_memory_usage cecs_component_storage_memory_usage(const cecs_component_storage *self, const size_t entity_count, const size_t size);
+size_t cecs_component_storage_compact(cecs_component_storage *self, cecs_arena *a, const size_t size);
+
 inline cecs_component_storage_functions cecs_component_storage_get_functions(const cecs_component_storage *self) {
     CECS_UNION_MATCH(self->storage) {
     case CECS_UNION_VARIANT(cecs_sparse_component_storage, cecs_component_storage_union):
@@ -217,5 +220,7 @@ size_t cecs_component_storage_remove_array(
     size_t count,
     size_t size
 );
+// NOTE: drops the range's components without copying them out, returns whether any entity in the range had one
+bool cecs_component_storage_clear_range(cecs_component_storage *self, cecs_arena *a, const cecs_entity_id id, const size_t count);
 
 #endif
\ No newline at end of file
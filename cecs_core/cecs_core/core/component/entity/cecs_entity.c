@@ -1,4 +1,5 @@
 #include <stdlib.h>
+#include <string.h>
 
 #include "cecs_entity.h"
 
@@ -6,26 +7,105 @@ cecs_world_entities cecs_world_entities_create(size_t entity_capacity) {
     cecs_world_entities we;
     we.entity_ids_arena = cecs_arena_create_with_capacity(sizeof(cecs_entity_id) * entity_capacity);
     we.entity_ids = cecs_sparse_set_create_of_integers_with_capacity(&we.entity_ids_arena, entity_capacity, sizeof(cecs_entity_id));
-    we.free_entity_ids = cecs_queue_create_with_capacity(&we.entity_ids_arena, sizeof(cecs_entity_id) * ((entity_capacity >> 2) + 1));
+    we.generations = CECS_DYNAMIC_ARRAY_CREATE_WITH_CAPACITY(cecs_entity_generation, &we.entity_ids_arena, entity_capacity);
+    we.free_entity_ids = cecs_dynamic_array_create();
+    we.free_entity_id_ranges = cecs_range_set_create();
     return we;
 }
 
 void cecs_world_entities_free(cecs_world_entities* we) {
     cecs_arena_free(&we->entity_ids_arena);
-    we->free_entity_ids = (cecs_queue){ 0 };
+    we->free_entity_id_ranges = (cecs_range_set){ 0 };
+    we->free_entity_ids = (cecs_dynamic_array){ 0 };
     we->entity_ids = (cecs_sparse_set){ 0 };
+    we->generations = (cecs_dynamic_array){ 0 };
 }
 
-cecs_entity_id cecs_world_entities_add_entity(cecs_world_entities* we) {
-    cecs_entity_id id = cecs_world_entities_count(we);
-    if (CECS_QUEUE_COUNT(cecs_entity_id, &we->free_entity_ids) > 0) {
-        CECS_QUEUE_POP_FIRST(cecs_entity_id, &we->free_entity_ids, &we->entity_ids_arena, &id);
+cecs_memory_usage cecs_world_entities_memory_usage(const cecs_world_entities* we) {
+    return cecs_memory_usage_add(
+        cecs_sparse_set_memory_usage(&we->entity_ids, sizeof(cecs_entity_id)),
+        cecs_memory_usage_add(
+            cecs_memory_usage_add(
+                cecs_range_set_memory_usage(&we->free_entity_id_ranges),
+                cecs_dynamic_array_memory_usage(&we->free_entity_ids)
+            ),
+            cecs_dynamic_array_memory_usage(&we->generations)
+        )
+    );
+}
 
-        if (cecs_sparse_set_contains(&we->entity_ids, (size_t)id)) {
-            assert(false && "unreachable: id already in entity_ids, there is a mismatch in the integer-sparse-set indices");
-            exit(EXIT_FAILURE);
+static int cecs_world_entities_compare_free_ids(const void *lhs, const void *rhs) {
+    const cecs_entity_id l = *(const cecs_entity_id *)lhs;
+    const cecs_entity_id r = *(const cecs_entity_id *)rhs;
+    return (l > r) - (l < r);
+}
+
+void cecs_world_entities_coalesce_free_ids(cecs_world_entities *we) {
+    const size_t free_id_count = CECS_DYNAMIC_ARRAY_COUNT(cecs_entity_id, &we->free_entity_ids);
+    if (free_id_count == 0) {
+        return;
+    }
+
+    cecs_entity_id *free_ids = we->free_entity_ids.values;
+    qsort(free_ids, free_id_count, sizeof(cecs_entity_id), cecs_world_entities_compare_free_ids);
+    size_t run_start = 0;
+    for (size_t i = 1; i <= free_id_count; ++i) {
+        if (i == free_id_count || free_ids[i] != free_ids[i - 1] + 1) {
+            cecs_range_set_insert(
+                &we->free_entity_id_ranges,
+                &we->entity_ids_arena,
+                (cecs_exclusive_range){ .start = (cecs_ssize_t)free_ids[run_start], .end = (cecs_ssize_t)free_ids[i - 1] + 1 }
+            );
+            run_start = i;
         }
     }
+    cecs_dynamic_array_clear(&we->free_entity_ids);
+}
+
+static void cecs_world_entities_ensure_generations(cecs_world_entities *we, cecs_entity_id index_end) {
+    const size_t generation_count = CECS_DYNAMIC_ARRAY_COUNT(cecs_entity_generation, &we->generations);
+    if (index_end > generation_count) {
+        memset(
+            CECS_DYNAMIC_ARRAY_APPEND_EMPTY(cecs_entity_generation, &we->generations, &we->entity_ids_arena, index_end - generation_count),
+            0,
+            (index_end - generation_count) * sizeof(cecs_entity_generation)
+        );
+    }
+}
+
+static inline void cecs_world_entities_kill_generation(cecs_world_entities *we, cecs_entity_id index) {
+    cecs_entity_generation *generation = CECS_DYNAMIC_ARRAY_GET_MUT(cecs_entity_generation, &we->generations, index);
+    assert(cecs_entity_generation_is_alive(*generation) && "unreachable: killed entity generation is already free");
+    ++*generation;
+}
+
+// NOTE: fresh slots start at the alive generation 0, reused slots step from their free generation to the next alive one
+static void cecs_world_entities_revive_generations(cecs_world_entities *we, cecs_entity_id_range range) {
+    const cecs_entity_id generation_count = CECS_DYNAMIC_ARRAY_COUNT(cecs_entity_generation, &we->generations);
+    const cecs_entity_id reused_end = min((cecs_entity_id)range.end, generation_count);
+    for (cecs_entity_id i = (cecs_entity_id)range.start; i < reused_end; ++i) {
+        cecs_entity_generation *generation = CECS_DYNAMIC_ARRAY_GET_MUT(cecs_entity_generation, &we->generations, i);
+        assert(!cecs_entity_generation_is_alive(*generation) && "unreachable: revived entity generation is already alive");
+        ++*generation;
+    }
+    cecs_world_entities_ensure_generations(we, (cecs_entity_id)range.end);
+}
+
+cecs_entity_id cecs_world_entities_add_entity(cecs_world_entities* we) {
+    cecs_entity_id id = cecs_world_entities_next_fresh_id(we);
+    cecs_ssize_t range_id;
+    const size_t free_id_count = CECS_DYNAMIC_ARRAY_COUNT(cecs_entity_id, &we->free_entity_ids);
+    if (free_id_count > 0) {
+        id = *CECS_DYNAMIC_ARRAY_GET(cecs_entity_id, &we->free_entity_ids, free_id_count - 1);
+        cecs_dynamic_array_truncate(&we->free_entity_ids, &we->entity_ids_arena, free_id_count - 1, sizeof(cecs_entity_id));
+    } else if (cecs_range_set_take_first(&we->free_entity_id_ranges, &we->entity_ids_arena, &range_id)) {
+        id = (cecs_entity_id)range_id;
+    }
+
+    if (cecs_sparse_set_contains(&we->entity_ids, (size_t)id)) {
+        assert(false && "unreachable: id already in entity_ids, there is a mismatch in the integer-sparse-set indices");
+        exit(EXIT_FAILURE);
+    }
 
     CECS_SPARSE_SET_SET(
         cecs_entity_id,
@@ -34,34 +114,40 @@ cecs_entity_id cecs_world_entities_add_entity(cecs_world_entities* we) {
         (size_t)id,
         &id
     );
+    cecs_world_entities_revive_generations(we, cecs_exclusive_range_singleton((cecs_ssize_t)id));
 
-    return id;
+    return cecs_world_entities_get_id(we, id);
 }
 
 cecs_entity_id cecs_world_entities_remove_entity(cecs_world_entities* we, cecs_entity_id id) {
+    if (!cecs_world_enities_has_entity(we, id)) {
+        return id;
+    }
+
+    cecs_entity_id index = cecs_entity_id_index(id);
     cecs_entity_id removed;
-    if (CECS_SPARSE_SET_REMOVE(cecs_entity_id, &we->entity_ids, &we->entity_ids_arena, (size_t)id, &removed)) {
-        if (removed != id) {
+    if (CECS_SPARSE_SET_REMOVE(cecs_entity_id, &we->entity_ids, &we->entity_ids_arena, (size_t)index, &removed)) {
+        if (removed != index) {
             assert(false && "unreachable: removed entity_id != id, there is a mismatch in the integer-sparse-set indices");
             exit(EXIT_FAILURE);
         }
-        if (CECS_QUEUE_COUNT(cecs_entity_id, &we->free_entity_ids) > 0 && id == *CECS_QUEUE_LAST(cecs_entity_id, &we->free_entity_ids)) {
-            assert(
-                false
-                && "unreachable: tried to double free a removed id and sparse set returned incorrect removal indication"
-            );
-            exit(EXIT_FAILURE);
-        }
-        CECS_QUEUE_PUSH_LAST(cecs_entity_id, &we->free_entity_ids, &we->entity_ids_arena, &id);
+        cecs_world_entities_kill_generation(we, index);
+        CECS_DYNAMIC_ARRAY_ADD(cecs_entity_id, &we->free_entity_ids, &we->entity_ids_arena, &index);
     }
     return id;
 }
 
 cecs_entity_id_range cecs_world_entities_add_entity_range(cecs_world_entities* we, size_t count) {
-    cecs_entity_id_range range = {
-        .start = cecs_world_entities_count(we) + CECS_QUEUE_COUNT(cecs_entity_id, &we->free_entity_ids),
-        .end = cecs_world_entities_count(we) + CECS_QUEUE_COUNT(cecs_entity_id, &we->free_entity_ids) + count
-    };
+    cecs_world_entities_coalesce_free_ids(we);
+    const cecs_ssize_t fresh_start = (cecs_ssize_t)cecs_world_entities_next_fresh_id(we);
+    cecs_entity_id_range range;
+    if (!cecs_range_set_take_best_fit(&we->free_entity_id_ranges, &we->entity_ids_arena, count, &range)) {
+        if (cecs_range_set_take_last_ending_at(&we->free_entity_id_ranges, &we->entity_ids_arena, fresh_start, &range)) {
+            range.end = range.start + (cecs_ssize_t)count;
+        } else {
+            range = cecs_exclusive_range_index_count(fresh_start, (cecs_ssize_t)count);
+        }
+    }
 
     assert(
         range.start >= 0 && range.end >= 0
@@ -76,6 +162,7 @@ cecs_entity_id_range cecs_world_entities_add_entity_range(cecs_world_entities* w
             &(cecs_entity_id){i}
         );
     }
+    cecs_world_entities_revive_generations(we, range);
 
     return range;
 }
@@ -85,8 +172,56 @@ cecs_entity_id_range cecs_world_entities_remove_entity_range(cecs_world_entities
         range.start >= 0 && range.end >= 0
         && "error: both start and end of entity_id_range must be non-negative"
     );
-    for (cecs_entity_id i = (cecs_entity_id)range.start; i < (cecs_entity_id)range.end; i++) {
-        cecs_world_entities_remove_entity(we, i);
+    cecs_ssize_t removed_start = range.start;
+    for (cecs_ssize_t i = range.start; i < range.end; i++) {
+        cecs_entity_id removed;
+        if (!CECS_SPARSE_SET_REMOVE(cecs_entity_id, &we->entity_ids, &we->entity_ids_arena, (size_t)i, &removed)) {
+            cecs_range_set_insert(
+                &we->free_entity_id_ranges, &we->entity_ids_arena, (cecs_exclusive_range){ .start = removed_start, .end = i }
+            );
+            removed_start = i + 1;
+        } else if (removed != (cecs_entity_id)i) {
+            assert(false && "unreachable: removed entity_id != id, there is a mismatch in the integer-sparse-set indices");
+            exit(EXIT_FAILURE);
+        } else {
+            cecs_world_entities_kill_generation(we, (cecs_entity_id)i);
+        }
     }
+    cecs_range_set_insert(
+        &we->free_entity_id_ranges, &we->entity_ids_arena, (cecs_exclusive_range){ .start = removed_start, .end = range.end }
+    );
     return range;
 }
+
+
+void cecs_world_entities_restore(
+    cecs_world_entities *we,
+    const cecs_entity_id alive_indices[],
+    const size_t alive_count,
+    const cecs_entity_generation generations[],
+    const size_t generation_count,
+    const cecs_entity_id_range free_entity_id_ranges[],
+    const size_t free_entity_id_range_count
+) {
+    assert(
+        cecs_world_entities_count(we) == 0 && CECS_DYNAMIC_ARRAY_COUNT(cecs_entity_generation, &we->generations) == 0
+        && "error: entities can only be restored into empty entities"
+    );
+    if (generation_count > 0) {
+        CECS_DYNAMIC_ARRAY_ADD_RANGE(cecs_entity_generation, &we->generations, &we->entity_ids_arena, generations, generation_count);
+    }
+    for (size_t i = 0; i < alive_count; ++i) {
+        assert(alive_indices[i] < generation_count && "error: restored entity index has no generation");
+        assert(cecs_entity_generation_is_alive(generations[alive_indices[i]]) && "error: restored entity has a free generation");
+        CECS_SPARSE_SET_SET(
+            cecs_entity_id,
+            &we->entity_ids,
+            &we->entity_ids_arena,
+            (size_t)alive_indices[i],
+            &(cecs_entity_id){ alive_indices[i] }
+        );
+    }
+    for (size_t i = 0; i < free_entity_id_range_count; ++i) {
+        cecs_range_set_insert(&we->free_entity_id_ranges, &we->entity_ids_arena, free_entity_id_ranges[i]);
+    }
+}
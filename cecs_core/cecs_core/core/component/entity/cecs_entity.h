@@ -4,7 +4,7 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include "../../../containers/cecs_sparse_set.h"
-#include "../../../containers/cecs_queue.h"
+#include "../../../containers/cecs_range_set.h"
 #include "../../../containers/cecs_range.h"
 
 
@@ -13,10 +13,34 @@ typedef CECS_ENTITY_ID_TYPE cecs_entity_id;
 
 #define CECS_ENTITY_ID_MAX UINT64_MAX
 
+#define CECS_ENTITY_ID_INDEX_BITS 32
+#define CECS_ENTITY_ID_INDEX_MASK ((((cecs_entity_id)1) << CECS_ENTITY_ID_INDEX_BITS) - 1)
+
+// NOTE: slot generations are even while the slot is alive and odd while it is free, removing and reusing
+// an entity both bump it, so stale and freed ids never match their slot
+typedef uint32_t cecs_entity_generation;
+
+static inline cecs_entity_id cecs_entity_id_create(cecs_entity_id index, cecs_entity_generation generation) {
+    assert(index <= CECS_ENTITY_ID_INDEX_MASK && "error: entity index out of bounds");
+    return ((cecs_entity_id)generation << CECS_ENTITY_ID_INDEX_BITS) | index;
+}
+
+static inline cecs_entity_id cecs_entity_id_index(cecs_entity_id id) {
+    return id & CECS_ENTITY_ID_INDEX_MASK;
+}
+
+static inline cecs_entity_generation cecs_entity_id_generation(cecs_entity_id id) {
+    return (cecs_entity_generation)(id >> CECS_ENTITY_ID_INDEX_BITS);
+}
+
+// NOTE: single removals push onto the free id stack and single adds pop it, both O(1), the stack is only
+// coalesced into the free ranges when ranges are allocated or the free ids are saved
 typedef struct cecs_world_entities {
     cecs_arena entity_ids_arena;
     cecs_sparse_set entity_ids;
-    cecs_queue free_entity_ids;
+    cecs_dynamic_array generations;
+    cecs_dynamic_array free_entity_ids;
+    cecs_range_set free_entity_id_ranges;
 } cecs_world_entities;
 
 cecs_world_entities cecs_world_entities_create(size_t entity_capacity);
@@ -27,18 +51,55 @@ static inline size_t cecs_world_entities_count(const cecs_world_entities *we) {
     return cecs_sparse_set_count_of_size(&we->entity_ids, sizeof(cecs_entity_id));
 }
 
+static inline cecs_entity_id cecs_world_entities_next_fresh_id(const cecs_world_entities *we) {
+    return cecs_world_entities_count(we)
+        + CECS_DYNAMIC_ARRAY_COUNT(cecs_entity_id, &we->free_entity_ids)
+        + cecs_range_set_length(&we->free_entity_id_ranges);
+}
+
+static inline bool cecs_entity_generation_is_alive(cecs_entity_generation generation) {
+    return (generation & 1) == 0;
+}
+
+static inline bool cecs_world_entities_has_entity_index(const cecs_world_entities *we, cecs_entity_id index) {
+    return index < CECS_DYNAMIC_ARRAY_COUNT(cecs_entity_generation, &we->generations)
+        && cecs_entity_generation_is_alive(((const cecs_entity_generation *)we->generations.values)[index]);
+}
+
+// NOTE: handed out ids carry even generations, so a freed slot's odd generation never matches
 static inline bool cecs_world_enities_has_entity(const cecs_world_entities *we, cecs_entity_id id) {
-    return cecs_sparse_set_contains(&we->entity_ids, (size_t)id);
+    const cecs_entity_id index = cecs_entity_id_index(id);
+    return index < CECS_DYNAMIC_ARRAY_COUNT(cecs_entity_generation, &we->generations)
+        && ((const cecs_entity_generation *)we->generations.values)[index] == cecs_entity_id_generation(id);
 }
 
+static inline cecs_entity_id cecs_world_entities_get_id(const cecs_world_entities *we, cecs_entity_id index) {
+    return cecs_entity_id_create(index, *CECS_DYNAMIC_ARRAY_GET(cecs_entity_generation, &we->generations, index));
+}
+
+cecs_memory_usage cecs_world_entities_memory_usage(const cecs_world_entities *we);
+
+void cecs_world_entities_coalesce_free_ids(cecs_world_entities *we);
+
 cecs_entity_id cecs_world_entities_add_entity(cecs_world_entities *we);
 
 cecs_entity_id cecs_world_entities_remove_entity(cecs_world_entities *we, cecs_entity_id id);
 
-// TODO: add a free queue for entity ranges
 typedef cecs_exclusive_range cecs_entity_id_range;
 cecs_entity_id_range cecs_world_entities_add_entity_range(cecs_world_entities *we, size_t count);
 
 cecs_entity_id_range cecs_world_entities_remove_entity_range(cecs_world_entities *we, cecs_entity_id_range range);
 
+// NOTE: rebuilds empty entities from their saved state, alive indices keep their saved order,
+// free ranges are merged into the free range set
+void cecs_world_entities_restore(
+    cecs_world_entities *we,
+    const cecs_entity_id alive_indices[],
+    size_t alive_count,
+    const cecs_entity_generation generations[],
+    size_t generation_count,
+    const cecs_entity_id_range free_entity_id_ranges[],
+    size_t free_entity_id_range_count
+);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,43 @@
+#include <string.h>
+#include <assert.h>
+
+#include "cecs_event_channel.h"
+
+cecs_event_channel cecs_event_channel_create(size_t event_size) {
+    assert(event_size > 0 && "error: event channels do not carry zero sized events");
+    return (cecs_event_channel) {
+        .buffers = { cecs_dynamic_array_create(), cecs_dynamic_array_create() },
+        .current_buffer = 0,
+        .event_size = event_size
+    };
+}
+
+cecs_memory_usage cecs_event_channel_memory_usage(const cecs_event_channel *c) {
+    return cecs_memory_usage_add(
+        cecs_dynamic_array_memory_usage(&c->buffers[0]),
+        cecs_dynamic_array_memory_usage(&c->buffers[1])
+    );
+}
+
+void *cecs_event_channel_write(cecs_event_channel *c, cecs_arena *a, const void *event, size_t size) {
+    assert(size == c->event_size && "error: event size mismatch with the event channel");
+    return cecs_dynamic_array_add(&c->buffers[c->current_buffer], a, event, size);
+}
+
+void *cecs_event_channel_write_range(cecs_event_channel *c, cecs_arena *a, const void *events, size_t count, size_t size) {
+    assert(size == c->event_size && "error: event size mismatch with the event channel");
+    return cecs_dynamic_array_add_range(&c->buffers[c->current_buffer], a, events, count, size);
+}
+
+size_t cecs_event_channel_read(const cecs_event_channel *c, const void **out_events, size_t size) {
+    assert(size == c->event_size && "error: event size mismatch with the event channel");
+    const cecs_dynamic_array *previous = &c->buffers[c->current_buffer ^ 1];
+    const size_t count = cecs_dynamic_array_count_of_size(previous, size);
+    *out_events = count > 0 ? cecs_dynamic_array_first(previous) : NULL;
+    return count;
+}
+
+void cecs_event_channel_swap(cecs_event_channel *c) {
+    c->current_buffer ^= 1;
+    cecs_dynamic_array_clear(&c->buffers[c->current_buffer]);
+}
@@ -0,0 +1,43 @@
+#ifndef CECS_EVENT_CHANNEL_H
+#define CECS_EVENT_CHANNEL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <assert.h>
+#include "../../containers/cecs_arena.h"
+#include "../../containers/cecs_dynamic_array.h"
+#include "../../types/cecs_type_id.h"
+#include "cecs_resource.h"
+
+#define CECS_EVENT_CHANNEL(type) CECS_PASTE(type, _event_channel_resource)
+
+#define CECS_EVENT_CHANNEL_DECLARE(type) _CECS_RESOURCE_DECLARE(CECS_EVENT_CHANNEL(type))
+#define CECS_EVENT_CHANNEL_DEFINE(type) _CECS_RESOURCE_DEFINE(CECS_EVENT_CHANNEL(type))
+
+#define CECS_EVENT_CHANNEL_ID(type) ((cecs_resource_id)CECS_TYPE_ID(CECS_EVENT_CHANNEL(type)))
+
+// NOTE: writers append to the current buffer while readers see the buffer written during the previous frame,
+// swapping keeps both buffers so steady state frames do not allocate
+typedef struct cecs_event_channel {
+    cecs_dynamic_array buffers[2];
+    size_t current_buffer;
+    size_t event_size;
+} cecs_event_channel;
+
+cecs_event_channel cecs_event_channel_create(size_t event_size);
+#define CECS_EVENT_CHANNEL_CREATE(type) cecs_event_channel_create(sizeof(type))
+
+cecs_memory_usage cecs_event_channel_memory_usage(const cecs_event_channel *c);
+
+void *cecs_event_channel_write(cecs_event_channel *c, cecs_arena *a, const void *event, size_t size);
+void *cecs_event_channel_write_range(cecs_event_channel *c, cecs_arena *a, const void *events, size_t count, size_t size);
+
+static inline size_t cecs_event_channel_written_count(const cecs_event_channel *c) {
+    return cecs_dynamic_array_count_of_size(&c->buffers[c->current_buffer], c->event_size);
+}
+
+size_t cecs_event_channel_read(const cecs_event_channel *c, const void **out_events, size_t size);
+
+void cecs_event_channel_swap(cecs_event_channel *c);
+
+#endif
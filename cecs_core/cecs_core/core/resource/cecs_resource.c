@@ -1,3 +1,4 @@
+#include <stdlib.h>
 #include <string.h>
 #include <assert.h>
 
@@ -13,37 +14,54 @@ cecs_world_resources cecs_world_resources_create(size_t resource_capactity, size
 {
     cecs_world_resources wr;
     wr.resources_arena = cecs_arena_create_with_capacity(resource_capactity * (resource_default_size + sizeof(cecs_resource_handle)));
-    wr.resource_handles = cecs_sentinel_set_create_with_capacity(&wr.resources_arena, sizeof(cecs_resource_handle) * resource_capactity);
+    wr.resource_handles = cecs_paged_sentinel_set_create(sizeof(cecs_resource_handle));
+    wr.resource_sizes = cecs_paged_sentinel_set_create(sizeof(size_t));
+    wr.resource_borrows = cecs_paged_sentinel_set_create(sizeof(cecs_resource_borrow));
     wr.discard = cecs_discard_create();
     return wr;
 }
 
 void cecs_world_resources_free(cecs_world_resources* wr) {
     cecs_arena_free(&wr->resources_arena);
-    wr->resource_handles = (cecs_sentinel_set){ 0 };
+    wr->resource_handles = (cecs_paged_sentinel_set){ 0 };
+    wr->resource_sizes = (cecs_paged_sentinel_set){ 0 };
+    wr->resource_borrows = (cecs_paged_sentinel_set){ 0 };
     wr->discard = (cecs_resource_discard){ 0 };
 }
 
 bool cecs_world_resources_has_resource(const cecs_world_resources* wr, cecs_resource_id id) {
-    return cecs_sentinel_set_contains_index(&wr->resource_handles, (size_t)id)
-        && (*(const cecs_resource_handle *)cecs_sentinel_set_get_inbounds(
+    return cecs_paged_sentinel_set_contains_index(&wr->resource_handles, (size_t)id)
+        && (*(const cecs_resource_handle *)cecs_paged_sentinel_set_get_inbounds(
             &wr->resource_handles, (size_t)id, sizeof(cecs_resource_handle)
         ) != NULL
     );
 }
 
 cecs_resource_handle cecs_world_resources_set_resource(cecs_world_resources* wr, cecs_resource_id id, void* resource, size_t size) {
+    assert(
+        !(cecs_world_resources_get_resource_status(wr, id) & (cecs_resource_status_reading | cecs_resource_status_writing))
+        && "error: resource is borrowed and cannot be set"
+    );
     cecs_discard_ensure(&wr->discard, &wr->resources_arena, size);
 
     cecs_resource_handle handle = cecs_world_resources_has_resource(wr, id)
-        ? *CECS_SENTINEL_SET_GET_INBOUNDS(cecs_resource_handle, &wr->resource_handles, (size_t)id)
+        ? *CECS_PAGED_SENTINEL_SET_GET_INBOUNDS(cecs_resource_handle, &wr->resource_handles, (size_t)id)
         : cecs_arena_alloc(&wr->resources_arena, size);
     memcpy(handle, resource, size);
 
-    cecs_sentinel_set_expand_to_include(
+    cecs_paged_sentinel_set_expand_to_include(
+        &wr->resource_sizes, &wr->resources_arena, cecs_inclusive_range_singleton(id), sizeof(size_t), 0
+    );
+    CECS_PAGED_SENTINEL_SET_SET_INBOUNDS(size_t, &wr->resource_sizes, (size_t)id, &size);
+
+    cecs_paged_sentinel_set_expand_to_include(
+        &wr->resource_borrows, &wr->resources_arena, cecs_inclusive_range_singleton(id), sizeof(cecs_resource_borrow), 0
+    );
+
+    cecs_paged_sentinel_set_expand_to_include(
         &wr->resource_handles, &wr->resources_arena, cecs_inclusive_range_singleton(id), sizeof(cecs_resource_handle), 0
     );
-    return *CECS_SENTINEL_SET_SET_INBOUNDS(
+    return *CECS_PAGED_SENTINEL_SET_SET_INBOUNDS(
         cecs_resource_handle,
         &wr->resource_handles,
         (size_t)id,
@@ -52,14 +70,65 @@ cecs_resource_handle cecs_world_resources_set_resource(cecs_world_resources* wr,
 }
 
 cecs_resource_handle cecs_world_resources_get_resource(const cecs_world_resources* wr, cecs_resource_id id) {
-    cecs_resource_handle handle = *CECS_SENTINEL_SET_GET_INBOUNDS(cecs_resource_handle, &wr->resource_handles, (size_t)id);
+    cecs_resource_handle handle = *CECS_PAGED_SENTINEL_SET_GET_INBOUNDS(cecs_resource_handle, &wr->resource_handles, (size_t)id);
     assert(handle != NULL && "error: resource does not exist, handle is NULL");
     return handle;
 }
 
+size_t cecs_world_resources_get_resource_size(const cecs_world_resources* wr, cecs_resource_id id) {
+    if (!cecs_world_resources_has_resource(wr, id)) {
+        return 0;
+    }
+    return *CECS_PAGED_SENTINEL_SET_GET_INBOUNDS(size_t, &wr->resource_sizes, (size_t)id);
+}
+
+size_t cecs_world_resources_count(const cecs_world_resources* wr) {
+    size_t count = 0;
+    const cecs_exclusive_range resource_range = cecs_paged_sentinel_set_index_range(&wr->resource_handles);
+    for (cecs_ssize_t i = resource_range.start; i < resource_range.end; ++i) {
+        if (cecs_world_resources_has_resource(wr, (cecs_resource_id)i)) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+cecs_memory_usage cecs_world_resources_memory_usage(const cecs_world_resources* wr) {
+    const size_t count = cecs_world_resources_count(wr);
+    cecs_memory_usage usage = cecs_memory_usage_add(
+        cecs_memory_usage_add(
+            cecs_paged_sentinel_set_memory_usage(&wr->resource_handles, count, sizeof(cecs_resource_handle)),
+            cecs_paged_sentinel_set_memory_usage(&wr->resource_sizes, count, sizeof(size_t))
+        ),
+        cecs_paged_sentinel_set_memory_usage(&wr->resource_borrows, count, sizeof(cecs_resource_borrow))
+    );
+    const cecs_exclusive_range resource_range = cecs_paged_sentinel_set_index_range(&wr->resource_sizes);
+    for (cecs_ssize_t i = resource_range.start; i < resource_range.end; ++i) {
+        const size_t size = cecs_world_resources_get_resource_size(wr, (cecs_resource_id)i);
+        usage.used += size;
+        usage.reserved += size;
+    }
+    usage.reserved += wr->discard.size;
+    return usage;
+}
+
+static void cecs_world_resources_remove_resource_borrow(cecs_world_resources *wr, cecs_resource_id id) {
+    assert(
+        !(cecs_world_resources_get_resource_status(wr, id) & (cecs_resource_status_reading | cecs_resource_status_writing))
+        && "error: resource is borrowed and cannot be removed"
+    );
+    cecs_paged_sentinel_set_remove(
+        &wr->resource_borrows, &wr->resources_arena, (size_t)id, &(cecs_resource_borrow){ 0 }, sizeof(cecs_resource_borrow), 0
+    );
+}
+
 bool cecs_world_resources_remove_resource(cecs_world_resources* wr, cecs_resource_id id) {
+    cecs_world_resources_remove_resource_borrow(wr, id);
+    size_t removed_size = 0;
+    cecs_paged_sentinel_set_remove(&wr->resource_sizes, &wr->resources_arena, (size_t)id, &removed_size, sizeof(size_t), 0);
+
     cecs_resource_handle handle = NULL;
-    bool removed = cecs_sentinel_set_remove(
+    bool removed = cecs_paged_sentinel_set_remove(
         &wr->resource_handles, &wr->resources_arena, (size_t)id, &handle, sizeof(cecs_resource_handle), 0
     );
     return removed && handle != NULL;
@@ -67,8 +136,12 @@ bool cecs_world_resources_remove_resource(cecs_world_resources* wr, cecs_resourc
 
 bool cecs_world_resources_remove_resource_out(cecs_world_resources* wr, cecs_resource_id id, cecs_resource_handle out_resource, size_t size) {
     assert(out_resource != NULL && "out_resource must not be NULL, use: cecs_world_resources_remove_resource");
+    cecs_world_resources_remove_resource_borrow(wr, id);
+    size_t removed_size = 0;
+    cecs_paged_sentinel_set_remove(&wr->resource_sizes, &wr->resources_arena, (size_t)id, &removed_size, sizeof(size_t), 0);
+
     cecs_resource_handle handle = NULL;
-    bool removed = cecs_sentinel_set_remove(
+    bool removed = cecs_paged_sentinel_set_remove(
         &wr->resource_handles, &wr->resources_arena, (size_t)id, &handle, sizeof(cecs_resource_handle), 0
     );
 
@@ -80,3 +153,91 @@ bool cecs_world_resources_remove_resource_out(cecs_world_resources* wr, cecs_res
         return false;
     }
 }
+
+cecs_resource_status_flags cecs_world_resources_get_resource_status(const cecs_world_resources *wr, cecs_resource_id id) {
+    if (!cecs_world_resources_has_resource(wr, id)) {
+        return cecs_resource_status_none;
+    }
+    cecs_resource_borrow *borrow = CECS_PAGED_SENTINEL_SET_GET_INBOUNDS(cecs_resource_borrow, &wr->resource_borrows, (size_t)id);
+    return (cecs_resource_status_flags)(
+        atomic_load_explicit(&borrow->status_and_reader_count, memory_order_acquire) & CECS_RESOURCE_BORROW_STATUS_MASK
+    );
+}
+
+cecs_resource_handle cecs_world_resources_borrow_resource(cecs_world_resources *wr, cecs_resource_id id, cecs_resource_access_mode access) {
+    assert(cecs_world_resources_has_resource(wr, id) && "error: resource does not exist and cannot be borrowed");
+    cecs_resource_borrow *borrow = CECS_PAGED_SENTINEL_SET_GET_INBOUNDS_MUT(cecs_resource_borrow, &wr->resource_borrows, (size_t)id);
+
+    uint32_t state = atomic_load_explicit(&borrow->status_and_reader_count, memory_order_relaxed);
+    uint32_t borrowed_state;
+    do {
+        if (state & cecs_resource_status_writing) {
+            assert(false && "error: user requested access on a resource that is being written to");
+            exit(EXIT_FAILURE);
+        }
+
+        switch (access) {
+        case cecs_resource_access_inmmutable:
+            assert(state < (uint32_t)0 - CECS_RESOURCE_BORROW_READER && "error: resource has too many readers");
+            borrowed_state = (state + CECS_RESOURCE_BORROW_READER) | cecs_resource_status_reading;
+            break;
+        case cecs_resource_access_mutable:
+            if (state & cecs_resource_status_reading) {
+                assert(false && "error: user requested mutable access on a resource that is being read from");
+                exit(EXIT_FAILURE);
+            }
+            borrowed_state = state | cecs_resource_status_writing | cecs_resource_status_dirty;
+            break;
+        default: {
+            assert(false && "unreachable: invalid resource access mode");
+            exit(EXIT_FAILURE);
+        }
+        }
+    } while (!atomic_compare_exchange_weak_explicit(
+        &borrow->status_and_reader_count, &state, borrowed_state, memory_order_acquire, memory_order_relaxed
+    ));
+    return cecs_world_resources_get_resource(wr, id);
+}
+
+void cecs_world_resources_release_resource(cecs_world_resources *wr, cecs_resource_id id, cecs_resource_access_mode access) {
+    assert(cecs_world_resources_has_resource(wr, id) && "error: resource does not exist and cannot be released");
+    cecs_resource_borrow *borrow = CECS_PAGED_SENTINEL_SET_GET_INBOUNDS_MUT(cecs_resource_borrow, &wr->resource_borrows, (size_t)id);
+    switch (access) {
+    case cecs_resource_access_inmmutable: {
+        uint32_t state = atomic_load_explicit(&borrow->status_and_reader_count, memory_order_relaxed);
+        uint32_t released_state;
+        do {
+            assert(state >= CECS_RESOURCE_BORROW_READER && "error: resource is not being read from");
+            released_state = state - CECS_RESOURCE_BORROW_READER;
+            if (released_state < CECS_RESOURCE_BORROW_READER) {
+                released_state &= ~(uint32_t)cecs_resource_status_reading;
+            }
+        } while (!atomic_compare_exchange_weak_explicit(
+            &borrow->status_and_reader_count, &state, released_state, memory_order_release, memory_order_relaxed
+        ));
+        break;
+    }
+    case cecs_resource_access_mutable: {
+        const uint32_t state = atomic_fetch_and_explicit(
+            &borrow->status_and_reader_count, ~(uint32_t)cecs_resource_status_writing, memory_order_release
+        );
+        assert((state & cecs_resource_status_writing) && "error: resource is not being written to");
+        (void)state;
+        break;
+    }
+    default: {
+        assert(false && "unreachable: invalid resource access mode");
+        exit(EXIT_FAILURE);
+    }
+    }
+}
+
+void cecs_world_resources_clear_resource_dirty(cecs_world_resources *wr, cecs_resource_id id) {
+    if (cecs_world_resources_has_resource(wr, id)) {
+        atomic_fetch_and_explicit(
+            &CECS_PAGED_SENTINEL_SET_GET_INBOUNDS_MUT(cecs_resource_borrow, &wr->resource_borrows, (size_t)id)->status_and_reader_count,
+            ~(uint32_t)cecs_resource_status_dirty,
+            memory_order_relaxed
+        );
+    }
+}
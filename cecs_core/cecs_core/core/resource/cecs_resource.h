@@ -2,6 +2,7 @@
 #define CECS_RESOURCE_H
 
 #include <stdint.h>
+#include <stdatomic.h>
 #include "../../containers/cecs_arena.h"
 #include "../../containers/cecs_displaced_set.h"
 #include "../../containers/cecs_discard.h"
@@ -25,9 +26,33 @@ extern cecs_resource_id *cecs_resource_id_counter(void);
 typedef void *cecs_resource_handle;
 typedef cecs_discard cecs_resource_discard;
 
+typedef enum cecs_resource_access {
+    cecs_resource_access_inmmutable,
+    cecs_resource_access_mutable,
+} cecs_resource_access;
+typedef uint8_t cecs_resource_access_mode;
+
+typedef enum cecs_resource_status {
+    cecs_resource_status_none = 0,
+    cecs_resource_status_dirty = 1 << 0,
+    cecs_resource_status_reading = 1 << 1,
+    cecs_resource_status_writing = 1 << 2,
+} cecs_resource_status;
+typedef uint8_t cecs_resource_status_flags;
+
+// NOTE: resources may be read by several borrowers at once, from any thread, the reading status stays until the last of them releases it;
+// the status flags sit in the low byte and the reader count above them, so borrows and releases update both with one atomic exchange
+typedef struct cecs_resource_borrow {
+    _Atomic uint32_t status_and_reader_count;
+} cecs_resource_borrow;
+#define CECS_RESOURCE_BORROW_STATUS_MASK ((uint32_t)0xFF)
+#define CECS_RESOURCE_BORROW_READER ((uint32_t)1 << 8)
+
 typedef struct cecs_world_resources {
     cecs_arena resources_arena;
-    cecs_sentinel_set resource_handles;
+    cecs_paged_sentinel_set resource_handles;
+    cecs_paged_sentinel_set resource_sizes;
+    cecs_paged_sentinel_set resource_borrows;
     cecs_resource_discard discard;
 } cecs_world_resources;
 
@@ -41,8 +66,18 @@ cecs_resource_handle cecs_world_resources_set_resource(cecs_world_resources *wr,
 
 cecs_resource_handle cecs_world_resources_get_resource(const cecs_world_resources *wr, cecs_resource_id id);
 
+size_t cecs_world_resources_get_resource_size(const cecs_world_resources *wr, cecs_resource_id id);
+
+size_t cecs_world_resources_count(const cecs_world_resources *wr);
+cecs_memory_usage cecs_world_resources_memory_usage(const cecs_world_resources *wr);
+
 bool cecs_world_resources_remove_resource(cecs_world_resources *wr, cecs_resource_id id);
 
 bool cecs_world_resources_remove_resource_out(cecs_world_resources *wr, cecs_resource_id id, cecs_resource_handle out_resource, size_t size);
 
+cecs_resource_status_flags cecs_world_resources_get_resource_status(const cecs_world_resources *wr, cecs_resource_id id);
+cecs_resource_handle cecs_world_resources_borrow_resource(cecs_world_resources *wr, cecs_resource_id id, cecs_resource_access_mode access);
+void cecs_world_resources_release_resource(cecs_world_resources *wr, cecs_resource_id id, cecs_resource_access_mode access);
+void cecs_world_resources_clear_resource_dirty(cecs_world_resources *wr, cecs_resource_id id);
+
 #endif
\ No newline at end of file
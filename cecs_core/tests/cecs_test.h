@@ -0,0 +1,39 @@
+#ifndef CECS_TEST_H
+#define CECS_TEST_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+// NOTE: cases stop at their first failed expectation, groups run every case and count the failed ones
+#define CECS_TEST_EXPECT(condition) \
+    do { \
+        if (!(condition)) { \
+            fprintf(stderr, "%s:%d: expectation failed: %s\n", __FILE__, __LINE__, #condition); \
+            return false; \
+        } \
+    } while (0)
+
+typedef bool cecs_test_case(void);
+
+typedef struct cecs_test {
+    const char *name;
+    cecs_test_case *run;
+} cecs_test;
+#define CECS_TEST(case_function) ((cecs_test){ .name = #case_function, .run = case_function })
+
+size_t cecs_test_run_cases(const char *group_name, const cecs_test cases[], const size_t case_count);
+#define CECS_TEST_RUN_CASES(group_name, ...) \
+    cecs_test_run_cases( \
+        group_name, \
+        (cecs_test[]){ __VA_ARGS__ }, \
+        (sizeof((cecs_test[]){ __VA_ARGS__ }) / sizeof(cecs_test)) \
+    )
+
+size_t cecs_test_relations(void);
+size_t cecs_test_compaction(void);
+size_t cecs_test_flatmap(void);
+size_t cecs_test_snapshot(void);
+size_t cecs_test_delta(void);
+
+#endif
@@ -0,0 +1,76 @@
+#include <stdint.h>
+
+#include <cecs_core/cecs_core.h>
+
+#include "cecs_test.h"
+
+typedef struct cecs_test_health {
+    int value;
+} cecs_test_health;
+CECS_COMPONENT_DECLARE(cecs_test_health);
+CECS_COMPONENT_DEFINE(cecs_test_health);
+
+#define CECS_TEST_COMPACTION_MAX_ENTITY_COUNT 5000
+
+static bool cecs_test_compaction_keeps_components(size_t entity_count, size_t removed_prefix_count) {
+    cecs_world w = cecs_world_create(64, 16, 4);
+    cecs_entity_id entities[CECS_TEST_COMPACTION_MAX_ENTITY_COUNT];
+    for (size_t i = 0; i < entity_count; ++i) {
+        entities[i] = cecs_world_add_entity(&w);
+        CECS_WORLD_SET_COMPONENT(cecs_test_health, &w, entities[i], (&(cecs_test_health){ (int)i }));
+    }
+    for (size_t i = 0; i < entity_count; ++i) {
+        if (i < removed_prefix_count || i % 5 == 2) {
+            cecs_world_remove_entity(&w, entities[i]);
+        }
+    }
+
+    cecs_world_compact_components(&w, 0, SIZE_MAX);
+    for (size_t i = 0; i < entity_count; ++i) {
+        cecs_test_health *health;
+        const bool has_health = CECS_WORLD_TRY_GET_COMPONENT(cecs_test_health, &w, entities[i], &health);
+        if (i < removed_prefix_count || i % 5 == 2) {
+            CECS_TEST_EXPECT(!has_health);
+        } else {
+            CECS_TEST_EXPECT(has_health);
+            CECS_TEST_EXPECT(health->value == (int)i);
+        }
+    }
+
+    cecs_world_free(&w);
+    return true;
+}
+
+static bool cecs_test_compaction_keeps_last_word(void) {
+    return cecs_test_compaction_keeps_components(65, 10);
+}
+
+static bool cecs_test_compaction_keeps_last_page(void) {
+    return cecs_test_compaction_keeps_components(CECS_TEST_COMPACTION_MAX_ENTITY_COUNT, 1000);
+}
+
+static bool cecs_test_compaction_keeps_sparse_tail(void) {
+    cecs_world w = cecs_world_create(64, 16, 4);
+    cecs_entity_id_range range = cecs_world_add_entity_range(&w, 4100);
+    const cecs_entity_id kept[] = { range.start + 3, range.start + 64, range.start + 4095, range.start + 4099 };
+    for (size_t i = 0; i < sizeof(kept) / sizeof(cecs_entity_id); ++i) {
+        CECS_WORLD_SET_COMPONENT(cecs_test_health, &w, kept[i], (&(cecs_test_health){ (int)i }));
+    }
+
+    cecs_world_compact_components(&w, 0, SIZE_MAX);
+    for (size_t i = 0; i < sizeof(kept) / sizeof(cecs_entity_id); ++i) {
+        CECS_TEST_EXPECT(CECS_WORLD_GET_COMPONENT(cecs_test_health, &w, kept[i])->value == (int)i);
+    }
+
+    cecs_world_free(&w);
+    return true;
+}
+
+size_t cecs_test_compaction(void) {
+    return CECS_TEST_RUN_CASES(
+        "compaction",
+        CECS_TEST(cecs_test_compaction_keeps_last_word),
+        CECS_TEST(cecs_test_compaction_keeps_last_page),
+        CECS_TEST(cecs_test_compaction_keeps_sparse_tail)
+    );
+}
@@ -0,0 +1,143 @@
+#include <cecs_core/cecs_core.h>
+
+#include "cecs_test.h"
+
+typedef struct cecs_test_velocity {
+    int x, y;
+} cecs_test_velocity;
+CECS_COMPONENT_DECLARE(cecs_test_velocity);
+CECS_COMPONENT_DEFINE(cecs_test_velocity);
+
+typedef bool cecs_test_active;
+CECS_TAG_DECLARE(cecs_test_active);
+CECS_TAG_DEFINE(cecs_test_active);
+
+#define CECS_TEST_DELTA_ENTITY_COUNT 200
+
+static bool cecs_test_delta_worlds_match(cecs_world *server, cecs_world *client, cecs_snapshot_delta_decoder *d) {
+    size_t alive_count = 0;
+    const size_t index_count = CECS_DYNAMIC_ARRAY_COUNT(cecs_entity_generation, &server->entities.generations);
+    for (cecs_entity_id index = 0; index < index_count; ++index) {
+        if (!cecs_world_entities_has_entity_index(&server->entities, index)) {
+            continue;
+        }
+        ++alive_count;
+
+        const cecs_entity_id server_id = cecs_world_entities_get_id(&server->entities, index);
+        cecs_entity_id client_id;
+        CECS_TEST_EXPECT(cecs_snapshot_delta_decoder_get_local(d, server_id, &client_id));
+        CECS_TEST_EXPECT(cecs_world_enities_has_entity(&client->entities, client_id));
+
+        cecs_test_velocity *server_velocity;
+        cecs_test_velocity *client_velocity;
+        const bool server_has = CECS_WORLD_TRY_GET_COMPONENT(cecs_test_velocity, server, server_id, &server_velocity);
+        const bool client_has = CECS_WORLD_TRY_GET_COMPONENT(cecs_test_velocity, client, client_id, &client_velocity);
+        CECS_TEST_EXPECT(server_has == client_has);
+        CECS_TEST_EXPECT(!server_has || (server_velocity->x == client_velocity->x && server_velocity->y == client_velocity->y));
+        CECS_TEST_EXPECT(
+            cecs_world_has_tag(server, server_id, CECS_TAG_ID(cecs_test_active))
+            == cecs_world_has_tag(client, client_id, CECS_TAG_ID(cecs_test_active))
+        );
+    }
+    CECS_TEST_EXPECT(alive_count == cecs_world_entity_count(client));
+    return true;
+}
+
+static bool cecs_test_delta_send(
+    cecs_world *server,
+    cecs_world *client,
+    cecs_snapshot_delta_decoder *d,
+    cecs_change_tick since_tick,
+    size_t *out_size
+) {
+    cecs_arena a = cecs_arena_create();
+    cecs_dynamic_array stream = cecs_dynamic_array_create();
+    *out_size = cecs_world_encode_delta(server, since_tick, &stream, &a);
+    CECS_TEST_EXPECT(*out_size > 0);
+    CECS_TEST_EXPECT(cecs_world_apply_delta(client, d, stream.values, *out_size) == cecs_snapshot_status_ok);
+    cecs_arena_free(&a);
+    return cecs_test_delta_worlds_match(server, client, d);
+}
+
+static bool cecs_test_delta_encode_decode(void) {
+    cecs_world server = cecs_world_create(64, 16, 4);
+    cecs_world client = cecs_world_create(64, 16, 4);
+    CECS_WORLD_TRACK_CHANGES(cecs_test_velocity, &server);
+    CECS_WORLD_TRACK_TAG_CHANGES(cecs_test_active, &server);
+
+    cecs_entity_id entities[CECS_TEST_DELTA_ENTITY_COUNT];
+    for (size_t i = 0; i < CECS_TEST_DELTA_ENTITY_COUNT; ++i) {
+        entities[i] = cecs_world_add_entity(&server);
+        CECS_WORLD_SET_COMPONENT(cecs_test_velocity, &server, entities[i], (&(cecs_test_velocity){ (int)i, -(int)i }));
+        if (i % 2 == 0) {
+            CECS_WORLD_ADD_TAG(cecs_test_active, &server, entities[i]);
+        }
+    }
+
+    cecs_snapshot_delta_decoder d = cecs_snapshot_delta_decoder_create();
+    size_t full_size;
+    CECS_TEST_EXPECT(cecs_test_delta_send(&server, &client, &d, CECS_CHANGE_TICK_NONE, &full_size));
+    const cecs_change_tick full_tick = cecs_world_change_tick(&server);
+    cecs_world_advance_change_tick(&server);
+
+    for (size_t i = 0; i < CECS_TEST_DELTA_ENTITY_COUNT; i += 50) {
+        CECS_WORLD_GET_COMPONENT(cecs_test_velocity, &server, entities[i])->x += 1000;
+    }
+    size_t mutation_size;
+    CECS_TEST_EXPECT(cecs_test_delta_send(&server, &client, &d, full_tick, &mutation_size));
+    CECS_TEST_EXPECT(mutation_size < full_size);
+    const cecs_change_tick mutation_tick = cecs_world_change_tick(&server);
+    cecs_world_advance_change_tick(&server);
+
+    for (size_t i = 0; i < CECS_TEST_DELTA_ENTITY_COUNT; ++i) {
+        if (i % 7 == 3) {
+            cecs_world_remove_entity(&server, entities[i]);
+        } else if (i % 4 == 0) {
+            CECS_WORLD_REMOVE_TAG(cecs_test_active, &server, entities[i]);
+        } else if (i % 5 == 0) {
+            CECS_WORLD_REMOVE_COMPONENT(cecs_test_velocity, &server, entities[i], &(cecs_test_velocity){ 0 });
+        }
+    }
+    for (size_t i = 0; i < 10; ++i) {
+        const cecs_entity_id added = cecs_world_add_entity(&server);
+        CECS_WORLD_SET_COMPONENT(cecs_test_velocity, &server, added, (&(cecs_test_velocity){ 7, (int)i }));
+    }
+    size_t structural_size;
+    CECS_TEST_EXPECT(cecs_test_delta_send(&server, &client, &d, mutation_tick, &structural_size));
+
+    cecs_snapshot_delta_decoder_free(&d);
+    cecs_world_free(&client);
+    cecs_world_free(&server);
+    return true;
+}
+
+static bool cecs_test_delta_rejects_truncated_stream(void) {
+    cecs_world server = cecs_world_create(64, 16, 4);
+    cecs_world client = cecs_world_create(64, 16, 4);
+    CECS_WORLD_TRACK_CHANGES(cecs_test_velocity, &server);
+    for (size_t i = 0; i < 16; ++i) {
+        CECS_WORLD_SET_COMPONENT(cecs_test_velocity, &server, cecs_world_add_entity(&server), (&(cecs_test_velocity){ (int)i, 0 }));
+    }
+
+    cecs_arena a = cecs_arena_create();
+    cecs_dynamic_array stream = cecs_dynamic_array_create();
+    const size_t size = cecs_world_encode_delta(&server, CECS_CHANGE_TICK_NONE, &stream, &a);
+    cecs_snapshot_delta_decoder d = cecs_snapshot_delta_decoder_create();
+    CECS_TEST_EXPECT(cecs_world_apply_delta(&client, &d, stream.values, size - 1) != cecs_snapshot_status_ok);
+    ((uint8_t *)stream.values)[0] ^= 1;
+    CECS_TEST_EXPECT(cecs_world_apply_delta(&client, &d, stream.values, size) != cecs_snapshot_status_ok);
+
+    cecs_snapshot_delta_decoder_free(&d);
+    cecs_arena_free(&a);
+    cecs_world_free(&client);
+    cecs_world_free(&server);
+    return true;
+}
+
+size_t cecs_test_delta(void) {
+    return CECS_TEST_RUN_CASES(
+        "delta",
+        CECS_TEST(cecs_test_delta_encode_decode),
+        CECS_TEST(cecs_test_delta_rejects_truncated_stream)
+    );
+}
@@ -0,0 +1,87 @@
+#include <cecs_core/containers/cecs_flatmap.h>
+
+#include "cecs_test.h"
+
+#define CECS_TEST_FLATMAP_KEY_COUNT 4096
+
+static uint64_t cecs_test_flatmap_key(size_t i) {
+    return (uint64_t)(i + 1) * 0x9E3779B97F4A7C15ull;
+}
+
+static bool cecs_test_flatmap_check(const cecs_flatmap *m, size_t key_count, size_t removed_stride) {
+    for (size_t i = 0; i < key_count; ++i) {
+        void *value;
+        const bool expected = removed_stride == 0 || i % removed_stride != 0;
+        CECS_TEST_EXPECT(cecs_flatmap_get(m, cecs_test_flatmap_key(i), &value, sizeof(uint64_t)) == expected);
+        CECS_TEST_EXPECT(!expected || *(uint64_t *)value == i);
+    }
+    return true;
+}
+
+static bool cecs_test_flatmap_incremental_migration(void) {
+    cecs_arena a = cecs_arena_create();
+    cecs_flatmap m = cecs_flatmap_create_incremental(4);
+
+    bool observed_migration = false;
+    for (size_t i = 0; i < CECS_TEST_FLATMAP_KEY_COUNT; ++i) {
+        void *out;
+        CECS_TEST_EXPECT(cecs_flatmap_add(&m, &a, cecs_test_flatmap_key(i), &(uint64_t){ i }, sizeof(uint64_t), &out));
+        observed_migration |= cecs_flatmap_is_migrating(&m);
+        if (cecs_flatmap_is_migrating(&m) && i % 64 == 0) {
+            CECS_TEST_EXPECT(cecs_test_flatmap_check(&m, i + 1, 0));
+        }
+    }
+    CECS_TEST_EXPECT(observed_migration);
+    CECS_TEST_EXPECT(cecs_flatmap_occupied_count(&m) == CECS_TEST_FLATMAP_KEY_COUNT);
+    CECS_TEST_EXPECT(cecs_test_flatmap_check(&m, CECS_TEST_FLATMAP_KEY_COUNT, 0));
+
+    size_t removed_count = 0;
+    for (size_t i = 0; i < CECS_TEST_FLATMAP_KEY_COUNT; i += 3) {
+        uint64_t removed;
+        CECS_TEST_EXPECT(cecs_flatmap_remove(&m, &a, cecs_test_flatmap_key(i), &removed, sizeof(uint64_t)));
+        CECS_TEST_EXPECT(removed == i);
+        ++removed_count;
+    }
+    CECS_TEST_EXPECT(cecs_flatmap_occupied_count(&m) == CECS_TEST_FLATMAP_KEY_COUNT - removed_count);
+    CECS_TEST_EXPECT(cecs_test_flatmap_check(&m, CECS_TEST_FLATMAP_KEY_COUNT, 3));
+
+    cecs_flatmap_free(&m);
+    cecs_arena_free(&a);
+    return true;
+}
+
+static bool cecs_test_flatmap_migration_frees_old_table(void) {
+    cecs_arena a = cecs_arena_create();
+    cecs_flatmap m = cecs_flatmap_create_incremental(4);
+
+    size_t migration_count = 0;
+    for (size_t round = 0; round < 4; ++round) {
+        for (size_t i = 0; i < CECS_TEST_FLATMAP_KEY_COUNT; ++i) {
+            void *out;
+            const bool was_migrating = cecs_flatmap_is_migrating(&m);
+            CECS_TEST_EXPECT(cecs_flatmap_add(&m, &a, cecs_test_flatmap_key(i), &(uint64_t){ i }, sizeof(uint64_t), &out));
+            migration_count += !was_migrating && cecs_flatmap_is_migrating(&m);
+        }
+        for (size_t i = 0; i < CECS_TEST_FLATMAP_KEY_COUNT; ++i) {
+            uint64_t removed;
+            CECS_TEST_EXPECT(cecs_flatmap_remove(&m, &a, cecs_test_flatmap_key(i), &removed, sizeof(uint64_t)));
+        }
+        CECS_TEST_EXPECT(!cecs_flatmap_is_migrating(&m));
+        CECS_TEST_EXPECT(cecs_flatmap_occupied_count(&m) == 0);
+    }
+    CECS_TEST_EXPECT(migration_count > 0);
+    CECS_TEST_EXPECT(cecs_flatmap_memory_usage(&m, sizeof(uint64_t)).reserved <= 16 * CECS_TEST_FLATMAP_KEY_COUNT);
+    CECS_TEST_EXPECT(a.first_block == NULL);
+
+    cecs_flatmap_free(&m);
+    cecs_arena_free(&a);
+    return true;
+}
+
+size_t cecs_test_flatmap(void) {
+    return CECS_TEST_RUN_CASES(
+        "flatmap",
+        CECS_TEST(cecs_test_flatmap_incremental_migration),
+        CECS_TEST(cecs_test_flatmap_migration_frees_old_table)
+    );
+}
@@ -0,0 +1,50 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "cecs_test.h"
+
+typedef size_t cecs_test_group(void);
+
+typedef struct cecs_test_group_entry {
+    const char *name;
+    cecs_test_group *run;
+} cecs_test_group_entry;
+
+static const cecs_test_group_entry cecs_test_groups[] = {
+    { "relations", cecs_test_relations },
+    { "compaction", cecs_test_compaction },
+    { "flatmap", cecs_test_flatmap },
+    { "snapshot", cecs_test_snapshot },
+    { "delta", cecs_test_delta },
+};
+
+size_t cecs_test_run_cases(const char *group_name, const cecs_test cases[], const size_t case_count) {
+    size_t failed_count = 0;
+    for (size_t i = 0; i < case_count; ++i) {
+        const bool passed = cases[i].run();
+        printf("%s %s.%s\n", passed ? "ok  " : "FAIL", group_name, cases[i].name);
+        if (!passed) {
+            ++failed_count;
+        }
+    }
+    return failed_count;
+}
+
+// NOTE: runs the group named by the first argument, CTest registers one test per group, or every group without arguments
+int main(int argc, char **argv) {
+    const size_t group_count = sizeof(cecs_test_groups) / sizeof(cecs_test_group_entry);
+    size_t failed_count = 0;
+    bool found = argc < 2;
+    for (size_t i = 0; i < group_count; ++i) {
+        if (argc < 2 || strcmp(argv[1], cecs_test_groups[i].name) == 0) {
+            failed_count += cecs_test_groups[i].run();
+            found = true;
+        }
+    }
+
+    if (!found) {
+        fprintf(stderr, "error: unknown test group %s\n", argv[1]);
+        return EXIT_FAILURE;
+    }
+    return failed_count == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,106 @@
+#include <cecs_core/cecs_core.h>
+
+#include "cecs_test.h"
+
+typedef struct cecs_test_weight {
+    int value;
+} cecs_test_weight;
+CECS_COMPONENT_DECLARE(cecs_test_weight);
+CECS_COMPONENT_DEFINE(cecs_test_weight);
+
+typedef bool cecs_test_likes;
+CECS_TAG_DECLARE(cecs_test_likes);
+CECS_TAG_DEFINE(cecs_test_likes);
+
+static bool cecs_test_relations_relate_and_unrelate(void) {
+    cecs_world w = cecs_world_create(64, 16, 4);
+    cecs_entity_id target = cecs_world_add_entity(&w);
+    cecs_entity_id sources[16];
+    for (size_t i = 0; i < 16; ++i) {
+        sources[i] = cecs_world_add_entity(&w);
+        CECS_WORLD_ADD_TAG_RELATION(cecs_test_likes, &w, sources[i], target);
+        CECS_WORLD_SET_COMPONENT_RELATION(cecs_test_weight, &w, sources[i], (&(cecs_test_weight){ (int)i }), target);
+    }
+
+    for (size_t i = 0; i < 16; ++i) {
+        CECS_TEST_EXPECT(cecs_world_has_tag(&w, sources[i], CECS_RELATION_ID(cecs_test_likes, cecs_entity_id_index(target))));
+        CECS_TEST_EXPECT(cecs_world_has_tag(&w, sources[i], CECS_RELATION_ID_ANY_TARGET(cecs_test_likes)));
+        CECS_TEST_EXPECT(CECS_WORLD_GET_COMPONENT_RELATION(cecs_test_weight, &w, sources[i], target)->value == (int)i);
+    }
+    CECS_TEST_EXPECT(cecs_world_get_relation_source_count(&w, target) == 16);
+
+    for (size_t i = 0; i < 16; i += 2) {
+        CECS_TEST_EXPECT(CECS_WORLD_REMOVE_TAG_RELATION(cecs_test_likes, &w, sources[i], target));
+        cecs_test_weight removed;
+        CECS_TEST_EXPECT(CECS_WORLD_REMOVE_COMPONENT_RELATION(cecs_test_weight, &w, sources[i], &removed, target));
+        CECS_TEST_EXPECT(removed.value == (int)i);
+    }
+    for (size_t i = 0; i < 16; ++i) {
+        CECS_TEST_EXPECT(
+            cecs_world_has_tag(&w, sources[i], CECS_RELATION_ID(cecs_test_likes, cecs_entity_id_index(target))) == (i % 2 == 1)
+        );
+    }
+    CECS_TEST_EXPECT(cecs_world_get_relation_source_count(&w, target) == 8);
+
+    cecs_world_free(&w);
+    return true;
+}
+
+static bool cecs_test_relations_removed_target_cleans_sources(void) {
+    cecs_world w = cecs_world_create(64, 16, 4);
+    cecs_entity_id target = cecs_world_add_entity(&w);
+    cecs_entity_id other = cecs_world_add_entity(&w);
+    cecs_entity_id sources[8];
+    for (size_t i = 0; i < 8; ++i) {
+        sources[i] = cecs_world_add_entity(&w);
+        CECS_WORLD_ADD_TAG_RELATION(cecs_test_likes, &w, sources[i], target);
+        CECS_WORLD_ADD_TAG_RELATION(cecs_test_likes, &w, sources[i], other);
+    }
+
+    cecs_world_remove_entity(&w, target);
+    for (size_t i = 0; i < 8; ++i) {
+        CECS_TEST_EXPECT(cecs_world_enities_has_entity(&w.entities, sources[i]));
+        CECS_TEST_EXPECT(!cecs_world_has_tag(&w, sources[i], CECS_RELATION_ID(cecs_test_likes, cecs_entity_id_index(target))));
+        CECS_TEST_EXPECT(cecs_world_has_tag(&w, sources[i], CECS_RELATION_ID(cecs_test_likes, cecs_entity_id_index(other))));
+    }
+    CECS_TEST_EXPECT(cecs_world_get_relation_source_count(&w, other) == 8);
+
+    cecs_world_free(&w);
+    return true;
+}
+
+static bool cecs_test_relations_relate_to_reused_target(void) {
+    cecs_world w = cecs_world_create(64, 16, 4);
+    cecs_entity_id source = cecs_world_add_entity(&w);
+    cecs_entity_id target = cecs_world_add_entity(&w);
+
+    for (int round = 0; round < 4; ++round) {
+        CECS_WORLD_SET_COMPONENT_RELATION(cecs_test_weight, &w, source, (&(cecs_test_weight){ round }), target);
+        CECS_WORLD_ADD_TAG_RELATION(cecs_test_likes, &w, source, target);
+        CECS_TEST_EXPECT(CECS_WORLD_GET_COMPONENT_RELATION(cecs_test_weight, &w, source, target)->value == round);
+
+        const cecs_entity_id removed_target = target;
+        cecs_world_remove_entity(&w, removed_target);
+        CECS_TEST_EXPECT(!cecs_world_has_tag(&w, source, CECS_RELATION_ID_ANY_TARGET(cecs_test_likes)));
+
+        target = cecs_world_add_entity(&w);
+        CECS_TEST_EXPECT(cecs_entity_id_index(target) == cecs_entity_id_index(removed_target));
+        CECS_TEST_EXPECT(!cecs_world_has_tag(&w, source, CECS_RELATION_ID(cecs_test_likes, cecs_entity_id_index(target))));
+    }
+
+    CECS_WORLD_SET_COMPONENT_RELATION(cecs_test_weight, &w, source, (&(cecs_test_weight){ -1 }), target);
+    CECS_TEST_EXPECT(CECS_WORLD_GET_COMPONENT_RELATION(cecs_test_weight, &w, source, target)->value == -1);
+    CECS_TEST_EXPECT(cecs_world_get_relation_source_count(&w, target) == 1);
+
+    cecs_world_free(&w);
+    return true;
+}
+
+size_t cecs_test_relations(void) {
+    return CECS_TEST_RUN_CASES(
+        "relations",
+        CECS_TEST(cecs_test_relations_relate_and_unrelate),
+        CECS_TEST(cecs_test_relations_removed_target_cleans_sources),
+        CECS_TEST(cecs_test_relations_relate_to_reused_target)
+    );
+}
@@ -0,0 +1,77 @@
+#include <stdio.h>
+
+#include <cecs_core/cecs_core.h>
+
+#include "cecs_test.h"
+
+typedef struct cecs_test_position {
+    float x, y;
+} cecs_test_position;
+CECS_COMPONENT_DECLARE(cecs_test_position);
+CECS_COMPONENT_DEFINE(cecs_test_position);
+
+typedef bool cecs_test_marked;
+CECS_TAG_DECLARE(cecs_test_marked);
+CECS_TAG_DEFINE(cecs_test_marked);
+
+#define CECS_TEST_SNAPSHOT_PATH "cecs_test_snapshot.snap"
+#define CECS_TEST_SNAPSHOT_ENTITY_COUNT 300
+
+static bool cecs_test_snapshot_check_world(cecs_world *w, const cecs_entity_id entities[]) {
+    for (size_t i = 0; i < CECS_TEST_SNAPSHOT_ENTITY_COUNT; ++i) {
+        if (i % 7 == 3) {
+            CECS_TEST_EXPECT(!cecs_world_enities_has_entity(&w->entities, entities[i]));
+            continue;
+        }
+        cecs_test_position *position;
+        CECS_TEST_EXPECT(CECS_WORLD_TRY_GET_COMPONENT(cecs_test_position, w, entities[i], &position));
+        CECS_TEST_EXPECT(position->x == (float)i && position->y == -(float)i);
+        CECS_TEST_EXPECT(cecs_world_has_tag(w, entities[i], CECS_TAG_ID(cecs_test_marked)) == (i % 2 == 1));
+    }
+    return true;
+}
+
+static bool cecs_test_snapshot_round_trip(void) {
+    cecs_snapshot_type types[] = { CECS_SNAPSHOT_TYPE(cecs_test_position), CECS_SNAPSHOT_TAG_TYPE(cecs_test_marked) };
+    const size_t type_count = sizeof(types) / sizeof(cecs_snapshot_type);
+
+    cecs_world w = cecs_world_create(64, 16, 4);
+    cecs_entity_id entities[CECS_TEST_SNAPSHOT_ENTITY_COUNT];
+    for (size_t i = 0; i < CECS_TEST_SNAPSHOT_ENTITY_COUNT; ++i) {
+        entities[i] = cecs_world_add_entity(&w);
+        CECS_WORLD_SET_COMPONENT(cecs_test_position, &w, entities[i], (&(cecs_test_position){ (float)i, -(float)i }));
+        if (i % 2 == 1) {
+            CECS_WORLD_ADD_TAG(cecs_test_marked, &w, entities[i]);
+        }
+    }
+    for (size_t i = 3; i < CECS_TEST_SNAPSHOT_ENTITY_COUNT; i += 7) {
+        cecs_world_remove_entity(&w, entities[i]);
+    }
+    CECS_TEST_EXPECT(cecs_world_save_snapshot(&w, CECS_TEST_SNAPSHOT_PATH, types, type_count) == cecs_snapshot_status_ok);
+
+    cecs_snapshot s;
+    CECS_TEST_EXPECT(cecs_snapshot_open(CECS_TEST_SNAPSHOT_PATH, &s) == cecs_snapshot_status_ok);
+    cecs_world loaded = cecs_world_create(64, 16, 4);
+    CECS_TEST_EXPECT(cecs_world_load_snapshot(&loaded, &s, types, type_count) == cecs_snapshot_status_ok);
+    CECS_TEST_EXPECT(cecs_world_entity_count(&loaded) == cecs_world_entity_count(&w));
+    CECS_TEST_EXPECT(cecs_test_snapshot_check_world(&loaded, entities));
+    CECS_TEST_EXPECT(cecs_world_add_entity(&loaded) == cecs_world_add_entity(&w));
+
+    cecs_snapshot_type mismatched[] = { { "cecs_test_position", CECS_COMPONENT_ID(cecs_test_position), sizeof(cecs_test_position) + 4 } };
+    cecs_world rejected = cecs_world_create(64, 16, 4);
+    CECS_TEST_EXPECT(cecs_world_load_snapshot(&rejected, &s, mismatched, 1) != cecs_snapshot_status_ok);
+
+    cecs_snapshot_close(&s);
+    remove(CECS_TEST_SNAPSHOT_PATH);
+    cecs_world_free(&rejected);
+    cecs_world_free(&loaded);
+    cecs_world_free(&w);
+    return true;
+}
+
+size_t cecs_test_snapshot(void) {
+    return CECS_TEST_RUN_CASES(
+        "snapshot",
+        CECS_TEST(cecs_test_snapshot_round_trip)
+    );
+}
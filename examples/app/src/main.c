@@ -418,7 +418,7 @@ void update_controllables(
 static size_t write_set_bits(const cecs_world *w, const cecs_entity_id entity, const cecs_component_id component, char buffer[static 16 * 2]) {
     cecs_hibitset *set =
         &cecs_world_components_get_component_storage_expect(&w->components, component)->storage.entity_bitset;
-    cecs_hibitset_iterator it = cecs_hibitset_iterator_create_borrowed_at(set, entity);
+    cecs_hibitset_iterator it = cecs_hibitset_iterator_create_borrowed_at(set, cecs_entity_id_index(entity));
     size_t count = 0;
     for (size_t i = 0; i < 16; i++) {
         if (cecs_hibitset_iterator_current_is_set(&it)) {